@@ -31,7 +31,7 @@ contains(QT_VERSION, "^4.*") {
     DEFINES += QT5
     # Force USE_GLWIDGET for both Qt4 and Qt5 to ensure consistent OpenGL widget usage
     DEFINES += USE_GLWIDGET
-    QT      += widgets core gui opengl network script xml
+    QT      += widgets core gui opengl network script xml concurrent
 }
 
 # Add include path for Qt
@@ -108,16 +108,16 @@ SOURCES  += iannix.cpp iannixapp.cpp iannix_spec.cpp
 HEADERS  += misc/help.h   misc/application.h   misc/options.h   misc/applicationexecute.h   misc/uitheme.h
 SOURCES  += misc/help.cpp misc/application.cpp misc/options.cpp misc/applicationexecute.cpp misc/uitheme.cpp
 
-HEADERS  += messages/messagemanagerlogmini.h   messages/messagemanagerlog.h   messages/messagemanager.h   messages/message.h   messages/messagemanagerloginterface.h
-SOURCES  += messages/messagemanagerlogmini.cpp messages/messagemanagerlog.cpp messages/messagemanager.cpp messages/message.cpp
+HEADERS  += messages/messagemanagerlogmini.h   messages/messagemanagerlog.h   messages/messagemanager.h   messages/message.h   messages/messageargument.h   messages/messagemanagerloginterface.h   messages/messagemanagerlogbuffer.h   messages/messagejournal.h
+SOURCES  += messages/messagemanagerlogmini.cpp messages/messagemanagerlog.cpp messages/messagemanager.cpp messages/message.cpp messages/messageargument.cpp messages/messagemanagerlogbuffer.cpp messages/messagejournal.cpp
 FORMS    += messages/messagemanagerlogmini.ui  messages/messagemanagerlog.ui
 
-HEADERS  += transport/transport.h   transport/uitimer.h   transport/uiabout.h   transport/uieditor.h
-SOURCES  += transport/transport.cpp transport/uitimer.cpp transport/uiabout.cpp transport/uieditor.cpp
+HEADERS  += transport/transport.h   transport/uitimer.h   transport/uiabout.h   transport/uieditor.h   transport/schedulerthread.h
+SOURCES  += transport/transport.cpp transport/uitimer.cpp transport/uiabout.cpp transport/uieditor.cpp transport/schedulerthread.cpp
 FORMS    += transport/transport.ui  transport/uitimer.ui  transport/uiabout.ui  transport/uieditor.ui
 
-HEADERS  += render/uirender.h   render/uirenderpreview.h
-SOURCES  += render/uirender.cpp render/uirenderpreview.cpp
+HEADERS  += render/uirender.h   render/uirenderpreview.h   render/uirendercapture.h   render/uirenderfrustum.h
+SOURCES  += render/uirender.cpp render/uirenderpreview.cpp render/uirendercapture.cpp render/uirenderfrustum.cpp
 FORMS    += render/uirender.ui
 
 HEADERS  += geometry/nxpoint.h   geometry/nxrect.h   geometry/nxsize.h   geometry/nxline.h   geometry/nxpolygon.h   geometry/nxeasing.h
@@ -125,8 +125,8 @@ SOURCES  += geometry/nxpoint.cpp geometry/nxrect.cpp geometry/nxsize.cpp geometr
 HEADERS  += geometry/qmuparser/muParser.h   geometry/qmuparser/muParserBase.h   geometry/qmuparser/muParserBytecode.h   geometry/qmuparser/muParserCallback.h   geometry/qmuparser/muParserError.h   geometry/qmuparser/muParserTokenReader.h   geometry/qmuparser/muParserDef.h   geometry/qmuparser/muParserFixes.h   geometry/qmuparser/muParserStack.h   geometry/qmuparser/muParserToken.h
 SOURCES  += geometry/qmuparser/muParser.cpp geometry/qmuparser/muParserBase.cpp geometry/qmuparser/muParserBytecode.cpp geometry/qmuparser/muParserCallback.cpp geometry/qmuparser/muParserError.cpp geometry/qmuparser/muParserTokenReader.cpp
 
-HEADERS  += objects/nxdocument.h   objects/nxtrigger.h   objects/nxgroup.h   objects/nxcurve.h   objects/nxcursor.h   objects/nxobject.h
-SOURCES  += objects/nxdocument.cpp objects/nxtrigger.cpp objects/nxgroup.cpp objects/nxcurve.cpp objects/nxcursor.cpp objects/nxobject.cpp
+HEADERS  += objects/nxdocument.h   objects/nxtrigger.h   objects/nxgroup.h   objects/nxcurve.h   objects/nxcursor.h   objects/nxobject.h   objects/nxtriggerindex.h   objects/nxpickindex.h   objects/nxtriggerbatch.h   objects/nxundojournal.h   objects/nxscorebinary.h
+SOURCES  += objects/nxdocument.cpp objects/nxtrigger.cpp objects/nxgroup.cpp objects/nxcurve.cpp objects/nxcursor.cpp objects/nxobject.cpp objects/nxtriggerindex.cpp objects/nxpickindex.cpp objects/nxtriggerbatch.cpp objects/nxundojournal.cpp objects/nxscorebinary.cpp
 
 HEADERS  += gui/uiinspector.h   gui/uiview.h   gui/uihelp.h   gui/uimessagebox.h   gui/uisplashscreen.h
 SOURCES  += gui/uiinspector.cpp gui/uiview.cpp gui/uihelp.cpp gui/uimessagebox.cpp gui/uisplashscreen.cpp
@@ -146,9 +146,9 @@ SOURCES  += abstractionsgl.cpp
 
 
 #Native interfaces
-HEADERS  += interfaces/interfacehttp.h   interfaces/interfacemidi.h   interfaces/interfaceosc.h   interfaces/interfaceserial.h   interfaces/interfacetcp.h   interfaces/interfaceudp.h   interfaces/interfacedirect.h   interfaces/interfacesyphon.h
-SOURCES  += interfaces/interfacehttp.cpp interfaces/interfacemidi.cpp interfaces/interfaceosc.cpp interfaces/interfaceserial.cpp interfaces/interfacetcp.cpp interfaces/interfaceudp.cpp interfaces/interfacedirect.cpp
-FORMS    += interfaces/interfacehttp.ui  interfaces/interfacemidi.ui  interfaces/interfaceosc.ui  interfaces/interfaceserial.ui  interfaces/interfacetcp.ui  interfaces/interfaceudp.ui  interfaces/interfacedirect.ui  interfaces/interfacesyphon.ui
+HEADERS  += interfaces/interfacehttp.h   interfaces/interfacemidi.h   interfaces/extmidiclock.h   interfaces/interfaceosc.h   interfaces/interfaceserial.h   interfaces/interfacetcp.h   interfaces/interfaceudp.h   interfaces/interfacedirect.h   interfaces/interfacesyphon.h   interfaces/interfaceartnet.h
+SOURCES  += interfaces/interfacehttp.cpp interfaces/interfacemidi.cpp interfaces/extmidiclock.cpp interfaces/interfaceosc.cpp interfaces/interfaceserial.cpp interfaces/interfacetcp.cpp interfaces/interfaceudp.cpp interfaces/interfacedirect.cpp interfaces/interfaceartnet.cpp
+FORMS    += interfaces/interfacehttp.ui  interfaces/interfacemidi.ui  interfaces/interfaceosc.ui  interfaces/interfaceserial.ui  interfaces/interfacetcp.ui  interfaces/interfaceudp.ui  interfaces/interfacedirect.ui  interfaces/interfacesyphon.ui  interfaces/interfaceartnet.ui
 
 #Serial
 HEADERS  += interfaces/qextserialport/qextserialport.h   interfaces/qextserialport/qextserialenumerator.h   interfaces/qextserialport/qextserialport_global.h interfaces/qextserialport/qextserialport_p.h interfaces/qextserialport/qextserialenumerator_p.h
@@ -234,6 +234,14 @@ false {
     LIBS              += -framework Cocoa
 }
 
+#Tests and benchmarks (qmake CONFIG+=iannix_tests, then IanniX -test or IanniX -benchmark)
+iannix_tests {
+    DEFINES           += IANNIX_TESTS
+    QT                += testlib
+    HEADERS           += tests/iannixtests.h   tests/testcurves.h   tests/testscorebinary.h   tests/testmessageparser.h   tests/testbenchmarks.h
+    SOURCES           += tests/iannixtests.cpp tests/testcurves.cpp tests/testscorebinary.cpp tests/testmessageparser.cpp tests/testbenchmarks.cpp tests/messagelegacy.cpp
+}
+
 TRANSLATIONS             = Tools/Translation_fr_FR.ts
 
 RESOURCES               += icons/IanniX.qrc
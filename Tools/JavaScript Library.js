@@ -26,6 +26,9 @@
 function run(_command) 	{
 	return iannix.execute(_command);
 }
+function addBatch(_items, _type) {
+	return iannix.addBatch(_items, (_type == undefined)?("trigger"):(_type));
+}
 function ask(_category, _label, _variable, _defaultValue) {
 	return iannix.ask(_category, _label, _variable, _defaultValue);
 }
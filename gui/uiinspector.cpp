@@ -240,7 +240,7 @@ void UiInspector::addInterfaces() {
             ui->ssTabConfigArduinoLayout->addWidget(interfacesIterator.value());
         else if(interfacesIterator.key() == MessagesTypeMidi)
             ui->ssTabConfigMIDILayout->addWidget(interfacesIterator.value());
-        else if((interfacesIterator.key() == MessagesTypeOsc) || (interfacesIterator.key() == MessagesTypeUdp) || (interfacesIterator.key() == MessagesTypeTcp) || (interfacesIterator.key() == MessagesTypeHttp))
+        else if((interfacesIterator.key() == MessagesTypeOsc) || (interfacesIterator.key() == MessagesTypeUdp) || (interfacesIterator.key() == MessagesTypeTcp) || (interfacesIterator.key() == MessagesTypeHttp) || (interfacesIterator.key() == MessagesTypeArtnet))
             ui->ssTabConfigNetworkLayout->addWidget(interfacesIterator.value());
         else if((interfacesIterator.key() == MessagesTypeSyphon) || (interfacesIterator.key() == MessagesTypeDirect))
             ui->ssTabConfigSyphonLayout->addWidget(interfacesIterator.value());
@@ -448,10 +448,10 @@ void UiInspector::actionInfoGroup() {
 }
 void UiInspector::actionMessages() {
     if(render->getSelection()->count()) {
-        Application::current->pushSnapshot();
         ExtOscPatternAsk *ask = new ExtOscPatternAsk(Application::current->getMainWindow(), render->getSelection());
         if(!ask->onlyCurves)
             if(ask->exec()) {
+                Application::current->pushSnapshot();
                 if(ask->getMessagePatterns().length())  Application::current->execute(QString("%1 selection %2").arg(COMMAND_MESSAGE).arg(ask->getMessagePatterns()), ExecuteSourceGui);
                 else                                    Application::current->execute(QString("%1 selection -").arg(COMMAND_MESSAGE), ExecuteSourceGui);
             }
@@ -542,27 +542,38 @@ void UiInspector::refresh() {
         NxObject  *prevObject = 0;
         NxCurve   *prevCurve = 0;
 
-        if(!ui->colorCombo1->hasFocus()) {
+        //Combos are only rebuilt when colors/textures changed (or when a value was appended by change())
+        uint colorsSignature = getColorsSignature(), texturesSignature = getTexturesSignature();
+        if((!ui->colorCombo1->hasFocus()) && (comboNeedsRebuild(ui->colorCombo1, colorsSignature))) {
             ui->colorCombo1->clear();
             colorComboAdd(ui->colorCombo1,          Render::colors->keys());
             colorComboAdd(ui->colorCombo1,          QStringList() << tr("Choose…"));
+            comboRebuilt(ui->colorCombo1, colorsSignature);
         }
-        if(!ui->colorCombo2->hasFocus()) {
+        if((!ui->colorCombo2->hasFocus()) && (comboNeedsRebuild(ui->colorCombo2, colorsSignature))) {
             ui->colorCombo2->clear();
             colorComboAdd(ui->colorCombo2,          Render::colors->keys());
             colorComboAdd(ui->colorCombo2,          QStringList() << tr("Choose…"));
+            comboRebuilt(ui->colorCombo2, colorsSignature);
         }
-        if(!ui->colorComboMultiply->hasFocus()) {
+        if((!ui->colorComboMultiply->hasFocus()) && (comboNeedsRebuild(ui->colorComboMultiply, 0))) {
             ui->colorComboMultiply->clear();
             colorComboAdd(ui->colorComboMultiply,   QStringList() << tr("Choose…"));
+            comboRebuilt(ui->colorComboMultiply, 0);
         }
 
-        ui->textureCombo1->clear();
-        ui->textureCombo2->clear();
-        textureComboAdd(ui->textureCombo1, QStringList() << "");
-        textureComboAdd(ui->textureCombo2, QStringList() << "");
-        textureComboAdd(ui->textureCombo1, Render::textures->keys());
-        textureComboAdd(ui->textureCombo2, Render::textures->keys());
+        if(comboNeedsRebuild(ui->textureCombo1, texturesSignature)) {
+            ui->textureCombo1->clear();
+            textureComboAdd(ui->textureCombo1, QStringList() << "");
+            textureComboAdd(ui->textureCombo1, Render::textures->keys());
+            comboRebuilt(ui->textureCombo1, texturesSignature);
+        }
+        if(comboNeedsRebuild(ui->textureCombo2, texturesSignature)) {
+            ui->textureCombo2->clear();
+            textureComboAdd(ui->textureCombo2, QStringList() << "");
+            textureComboAdd(ui->textureCombo2, Render::textures->keys());
+            comboRebuilt(ui->textureCombo2, texturesSignature);
+        }
 
         for(quint16 indexObject = 0 ; indexObject < objects->count()+1 ; indexObject++) {
             NxObject *object = 0;
@@ -1010,6 +1021,36 @@ void UiInspector::textureComboAdd(QComboBox *spin, QStringList values) {
     }
 }
 
+uint UiInspector::getColorsSignature() const {
+    //Names, values and current color scheme are what the color combos display
+    uint signature = qHash(Application::colorsPrefix());
+    QMapIterator<QString, QColor> colorIterator(*Render::colors);
+    while (colorIterator.hasNext()) {
+        colorIterator.next();
+        signature = signature * 31 + (qHash(colorIterator.key()) ^ colorIterator.value().rgba());
+    }
+    return signature;
+}
+uint UiInspector::getTexturesSignature() const {
+    //Only loaded textures are displayed in the texture combos
+    uint signature = 0;
+    QMapIterator<QString, UiRenderTexture*> textureIterator(*Render::textures);
+    while (textureIterator.hasNext()) {
+        textureIterator.next();
+        signature = signature * 31 + (qHash(textureIterator.key()) ^ ((textureIterator.value()->loaded)?(1):(0)));
+    }
+    return signature;
+}
+bool UiInspector::comboNeedsRebuild(QComboBox *spin, uint signature) const {
+    if(!comboSignatures.contains(spin))
+        return true;
+    const QPair<uint, int> &comboSignature = comboSignatures[spin];
+    return (comboSignature.first != signature) || (comboSignature.second != spin->count());
+}
+void UiInspector::comboRebuilt(QComboBox *spin, uint signature) {
+    comboSignatures.insert(spin, qMakePair(signature, spin->count()));
+}
+
 QTreeWidgetItem* UiInspector::getObjectRootItem() const {
     return ui->ccView->invisibleRootItem();
 }
@@ -96,6 +96,12 @@ public slots:
 
     void colorComboAdd(QComboBox *spin, QStringList values);
     void textureComboAdd(QComboBox *spin, QStringList values);
+private:
+    QHash<QComboBox*, QPair<uint, int> > comboSignatures;
+    uint getColorsSignature() const;
+    uint getTexturesSignature() const;
+    bool comboNeedsRebuild(QComboBox *spin, uint signature) const;
+    void comboRebuilt(QComboBox *spin, uint signature);
 
 
 signals:
@@ -125,6 +125,10 @@ UiView::UiView(QWidget *parent) :
     Application::allowSelectionCurves  .setAction(ui->actionAllow_curves_selection,   "guiAllowSelectionCurves");
     Application::allowSelectionTriggers.setAction(ui->actionAllow_triggers_selection, "guiAllowSelectionTriggers");
     Application::allowPlaySelected     .setAction(ui->actionPlaySelected,             "guiAllowPlaySelected");
+    Application::schedulerThread       .setAction(ui->actionSchedulerThread,          "schedulerThread");
+    Render::batchTriggers              .setAction(ui->actionBatchTriggers,            "guiBatchTriggers");
+    Render::cullObjects                .setAction(ui->actionCullObjects,              "guiCullObjects");
+    Application::saveBinaryScore       .setAction(ui->actionSaveBinaryScore,          "saveBinaryScore");
 
     connect(ui->actionFullscreen,           SIGNAL(triggered()), SLOT(goToFullscreen()));
     connect(ui->actionPerformance,          SIGNAL(triggered()), SLOT(actionPerformance()));
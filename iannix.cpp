@@ -23,10 +23,12 @@
 
 #include "iannix.h"
 
-IanniX::IanniX(const QString &_projectToLoad, QObject *parent) :
+IanniX::IanniX(const QString &_projectToLoad, bool _offline, QObject *parent) :
     ApplicationCurrent(parent) {
     projectToLoad = _projectToLoad;
+    offline = _offline;
     projectIsLoaded = false;
+    registerCommands();
     iconAppPlay  = QIcon(":icons/res_appicon_pause.png");
     iconAppPause = QIcon(":icons/res_appicon_play.png");
     NxObject::widgetIconActiveOff = QIcon(":gui/res_icon_check_active_off.png");
@@ -64,7 +66,7 @@ IanniX::IanniX(const QString &_projectToLoad, QObject *parent) :
     QDir().mkpath(Application::pathDocuments.absoluteFilePath() + "/");
     QDir().mkpath(Application::pathDocuments.absoluteFilePath() + "/Templates/");
 
-    //View
+    //View (also built offline, the mode is not headless : loading, groups and the inspector need it, it is never shown)
     view      = new UiView(0);
     render    = view->getRender();
     Application::setInterfaces(this, render);
@@ -125,10 +127,15 @@ IanniX::IanniX(const QString &_projectToLoad, QObject *parent) :
     MessageManager::addNetworkInterface(MessagesTypeOsc,    interfaceOsc);
     MessageManager::addNetworkInterface(MessagesTypeDirect, new InterfaceDirect());
     MessageManager::addNetworkInterface(MessagesTypeUdp,    new InterfaceUdp   ());
-    MessageManager::addNetworkInterface(MessagesTypeTcp,    new InterfaceTcp   ());
-    MessageManager::addNetworkInterface(MessagesTypeHttp,   new InterfaceHttp  ());
+    interfaceTcp = new InterfaceTcp();
+    MessageManager::addNetworkInterface(MessagesTypeTcp,    interfaceTcp);
+    interfaceHttp = new InterfaceHttp();
+    MessageManager::addNetworkInterface(MessagesTypeHttp,   interfaceHttp);
     MessageManager::addNetworkInterface(MessagesTypeSerial, new InterfaceSerial());
-    MessageManager::addNetworkInterface(MessagesTypeMidi,   new InterfaceMidi  ());
+    interfaceMidi = new InterfaceMidi();
+    MessageManager::addNetworkInterface(MessagesTypeMidi,   interfaceMidi);
+    interfaceArtnet = new InterfaceArtnet();
+    MessageManager::addNetworkInterface(MessagesTypeArtnet, interfaceArtnet);
 #ifdef SYPHON_INSTALLED
     MessageManager::addNetworkInterface(MessagesTypeSyphon, render->interfaceSyphon);
 #endif
@@ -140,6 +147,7 @@ IanniX::IanniX(const QString &_projectToLoad, QObject *parent) :
 
     //Special objects
     MessageManager::setInterfaces(this, &messageScriptEngine, 0, transport->getLogMini());
+    messageJournal = new MessageJournal(this);
     MessageManager::transportObject = new NxTrigger(this, 0);
     MessageManager::syncObject      = new NxTrigger(this, 0);
 
@@ -159,6 +167,8 @@ IanniX::IanniX(const QString &_projectToLoad, QObject *parent) :
     UiOptions::add(&Application::defaultMessageSync,      "defaultMessageSync");
     UiOptions::add(&Application::defaultMessageTransport, "defaultMessageTransport");
     UiOptions::add(&Application::defaultMessageTrigger,   "defaultMessageTrigger");
+    UiOptions::add(&Application::undoJournalSize,         "undoJournalSize");
+    UiOptions::add(&Application::captureUncompressed,     "captureUncompressed");
     NxDocument::restoreDefaults();
 
 
@@ -233,9 +243,23 @@ IanniX::IanniX(const QString &_projectToLoad, QObject *parent) :
     timer = new QTimer(this);
     connect(timer, SIGNAL(timeout()), this, SLOT(timerTick()));
     timer->setInterval(5);
-    timer->start();
+    if(!offline)
+        timer->start();
+    schedulerClock.start();
+    schedulerClockOld = 0;
+    schedulerClockTime = 0;
+    schedulerClockOrigin = QDateTime::currentMSecsSinceEpoch();
+    Transport::currentMSecsSinceEpoch = schedulerClockOrigin;
+    schedulerThread = new SchedulerThread(this);
+    schedulerThread->setInterval(timer->interval());
+    connect(qApp, SIGNAL(aboutToQuit()), schedulerThread, SLOT(stopScheduler()));
+    connect(&Application::schedulerThread, SIGNAL(triggered(bool)), SLOT(setSchedulerThread(bool)));
     forceGoto(0);
 
+    //Offline render : nothing is shown, renderOffline() drives the scheduler
+    if(offline)
+        return;
+
     //Show
     view->show();
 
@@ -243,6 +267,70 @@ IanniX::IanniX(const QString &_projectToLoad, QObject *parent) :
         Application::current->readyToStart();
 }
 
+bool IanniX::renderOffline(const QString &outputFilename, qreal duration, qreal step) {
+    QFile outputFile(outputFilename);
+    if(!outputFile.open(QFile::WriteOnly | QFile::Truncate)) {
+        qDebug("[OFFLINE] Can't write %s", qPrintable(outputFilename));
+        return false;
+    }
+    if(step <= 0)
+        step = timer->interval() / 1000.;
+
+    hasStarted = true;
+    loadProject(projectToLoad);
+    QCoreApplication::processEvents();
+
+    //Steps the scheduler with a fixed virtual delta, as fast as possible
+    QElapsedTimer renderTimer;
+    renderTimer.start();
+    MessageManager::offlineOutput = &outputFile;
+    MessageManager::offlineOutputCounter = 0;
+    forceGoto(0);
+    setScheduler(SchedulerOn);
+    quint32 stepIndex = 0;
+    for(qreal renderTime = 0 ; renderTime < duration ; renderTime += step) {
+        schedulerClockTick(step);
+        timerTick(step);
+        if((++stepIndex % 1000) == 0)
+            QCoreApplication::processEvents();
+    }
+    setScheduler(SchedulerOff);
+    MessageManager::offlineOutput = 0;
+    outputFile.close();
+
+    qDebug("[OFFLINE] %d messages, %.3f s of score rendered in %.3f s to %s", MessageManager::offlineOutputCounter, Transport::timeLocal, renderTimer.elapsed() / 1000., qPrintable(outputFilename));
+    return true;
+}
+
+bool IanniX::replayOffline(const QString &journalFilename, qreal speed) {
+    //Sends a recorded journal again through the interfaces, then quits (throughput is printed at the end)
+    QEventLoop replayLoop;
+    connect(messageJournal, SIGNAL(replayFinished()), &replayLoop, SLOT(quit()));
+    if(!messageJournal->replay(journalFilename, speed))
+        return false;
+    replayLoop.exec();
+    return true;
+}
+void IanniX::benchmarkCommands(const QString &filename, quint16 passes) {
+    //Executes the incoming records of a journal as fast as possible (parse and dispatch only, no script callbacks)
+    QList<MessageIncomming> corpus;
+    if((!MessageJournal::loadIncoming(filename, &corpus)) || (corpus.isEmpty())) {
+        qDebug("[BENCHMARK] No incoming message in %s", qPrintable(filename));
+        return;
+    }
+    passes = qMax((quint16)1, passes);
+    QElapsedTimer benchmarkClock;
+    benchmarkClock.start();
+    for(quint16 pass = 0 ; pass < passes ; pass++)
+        foreach(const MessageIncomming &message, corpus)
+            execute(message);
+    qreal elapsed = benchmarkClock.nsecsElapsed() / 1000000000.;
+    quint32 count = corpus.count() * passes;
+    QString report = QString("%1 commands (%2 x %3) in %4 s : %5 commands/s").arg(count).arg(corpus.count()).arg(passes).arg(elapsed, 0, 'f', 3).arg((elapsed > 0)?(count / elapsed):(0.), 0, 'f', 0);
+    qDebug("[BENCHMARK] %s", qPrintable(report));
+    MessageManager::logInfo(report);
+}
+
 void IanniX::readyToStart() {
     if(!hasStarted) {
         hasStarted = true;
@@ -255,6 +343,7 @@ void IanniX::readyToStart() {
         timerTime = startTimer(50);
         timerPerf = startTimer(500);
         render->startRenderTimer();
+        setSchedulerThread(Application::schedulerThread);
 
         Application::splash->close();
     }
@@ -328,7 +417,7 @@ void IanniX::actionImportText(const QString &font, const QString &text) {
 
 
 void IanniX::setScheduler(SchedulerActivity _schedulerActivity) {
-    MessageManager::messagesCache.clear();
+    MessageManager::clearMessagesCache();
     schedulerActivity = _schedulerActivity;
     if(schedulerActivity != SchedulerOff) {
         Transport::timerOk = true;
@@ -337,14 +426,23 @@ void IanniX::setScheduler(SchedulerActivity _schedulerActivity) {
     }
     else
         Transport::timerOk = false;
+    QMetaObject::invokeMethod(this, "refreshWindowIcon");
+}
+void IanniX::refreshWindowIcon() {
     if(view->isVisible()) {
         if(Transport::timerOk)  QApplication::setWindowIcon(iconAppPause);
         else                    QApplication::setWindowIcon(iconAppPlay);
     }
 }
+void IanniX::setSchedulerThread(bool threaded) {
+    if(!hasStarted)
+        return;
+    if(threaded)    schedulerThread->startScheduler();
+    else            schedulerThread->stopScheduler();
+}
 
-const QString IanniX::serialize() const {
-    return transport->serialize() + getCurrentDocument()->serialize();
+const QString IanniX::serialize(bool withObjects) const {
+    return transport->serialize() + getCurrentDocument()->serialize(withObjects);
 }
 
 void IanniX::timerEvent(QTimerEvent *event) {
@@ -371,19 +469,114 @@ void IanniX::timerTick(bool force) {
     if(!force)
         MessageManager::networkManualParsing();
 
-    //Tick !
-    if((force) || (Transport::timerOk))
+    //Clock and trigger-offs run even when paused (offline, only the rendering steps move the clock)
+    if(!schedulerThread->isRunning())
+        schedulerClockTick((offline)?(0):(delta));
+
+    //Tick ! (unless the scheduler thread does it)
+    if(force)
+        timerTick(delta);
+    else if(!schedulerThread->isRunning()) {
+        measureSchedulerJitter(timer->interval());
+        if(Transport::timerOk)
+            timerTick(delta);
+    }
+}
+void IanniX::schedulerTick(qreal delta, qreal interval) {
+    measureSchedulerJitter(interval);
+    schedulerClockTick(delta);
+    if(Transport::timerOk)
         timerTick(delta);
 }
+//Trigger-offs follow the clock of the scheduler, on whichever thread it ticks
+void IanniX::setObjectTrigEnd(void *_object, qreal delay) {
+    schedulerTrigEnds.append(qMakePair(QPointer<NxTrigger>((NxTrigger*)_object), schedulerClockTime + delay));
+}
+void IanniX::schedulerClockTick(qreal delta) {
+    //Wall clock in real time, sum of the steps when rendering offline (message rates and trigger-offs)
+    schedulerClockTime += delta;
+    if(offline) Transport::currentMSecsSinceEpoch = schedulerClockOrigin + qRound64(schedulerClockTime * 1000);
+    else        Transport::currentMSecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+
+    if(schedulerTrigEnds.isEmpty())
+        return;
+
+    bool bundleOpen = false;
+    for(quint32 trigEndIndex = 0 ; trigEndIndex < (quint32)schedulerTrigEnds.count() ; ) {
+        if(schedulerTrigEnds.at(trigEndIndex).second > schedulerClockTime) {
+            trigEndIndex++;
+            continue;
+        }
+        QPointer<NxTrigger> trigger = schedulerTrigEnds.takeAt(trigEndIndex).first;
+        if(trigger) {
+            if(!bundleOpen) {
+                MessageManager::networkBundle(true);
+                bundleOpen = true;
+            }
+            trigger->trigEnd();
+        }
+    }
+    if(bundleOpen)
+        MessageManager::networkBundle(false);
+}
+void IanniX::measureSchedulerJitter(qreal interval) {
+    qint64 schedulerClockNow = schedulerClock.nsecsElapsed();
+    if(schedulerClockOld > 0)
+        Transport::perfSchedulerJitter.append(qAbs((schedulerClockNow - schedulerClockOld) / 1000000. - interval));
+    schedulerClockOld = schedulerClockNow;
+}
+
+//Per-cursor update, safe to run on a worker thread
+class SchedulerCursorUpdate {
+public:
+    typedef void result_type;
+    SchedulerCursorUpdate(qreal _delta) : delta(_delta) {}
+    qreal delta;
+public:
+    inline void update(NxCursor *cursor) const {
+        //Cursor reset
+        if(Transport::forceTimeLocal) {
+            cursor->setTimeLocal(Transport::timeLocal);
+            cursor->setMessageId(0);
+        }
+
+        //Set time for a cursor
+        cursor->setTime(delta);
+    }
+    inline void operator()(const QVector<NxCursor*> &cursors) const {
+        foreach(NxCursor *cursor, cursors)
+            update(cursor);
+    }
+};
 
 void IanniX::timerTick(qreal delta) {
-    Transport::currentMSecsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
     if(Transport::forceTimeLocal) {
         delta = 0;
         if(schedulerActivity == SchedulerOneShot)
             setScheduler(SchedulerOff);
     }
-    Transport::timeLocal += delta * Transport::scoreSpeed;
+
+    //MIDI clock slave : the master tempo becomes the score speed, the phase error is absorbed smoothly
+    qreal speed = Transport::scoreSpeed;
+    if((InterfaceMidi::syncClockIn) && (!Transport::forceTimeLocal)) {
+        qreal clockTempo = 0, clockSpeed = 0, clockTarget = 0;
+        switch(InterfaceMidi::clockSlave.follow(Transport::timeLocal, delta, &clockTempo, &clockSpeed, &clockTarget)) {
+        case ExtMidiClock::FollowSmooth:
+            Transport::scoreSpeed = clockTempo;
+            speed = clockSpeed;
+            break;
+        case ExtMidiClock::FollowJump:
+            Transport::scoreSpeed = clockTempo;
+            Transport::timeLocal = clockTarget;
+            Transport::forceTimeLocal = true;
+            delta = 0;
+            break;
+        default:
+            break;
+        }
+    }
+
+    Transport::timeLocal += delta * speed;
     if(Transport::timeLocal < 0) {
         Transport::forceTimeLocal = true;
         Transport::timeLocal = 0;
@@ -391,11 +584,15 @@ void IanniX::timerTick(qreal delta) {
     }
     Transport::perfSchedulerRefreshTime += delta;
     Transport::perfSchedulerCounterTime++;
+    QElapsedTimer tickTimer;
+    tickTimer.start();
 
     //Open a bundle if necessary
     MessageManager::networkBundle(true);
 
     //Browse documents
+    schedulerCursors.resize(0);
+    schedulerCursorGroups.resize(0);
     QHashIterator<QString, NxDocument*> documentIterator(documents);
     while (documentIterator.hasNext()) {
         documentIterator.next();
@@ -413,33 +610,57 @@ void IanniX::timerTick(qreal delta) {
                         NxCursor *cursor = (NxCursor*)cursorIterator.value();
                         NxCurve  *curve  = cursor->getCurve();
 
-                        //Calculate curve
+                        //Calculate curve (shared between cursors, so never in parallel)
                         if(curve)
                             curve->update();
 
-                        //Cursor reset
-                        if(Transport::forceTimeLocal) {
-                            cursor->setTimeLocal(Transport::timeLocal);
-                            cursor->setMessageId(0);
-                        }
-
-                        //Set time for a cursor
-                        cursor->setTime(delta * Transport::scoreSpeed);
-
-                        //Is cursor active ?
-                        if((!Transport::forceTimeLocal) && (cursor->getActive()) && (((!isGroupSoloActive) && (group->isNotMuted())) || ((isGroupSoloActive) && (group->isSolo()))) && (((!isObjectSoloActive) && (cursor->isNotMuted())) || ((isObjectSoloActive) && (cursor->isSolo()))))
-                            timerTrig(cursor);
+                        schedulerCursors.append(cursor);
+                        schedulerCursorGroups.append(group);
                     }
                 }
             }
         }
     }
 
+    //Set time for all cursors (in parallel on large scores)
+    SchedulerCursorUpdate cursorUpdate(delta * speed);
+    if((schedulerCursors.count() >= schedulerParallelThreshold) && (QThreadPool::globalInstance()->maxThreadCount() > 1)) {
+        //One job per curve : cursors sharing a curve are updated on the same thread
+        QHash<void*, int> schedulerJobIndexes;
+        schedulerCursorJobs.resize(0);
+        foreach(NxCursor *cursor, schedulerCursors) {
+            void *key = (cursor->getCurve())?((void*)cursor->getCurve()):((void*)cursor);
+            int jobIndex = schedulerJobIndexes.value(key, -1);
+            if(jobIndex < 0) {
+                jobIndex = schedulerCursorJobs.count();
+                schedulerJobIndexes.insert(key, jobIndex);
+                schedulerCursorJobs.append(QVector<NxCursor*>());
+            }
+            schedulerCursorJobs[jobIndex].append(cursor);
+        }
+        QtConcurrent::blockingMap(schedulerCursorJobs, cursorUpdate);
+    }
+    else {
+        foreach(NxCursor *cursor, schedulerCursors)
+            cursorUpdate.update(cursor);
+    }
+
+    //Triggers, collisions and messages in the original order
+    for(quint32 cursorIndex = 0 ; cursorIndex < (quint32)schedulerCursors.count() ; cursorIndex++) {
+        NxCursor *cursor = schedulerCursors.at(cursorIndex);
+        const NxGroup *group = schedulerCursorGroups.at(cursorIndex);
+
+        //Is cursor active ?
+        if((!Transport::forceTimeLocal) && (cursor->getActive()) && (((!isGroupSoloActive) && (group->isNotMuted())) || ((isGroupSoloActive) && (group->isSolo()))) && (((!isObjectSoloActive) && (cursor->isNotMuted())) || ((isObjectSoloActive) && (cursor->isSolo()))))
+            timerTrig(cursor);
+    }
+
     //Close the bundle if necessary
     MessageManager::networkBundle(false);
 
     if(Transport::forceTimeLocal)
         Transport::forceTimeLocal = false;
+    Transport::perfSchedulerTickTime += tickTimer.nsecsElapsed() / 1000000.;
 }
 
 void IanniX::timerTrig(void *object, bool force) {
@@ -451,28 +672,36 @@ void IanniX::timerTrig(void *object, bool force) {
 
     //Browse documents
     if(cursor->getFireValue() > CURSOR_FIRE_NONE) {
+        //Area swept by the cursor since the previous ticks
+        NxRect collisionArea;
+        bool collisionAreaReliable = cursor->getCollisionArea(&collisionArea);
+        QVector<NxTrigger*> collisionTriggers;
+
         QHashIterator<QString, NxDocument*> documentIterator(documents);
         while (documentIterator.hasNext()) {
             documentIterator.next();
             NxDocument *document = documentIterator.value();
 
-            //Browse groups
-            foreach(const NxGroup *group, document->groups) {
+            //Browse nearby active triggers
+            collisionTriggers.clear();
+            if(collisionAreaReliable)   document->triggerIndex.query(collisionArea, &collisionTriggers);
+            else                        document->triggerIndex.queryAll(&collisionTriggers);
+            foreach(NxTrigger *trigger, collisionTriggers) {
                 //Test if group is the right on
-                if((cursor->getFireValue() == CURSOR_FIRE_ALL) || ((cursor->getFireValue() == CURSOR_FIRE_GROUP) && (cursor->getGroupId() == group->getId()))) {
-                    //Browse active triggers
-                    QHashIterator<quint16, NxObject*> triggerIterator(group->objects[ObjectsActivityActive][ObjectsTypeTrigger]);
-                    while (triggerIterator.hasNext()) {
-                        triggerIterator.next();
-                        NxTrigger *trigger = (NxTrigger*)triggerIterator.value();
-
-                        //Check the collision
-                        if((cursor->contains(trigger)) && (((!isObjectSoloActive) && (trigger->isNotMuted())) || ((isObjectSoloActive) && (trigger->isSolo()))) && ((!Application::allowPlaySelected) || (!render->isSelection()) || ((Application::allowPlaySelected) && (trigger->getSelected()))))
-                            trigger->trig(cursor);
-                    }
+                if((cursor->getFireValue() == CURSOR_FIRE_GROUP) && (cursor->getGroupId() != trigger->getGroupId()))
+                    continue;
 
-                    //Browse active curbes
-                    if(cursor->getPerformCollision()) {
+                //Check the collision
+                Transport::perfSchedulerCollisionCounter++;
+                if((cursor->contains(trigger)) && (((!isObjectSoloActive) && (trigger->isNotMuted())) || ((isObjectSoloActive) && (trigger->isSolo()))) && ((!Application::allowPlaySelected) || (!render->isSelection()) || ((Application::allowPlaySelected) && (trigger->getSelected()))))
+                    trigger->trig(cursor);
+            }
+
+            //Browse groups
+            if(cursor->getPerformCollision()) {
+                foreach(const NxGroup *group, document->groups) {
+                    //Test if group is the right on
+                    if((cursor->getFireValue() == CURSOR_FIRE_ALL) || ((cursor->getFireValue() == CURSOR_FIRE_GROUP) && (cursor->getGroupId() == group->getId()))) {
                         QHashIterator<quint16, NxObject*> curveIterator(group->objects[ObjectsActivityActive][ObjectsTypeCurve]);
                         while (curveIterator.hasNext()) {
                             curveIterator.next();
@@ -543,6 +772,7 @@ void IanniX::forceGoto(qreal gotoTime, bool) {
 }
 void IanniX::forceSchedulerTimer(qreal val) {
     timer->setInterval(val);
+    schedulerThread->setInterval(val);
 }
 void IanniX::forceOpenGLTimer(qreal val) {
     render->setInterval(1000.0F/(qreal)val);
@@ -688,8 +918,12 @@ void IanniX::setObjectActivity(void *_object, quint8 activeOld) {
     NxGroup *group = addGroup(object->getGroupId());
 
     //Move object
-    group->objects[activeOld]          [object->getType()].remove(object->getId());
-    group->objects[object->getActive()][object->getType()].insert(object->getId(), object);
+    document->removeGroupObject(group, activeOld,           object->getType(), object->getId());
+    document->insertGroupObject(group, object->getActive(), object->getType(), object);
+    if(object->getType() == ObjectsTypeTrigger)
+        document->triggerIndex.update((NxTrigger*)object);
+    if(object->getType() != ObjectsTypeCursor)
+        document->pickIndex.update(object);
 }
 void IanniX::setObjectGroupId(void *_object, const QString & groupIdOld) {
     NxDocument *document = getWorkingDocument();
@@ -701,9 +935,13 @@ void IanniX::setObjectGroupId(void *_object, const QString & groupIdOld) {
     NxGroup *group = addGroup(object->getGroupId());
 
     //Move object
-    group->objects[object->getActive()][object->getType()].insert(object->getId(), object);
+    document->insertGroupObject(group, object->getActive(), object->getType(), object);
     if(document->groups.contains(groupIdOld))
-        document->groups[groupIdOld]->objects[object->getActive()][object->getType()].remove(object->getId());
+        document->removeGroupObject(document->groups[groupIdOld], object->getActive(), object->getType(), object->getId());
+    if(object->getType() == ObjectsTypeTrigger)
+        document->triggerIndex.update((NxTrigger*)object);
+    if(object->getType() != ObjectsTypeCursor)
+        document->pickIndex.update(object);
 
     //Remove a group if empty
     /*
@@ -721,26 +959,49 @@ void IanniX::setObjectId(void *_object, quint16 idOld) {
     NxGroup *group = addGroup(object->getGroupId());
 
     //Move object
-    group->objects[object->getActive()][object->getType()].insert(object->getId(), object);
-    group->objects[object->getActive()][object->getType()].remove(idOld);
-    document->objects.insert(object->getId(), object);
-    document->objects.remove(idOld);
+    document->insertGroupObject(group, object->getActive(), object->getType(), object);
+    document->removeGroupObject(group, object->getActive(), object->getType(), idOld);
+    document->insertObject(object->getId(), object);
+    if(idOld != object->getId())
+        document->removeObject(idOld);
+}
+void IanniX::setObjectPos(void *_object) {
+    NxDocument *document = getWorkingDocument();
+    if(!document)
+        return;
+
+    //Move trigger in the collision grid and object in the picking grid (only if already registered)
+    NxObject *object = (NxObject*)_object;
+    if(object->getType() == ObjectsTypeTrigger)
+        Render::triggersRevision++;
+    if((object->getType() == ObjectsTypeTrigger) && (document->triggerIndex.contains((NxTrigger*)object)))
+        document->triggerIndex.update((NxTrigger*)object);
+    if(document->pickIndex.contains(object))
+        document->pickIndex.update(object);
+}
+void IanniX::journalObjectProperty(void *_object, const char *_property) {
+    NxDocument *document = getWorkingDocument();
+    if(!document)
+        return;
+
+    //Only objects registered in the score are journaled (not the ones being built)
+    NxObject *object = (NxObject*)_object;
+    if(document->objects.value(object->getId()) == object)
+        document->undoJournal.record(object, _property);
 }
 
 
 
 
 quint16 IanniX::getCount(qint8 objectType) {
-    quint16 count = 0;
     NxDocument *document = getWorkingDocument();
     if(document) {
         if(objectType == -2)
             return document->groups.count();
         else
-            foreach(NxGroup *group, document->groups)
-                count += group->getCount(objectType);
+            return document->getCount(objectType);
     }
-    return count;
+    return 0;
 }
 void IanniX::removeObject(NxObject *object) {
     NxDocument *document = getWorkingDocument();
@@ -749,8 +1010,11 @@ void IanniX::removeObject(NxObject *object) {
             render->flagIsRemoving();
 
         //Remove the object
-        document->groups[object->getGroupId()]->objects[object->getActive()][object->getType()].remove(object->getId());
-        document->objects.remove(object->getId());
+        document->removeGroupObject(document->groups[object->getGroupId()], object->getActive(), object->getType(), object->getId());
+        document->removeObject(object->getId());
+        if(object->getType() == ObjectsTypeTrigger)
+            document->triggerIndex.remove((NxTrigger*)object);
+        document->pickIndex.remove(object);
 
         //Clear selection
         inspector->clearCCselections();
@@ -771,6 +1035,7 @@ void IanniX::removeObject(NxObject *object) {
             if(curve)
                 curve->removeCursor(object);
         }
+        document->undoJournal.recordRemove(object);
 
         //Remove groups
         if((document->groups.contains(object->getGroupId())) && (document->groups.value(object->getGroupId())->getCount() == 0)) {
@@ -786,13 +1051,76 @@ void IanniX::removeObject(NxObject *object) {
 }
 
 
+QHash<QString, CommandEntry> IanniX::commands;
+const CommandEntry IanniX::commandUnknown;
+void IanniX::registerCommands() {
+    if(commands.count())
+        return;
+    QList<CommandEntry> entries;
+    entries << CommandEntry(COMMAND_ADD, CommandAdd);
+
+    //Global commands
+    entries << CommandEntry(COMMAND_ROTATE, CommandGlobal) << CommandEntry(COMMAND_CENTER, CommandGlobal) << CommandEntry(COMMAND_ZOOM, CommandGlobal) << CommandEntry(COMMAND_SPEED, CommandGlobal) << CommandEntry("setlegend", CommandGlobal);
+    entries << CommandEntry(COMMAND_SOLO, CommandGlobal) << CommandEntry(COMMAND_MUTE, CommandGlobal) << CommandEntry(COMMAND_TEXTURE, CommandGlobal) << CommandEntry(COMMAND_GLOBAL_COLOR, CommandGlobal) << CommandEntry(COMMAND_GLOBAL_COLOR_HUE, CommandGlobal);
+    entries << CommandEntry(COMMAND_LOAD, CommandGlobal) << CommandEntry(COMMAND_OPEN, CommandGlobal) << CommandEntry(COMMAND_CLOSE, CommandGlobal) << CommandEntry(COMMAND_SNAPSHOT, CommandGlobal) << CommandEntry(COMMAND_JOURNAL, CommandGlobal) << CommandEntry(COMMAND_MIDICLOCK, CommandGlobal) << CommandEntry(COMMAND_HTTPSINK, CommandGlobal) << CommandEntry(COMMAND_TCPSOAK, CommandGlobal) << CommandEntry(COMMAND_ARTNETSINK, CommandGlobal);
+    entries << CommandEntry(COMMAND_VIEWPORT, CommandGlobal) << CommandEntry(COMMAND_PLAY, CommandGlobal) << CommandEntry(COMMAND_TITLE, CommandGlobal) << CommandEntry(COMMAND_FF, CommandGlobal) << CommandEntry(COMMAND_LOG, CommandGlobal) << CommandEntry(COMMAND_STOP, CommandGlobal) << CommandEntry(COMMAND_GOTO, CommandGlobal) << CommandEntry(COMMAND_SLEEP, CommandGlobal) << CommandEntry(COMMAND_CLEAR, CommandGlobal) << CommandEntry(COMMAND_MOUSE, CommandGlobal) << CommandEntry(COMMAND_MESSAGE_SEND, CommandGlobal);
+
+    //String parameter
+    entries << CommandEntry(COMMAND_GROUP, CommandString) << CommandEntry(COMMAND_RESIZE, CommandString) << CommandEntry(COMMAND_POS, CommandString) << CommandEntry(COMMAND_POS_TRANSLATE, CommandString) << CommandEntry(COMMAND_LABEL, CommandString) << CommandEntry(COMMAND_CURSOR_BOUNDS_SOURCE, CommandString) << CommandEntry(COMMAND_CURSOR_BOUNDS_TARGET, CommandString);
+    entries << CommandEntry(COMMAND_CURVE_EQUATION_PARAM, CommandString) << CommandEntry(COMMAND_CURVE_EQUATION_PARAM_LIST, CommandString) << CommandEntry(COMMAND_COLOR_ACTIVE, CommandString) << CommandEntry(COMMAND_COLOR_INACTIVE, CommandString) << CommandEntry(COMMAND_COLOR_ACTIVE_HUE, CommandString) << CommandEntry(COMMAND_COLOR_INACTIVE_HUE, CommandString) << CommandEntry(COMMAND_COLOR_MULTIPLY, CommandString) << CommandEntry(COMMAND_COLOR_MULTIPLY_HUE, CommandString);
+    entries << CommandEntry(COMMAND_MESSAGE, CommandString) << CommandEntry(COMMAND_CURVE_ELL, CommandString) << CommandEntry(COMMAND_CURVE_POINT_SHIFT, CommandString) << CommandEntry(COMMAND_CURVE_POINT_TRANSLATE, CommandString) << CommandEntry(COMMAND_CURVE_POINT_TRANSLATE2, CommandString) << CommandEntry(COMMAND_CURVE_EQUATION, CommandString) << CommandEntry(COMMAND_TEXTURE_ACTIVE, CommandString) << CommandEntry(COMMAND_TEXTURE_INACTIVE, CommandString);
+    entries << CommandEntry(COMMAND_LINE, CommandString) << CommandEntry(COMMAND_CURSOR_OFFSET, CommandString) << CommandEntry(COMMAND_CURSOR_START, CommandString) << CommandEntry(COMMAND_CURSOR_SPEED, CommandString) << CommandEntry(COMMAND_CURSOR_FIRE, CommandString);
+
+    //Val + string
+    entries << CommandEntry(COMMAND_CURVE_PATH, CommandValueString) << CommandEntry(COMMAND_CURVE_LINES, CommandValueString) << CommandEntry(COMMAND_CURVE_TXT, CommandValueString);
+
+    //Single parameter
+    entries << CommandEntry(COMMAND_RESIZEF, CommandSingle) << CommandEntry(COMMAND_CURSOR_WIDTH, CommandSingle) << CommandEntry(COMMAND_CURSOR_DEPTH, CommandSingle) << CommandEntry(COMMAND_SIZE, CommandSingle) << CommandEntry(COMMAND_CURSOR_SPEEDF, CommandSingle) << CommandEntry(COMMAND_CURSOR_BOUNDS_SOURCE_MODE, CommandSingle) << CommandEntry(COMMAND_CURSOR_TIME, CommandSingle);
+    entries << CommandEntry(COMMAND_CURSOR_TIME_PERCENT, CommandSingle) << CommandEntry(COMMAND_CURVE_INERTIE, CommandSingle) << CommandEntry(COMMAND_CURVE_LENGTH, CommandSingle) << CommandEntry(COMMAND_POS_X, CommandSingle) << CommandEntry(COMMAND_POS_Y, CommandSingle) << CommandEntry(COMMAND_POS_Z, CommandSingle) << CommandEntry(COMMAND_ACTIVE, CommandSingle);
+    entries << CommandEntry(COMMAND_MESSAGE_INTERVAL, CommandSingle) << CommandEntry(COMMAND_TRIGGER_OFF, CommandSingle) << CommandEntry(COMMAND_CURVE_EQUATION_POINTS, CommandSingle) << CommandEntry(COMMAND_CURVE_POINT_RMV, CommandSingle) << CommandEntry(COMMAND_ID, CommandSingle);
+
+    //Points
+    entries << CommandEntry(COMMAND_CURVE_POINT, CommandPoints) << CommandEntry(COMMAND_CURVE_POINT_SMOOTH, CommandPoints) << CommandEntry(COMMAND_CURVE_POINT_X, CommandPoints) << CommandEntry(COMMAND_CURVE_POINT_Y, CommandPoints) << CommandEntry(COMMAND_CURVE_POINT_Z, CommandPoints);
+
+    //Activation, specific syntax and dual actions
+    entries << CommandEntry(COMMAND_TRIG, CommandActivation) << CommandEntry(COMMAND_CURVE_EDITOR, CommandActivation) << CommandEntry(COMMAND_CURVE_RESAMPLE, CommandActivation) << CommandEntry(COMMAND_REMOVE, CommandRemove) << CommandEntry(COMMAND_CURSOR_CURVE, CommandCursorCurve);
+    entries << CommandEntry(COMMAND_COLOR_GLOBAL, CommandColorGlobal) << CommandEntry(COMMAND_COLOR_GLOBAL_HUE, CommandColorGlobalHue) << CommandEntry(COMMAND_TEXTURE_GLOBAL, CommandTextureGlobal);
+
+    foreach(const CommandEntry &entry, entries)
+        commands.insert(entry.verb, entry);
+}
+
 const QVariant IanniX::execute(const MessageIncomming &command, bool createNewObjectIfExists, bool needOutput) {
     if(waitingForMessageValue) {
         waitingForMessageValue = false;
         waitForMessageValue = command.getVerboseMessage(true);
         emit(waitForMessageArrived());
     }
-    return execute(command.command, ExecuteSourceNetwork, createNewObjectIfExists, needOutput);
+    //Typed arguments (OSC) go straight to the object when the command only needs numbers
+    if((command.values.count()) && (!needOutput) && (execute(command.destination, command.values)))
+        return QVariant();
+    return execute(command.getCommand(), ExecuteSourceNetwork, createNewObjectIfExists, needOutput);
+}
+bool IanniX::execute(const QString &commande, const QVariantList &values) {
+    if(values.count() < 2)
+        return false;
+    const CommandEntry &entry = getCommand(commande);
+    if((entry.kind != CommandSingle) && (entry.kind != CommandPoints))
+        return false;
+
+    NxObjectDispatchProperty *object = getObject(MessageIncomming::getValueStr(values.at(0)));
+    if(object) {
+        NxObjectDispatchProperty::source = ExecuteSourceNetwork;
+        if(entry.kind == CommandSingle)
+            object->dispatchProperty(entry.property.constData(), values.at(1).toDouble());
+        else {
+            QList<qreal> points;
+            for(quint16 i = 1 ; i < values.count() ; i++)
+                points.append(values.at(i).toDouble());
+            object->dispatchProperty(entry.property.constData(), QVariant::fromValue(points));
+        }
+    }
+    return true;
 }
 const QVariant IanniX::execute(const QString &command, ExecuteSource source, bool createNewObjectIfExists, bool needOutput) {
     //qDebug("=> (%d) %s", source, qPrintable(command));
@@ -808,8 +1136,9 @@ const QVariant IanniX::execute(const QString &command, ExecuteSource source, boo
     QStringList argv = command.split(" ", QString::SkipEmptyParts);
     quint16 argc = argv.count();
     if(argc > 0) {
-        QString commande = argv.at(0).toLower();
-        if((argc > 2) && (commande == COMMAND_ADD)) {
+        const CommandEntry &entry = getCommand(argv.at(0));
+        const QByteArray &commande = entry.property;
+        if((argc > 2) && (entry.kind == CommandAdd)) {
             bool ok = false;
             qint16 id = argv.at(2).toUInt(&ok);
             NxObject *parentObject = 0;
@@ -822,6 +1151,9 @@ const QVariant IanniX::execute(const QString &command, ExecuteSource source, boo
                     else {
                         id = parentObject->getId();
                         //removeObject(parentObject);
+                        if(parentObject->getType() == ObjectsTypeTrigger)
+                            document->triggerIndex.remove((NxTrigger*)parentObject);
+                        document->pickIndex.remove(parentObject);
                         parentObject = 0;
                     }
                 }
@@ -848,18 +1180,19 @@ const QVariant IanniX::execute(const QString &command, ExecuteSource source, boo
                     NxPoint posOffset(0.5, -0.5, 0);
                     object->setPosOffset(posOffset);
                 }
-                document->objects[id] = object;
+                document->insertObject(id, object);
+                document->undoJournal.recordAdd(object);
                 document->setCurrentObject(object);
                 return object->getId();
             }
             return 0;
         }
-        else {
+        else if(entry.kind == CommandGlobal) {
             // ---- GLOBAL COMMANDS ----
             //String parameter
             if((commande == COMMAND_ROTATE) || (commande == COMMAND_CENTER)) {
                 if(workingDocument == currentDocument) {
-                    if((argc == 4) || (argc == 7)) transport->dispatchProperty(qPrintable(commande), argvFullString(command, argv, 1));
+                    if((argc == 4) || (argc == 7)) transport->dispatchProperty(commande.constData(), argvFullString(command, argv, 1));
                     else if((argc > 4) && (commande == COMMAND_ROTATE)) {
                         NxGroup *group = document->getGroup(argv.at(1));
                         if(group)
@@ -870,19 +1203,19 @@ const QVariant IanniX::execute(const QString &command, ExecuteSource source, boo
                         if(group)
                             group->translationDest = NxPoint(argv.at(2).toDouble(), argv.at(3).toDouble(), argv.at(4).toDouble());
                     }
-                    if(needOutput)  return transport->getProperty(qPrintable(commande));
+                    if(needOutput)  return transport->getProperty(commande.constData());
                 }
             }
             //Single parameter
             else if((commande == COMMAND_ZOOM) || (commande == COMMAND_SPEED)) {
                 if(workingDocument == currentDocument) {
-                    if(argc == 2)    transport->dispatchProperty(qPrintable(commande), argvDouble(argv, 1));
+                    if(argc == 2)    transport->dispatchProperty(commande.constData(), argvDouble(argv, 1));
                     else if((argc > 2) && (commande == COMMAND_ZOOM)) {
                         NxGroup *group = document->getGroup(argv.at(1));
                         if(group)
                             group->scaleDest = argv.at(2).toDouble();
                     }
-                    if(needOutput)  return transport->getProperty(qPrintable(commande));
+                    if(needOutput)  return transport->getProperty(commande.constData());
                 }
             }
 
@@ -908,24 +1241,24 @@ const QVariant IanniX::execute(const QString &command, ExecuteSource source, boo
                         NxObject *object = document->getObject(objectId);
                         if(object) {
                             if(argc > 2) {
-                                object->dispatchProperty(qPrintable(commande), argvDouble(argv, 2));
+                                object->dispatchProperty(commande.constData(), argvDouble(argv, 2));
                                 if(currentDocument == workingDocument)
                                     actionCC(object, 3);
                             }
                             else if(needOutput)
-                                return object->getProperty(qPrintable(commande)).toInt();
+                                return object->getProperty(commande.constData()).toInt();
                         }
                     }
                     else {
                         NxGroup *group = document->getGroup(key);
                         if(group) {
                             if(argc > 2) {
-                                group->dispatchPropertyToGroup(qPrintable(commande), argvDouble(argv, 2));
+                                group->dispatchPropertyToGroup(commande.constData(), argvDouble(argv, 2));
                                 if(currentDocument == workingDocument)
                                     actionCC(group, 3);
                             }
                             else if(needOutput)
-                                return group->getPropertyFromGroup(qPrintable(commande)).toInt();
+                                return group->getPropertyFromGroup(commande.constData()).toInt();
                         }
                     }
                 }
@@ -1017,6 +1350,34 @@ const QVariant IanniX::execute(const QString &command, ExecuteSource source, boo
                 if(argc > 2)        return render->captureFrame(argvDouble(argv, 1), argvFullString(command, argv, 2));
                 else                return render->captureFrame(argvDouble(argv, 1));
             }
+            else if((commande == COMMAND_JOURNAL) && (argc > 1)) {
+                const QString action = argv.at(1).toLower();
+                if((action == "record") && (argc > 2))          MessageJournal::startRecording(argvFullString(command, argv, 2));
+                else if(action == "stop") {
+                    MessageJournal::stopRecording();
+                    messageJournal->stop();
+                }
+                else if((action == "replay") && (argc > 3))     messageJournal->replay(argvFullString(command, argv, 3), argvDouble(argv, 2));
+                else if((action == "bench") && (argc > 3))      benchmarkCommands(argvFullString(command, argv, 3), argvDouble(argv, 2));
+            }
+            else if((commande == COMMAND_MIDICLOCK) && (argc > 1)) {
+                //Synthetic MIDI clock (bpm, jitter in ms) to test the slave mode, 0 stops it
+                qreal bpm = argvDouble(argv, 1);
+                if(bpm > 0)     interfaceMidi->clockGenerator->start(bpm, (argc > 2)?(argvDouble(argv, 2)):(0.));
+                else            interfaceMidi->clockGenerator->stop();
+            }
+            else if((commande == COMMAND_HTTPSINK) && (argc > 1)) {
+                //Local HTTP server counting received messages (port, 0 closes it)
+                interfaceHttp->sinkChanged(argvDouble(argv, 1));
+            }
+            else if((commande == COMMAND_TCPSOAK) && (argc > 1)) {
+                //Local TCP clients (count, duration in seconds) hammering the TCP interface
+                interfaceTcp->soak(argvDouble(argv, 1), (argc > 2)?(argvDouble(argv, 2)):(10.));
+            }
+            else if((commande == COMMAND_ARTNETSINK) && (argc > 1)) {
+                //Local Art-Net receiver counting ArtDmx packets per universe (port, 0 closes it)
+                interfaceArtnet->sinkChanged(argvDouble(argv, 1));
+            }
             else if(commande == COMMAND_VIEWPORT) {
                 if(currentDocument == workingDocument) {
                     if(argc > 2)        view->actionResize(QSize(argvDouble(argv, 1), argvDouble(argv, 2)));
@@ -1090,102 +1451,219 @@ const QVariant IanniX::execute(const QString &command, ExecuteSource source, boo
                     return true;
                 }
             }
+        }
 
+        // ---- OBJECT ORIENTED COMMANDS ----
+        else if((entry.kind != CommandUnknown) && (argc > 1)) {
+            NxObjectDispatchProperty *object = getObject(argv.at(1));
 
-
-            // ---- OBJECT ORIENTED COMMANDS ----
-            else if(argc > 1) {
-                NxObjectDispatchProperty *object = getObject(argv.at(1));
-
-                if(object) {
-                    //String parameter
-                    if((commande == COMMAND_GROUP) || (commande == COMMAND_RESIZE) || (commande == COMMAND_POS) || (commande == COMMAND_POS_TRANSLATE) || (commande == COMMAND_LABEL) || (commande == COMMAND_CURSOR_BOUNDS_SOURCE) || (commande == COMMAND_CURSOR_BOUNDS_TARGET) || (commande == COMMAND_CURVE_EQUATION_PARAM) || (commande == COMMAND_CURVE_EQUATION_PARAM_LIST) || (commande == COMMAND_COLOR_ACTIVE) || (commande == COMMAND_COLOR_INACTIVE) || (commande == COMMAND_COLOR_ACTIVE_HUE) || (commande == COMMAND_COLOR_INACTIVE_HUE) || (commande == COMMAND_COLOR_MULTIPLY) || (commande == COMMAND_COLOR_MULTIPLY_HUE) || (commande == COMMAND_MESSAGE) || (commande == COMMAND_CURVE_ELL) || (commande == COMMAND_CURVE_POINT_SHIFT) || (commande == COMMAND_CURVE_POINT_TRANSLATE) || (commande == COMMAND_CURVE_POINT_TRANSLATE2) || (commande == COMMAND_CURVE_EQUATION) || (commande == COMMAND_TEXTURE_ACTIVE) || (commande == COMMAND_TEXTURE_INACTIVE) || (commande == COMMAND_LINE) || (commande == COMMAND_CURSOR_OFFSET) || (commande == COMMAND_CURSOR_START) || (commande == COMMAND_CURSOR_SPEED) || (commande == COMMAND_CURSOR_FIRE)) {
-                        if(argc > 2)    object->dispatchProperty(qPrintable(commande), argvFullString(command, argv, 2));
-                        if(needOutput)  return object->getProperty(qPrintable(commande));
-                    }
-                    //Val + string
-                    else if((commande == COMMAND_CURVE_PATH) || (commande == COMMAND_CURVE_LINES) || (commande == COMMAND_CURVE_TXT)) {
-                        if(argc > 3)  {
-                            object->dispatchProperty(qPrintable(commande), argvFullString(command, argv, 3));
-                            object->dispatchProperty(COMMAND_RESIZEF, argvDouble(argv, 2));
-                        }
-                        if(needOutput)  return object->getProperty(qPrintable(commande));
-                    }
-
-                    //Single parameter
-                    else if((commande == COMMAND_RESIZEF) || (commande == COMMAND_CURSOR_WIDTH) || (commande == COMMAND_CURSOR_DEPTH) || (commande == COMMAND_SIZE) || (commande == COMMAND_CURSOR_SPEEDF) || (commande == COMMAND_CURSOR_BOUNDS_SOURCE_MODE) || (commande == COMMAND_CURSOR_TIME) || (commande == COMMAND_CURSOR_TIME_PERCENT) || (commande == COMMAND_CURVE_INERTIE) || (commande == COMMAND_CURVE_LENGTH) || (commande == COMMAND_POS_X) || (commande == COMMAND_POS_Y) || (commande == COMMAND_POS_Z) || (commande == COMMAND_ACTIVE) || (commande == COMMAND_MESSAGE_INTERVAL) || (commande == COMMAND_TRIGGER_OFF) || (commande == COMMAND_CURVE_EQUATION_POINTS) || (commande == COMMAND_CURVE_POINT_RMV) || (commande == COMMAND_ID)) {
-                        if(argc > 2)    object->dispatchProperty(qPrintable(commande), argvDouble(argv, 2));
-                        if(needOutput)  return object->getProperty(qPrintable(commande));
-                    }
-
-                    //Activation
-                    else if((commande == COMMAND_TRIG) || (commande == COMMAND_CURVE_EDITOR) || (commande == COMMAND_CURVE_RESAMPLE)) {
-                        if(commande == COMMAND_CURVE_RESAMPLE)
-                            pushSnapshot();
-                        object->dispatchProperty(qPrintable(commande), true);
+            if(object) {
+                switch(entry.kind) {
+                //String parameter
+                case CommandString:
+                    if(argc > 2)    object->dispatchProperty(commande.constData(), argvFullString(command, argv, 2));
+                    if(needOutput)  return object->getProperty(commande.constData());
+                    break;
+                //Val + string
+                case CommandValueString:
+                    if(argc > 3)  {
+                        object->dispatchProperty(commande.constData(), argvFullString(command, argv, 3));
+                        object->dispatchProperty(COMMAND_RESIZEF, argvDouble(argv, 2));
                     }
-
-                    //Specific syntax
-                    else if((commande == COMMAND_REMOVE) && (argc > 1) && ((object->getType() == ObjectsTypeCursor) || (object->getType() == ObjectsTypeCurve) || (object->getType() == ObjectsTypeTrigger))) {
+                    if(needOutput)  return object->getProperty(commande.constData());
+                    break;
+
+                //Single parameter
+                case CommandSingle:
+                    if(argc > 2)    object->dispatchProperty(commande.constData(), argvDouble(argv, 2));
+                    if(needOutput)  return object->getProperty(commande.constData());
+                    break;
+
+                //Activation
+                case CommandActivation:
+                    if(commande == COMMAND_CURVE_RESAMPLE)
+                        pushSnapshot();
+                    object->dispatchProperty(commande.constData(), true);
+                    break;
+
+                //Specific syntax
+                case CommandRemove:
+                    if((object->getType() == ObjectsTypeCursor) || (object->getType() == ObjectsTypeCurve) || (object->getType() == ObjectsTypeTrigger)) {
                         NxObject *object = (NxObject*)getObject(argv.at(1), false);
                         removeObject(object);
                         return false;
                     }
-                    else if((commande == COMMAND_CURVE_POINT) || (commande == COMMAND_CURVE_POINT_SMOOTH) || (commande == COMMAND_CURVE_POINT_X) || (commande == COMMAND_CURVE_POINT_Y) || (commande == COMMAND_CURVE_POINT_Z)) {
-                        QList<qreal> points;
-                        for(quint16 i = 2 ; i < argc ; i++)
-                            points.append(argv.at(i).toDouble());
-                        object->dispatchProperty(qPrintable(commande), QVariant::fromValue(points));
-                    }
+                    break;
+                case CommandPoints: {
+                    QList<qreal> points;
+                    for(quint16 i = 2 ; i < argc ; i++)
+                        points.append(argv.at(i).toDouble());
+                    object->dispatchProperty(commande.constData(), QVariant::fromValue(points));
+                    break;
+                }
 
 
-                    //Dual actions
-                    else if(commande == COMMAND_COLOR_GLOBAL) {
-                        if(argc > 2) {
-                            object->dispatchProperty(COMMAND_COLOR_ACTIVE,   argvFullString(command, argv, 2));
-                            object->dispatchProperty(COMMAND_COLOR_INACTIVE, argvFullString(command, argv, 2));
-                        }
-                        if(needOutput)  return object->getProperty(COMMAND_COLOR_ACTIVE);
+                //Dual actions
+                case CommandColorGlobal:
+                    if(argc > 2) {
+                        object->dispatchProperty(COMMAND_COLOR_ACTIVE,   argvFullString(command, argv, 2));
+                        object->dispatchProperty(COMMAND_COLOR_INACTIVE, argvFullString(command, argv, 2));
                     }
-                    else if(commande == COMMAND_COLOR_GLOBAL_HUE) {
-                        if(argc > 2) {
-                            object->dispatchProperty(COMMAND_COLOR_ACTIVE_HUE,   argvFullString(command, argv, 2));
-                            object->dispatchProperty(COMMAND_COLOR_INACTIVE_HUE, argvFullString(command, argv, 2));
-                        }
-                        if(needOutput)  return object->getProperty(COMMAND_COLOR_ACTIVE_HUE);
+                    if(needOutput)  return object->getProperty(COMMAND_COLOR_ACTIVE);
+                    break;
+                case CommandColorGlobalHue:
+                    if(argc > 2) {
+                        object->dispatchProperty(COMMAND_COLOR_ACTIVE_HUE,   argvFullString(command, argv, 2));
+                        object->dispatchProperty(COMMAND_COLOR_INACTIVE_HUE, argvFullString(command, argv, 2));
                     }
-                    else if(commande == COMMAND_TEXTURE_GLOBAL) {
-                        if(argc > 2) {
-                            object->dispatchProperty(COMMAND_TEXTURE_ACTIVE,          argv.at(2));
-                            object->dispatchProperty(COMMAND_TEXTURE_INACTIVE,        argv.at(2));
-                        }
-                        if(needOutput)  return object->getProperty(COMMAND_TEXTURE_ACTIVE);
+                    if(needOutput)  return object->getProperty(COMMAND_COLOR_ACTIVE_HUE);
+                    break;
+                case CommandTextureGlobal:
+                    if(argc > 2) {
+                        object->dispatchProperty(COMMAND_TEXTURE_ACTIVE,          argv.at(2));
+                        object->dispatchProperty(COMMAND_TEXTURE_INACTIVE,        argv.at(2));
                     }
+                    if(needOutput)  return object->getProperty(COMMAND_TEXTURE_ACTIVE);
+                    break;
 
 
-                    //No undo or specific commands
+                //No undo or specific commands
+                case CommandCursorCurve:
                     if(object->getType() == ObjectsTypeCursor) {
                         NxCursor *cursor = (NxCursor*)object;
-                        if(commande == COMMAND_CURSOR_CURVE) {
-                            if(argc > 2) {
-                                NxObject *object2 = (NxObject*)getObject(argv.at(2), false);
-                                if((object2) && (object2->getType() == ObjectsTypeCurve)) {
-                                    NxCurve *curve = (NxCurve*)object2;
-                                    cursor->setCurve(curve);
-                                    cursor->calculate();
-                                }
+                        if(argc > 2) {
+                            NxObject *object2 = (NxObject*)getObject(argv.at(2), false);
+                            if((object2) && (object2->getType() == ObjectsTypeCurve)) {
+                                NxCurve *curve = (NxCurve*)object2;
+                                cursor->setCurve(curve);
+                                cursor->calculate();
                             }
-                            NxCurve *curve = cursor->getCurve();
-                            if((curve) && (needOutput))
-                                return curve->getId();
                         }
+                        NxCurve *curve = cursor->getCurve();
+                        if((curve) && (needOutput))
+                            return curve->getId();
                     }
+                    break;
+                default:
+                    break;
                 }
             }
         }
     }
     return false;
 }
+const QVariant IanniX::executeBatch(const QScriptValue &items, const QString &typeDefault) {
+    NxDocument *document = getWorkingDocument();
+    if((!document) || (!items.isArray()))
+        return QVariant();
+    NxObjectDispatchProperty::source = document->source;
+
+    //A flat array of numbers is read as x y z positions, otherwise as an array of objects
+    quint32 itemsCount = items.property("length").toUInt32();
+    bool itemsArePositions = (itemsCount > 0) && (items.property(0).isNumber());
+    if(itemsArePositions)
+        itemsCount /= 3;
+
+    QVariantList ids;
+    QList<QTreeWidgetItem*> treeItems;
+    QHash<QString, QByteArray> propertyNames;
+    NxObject *object = 0;
+    for(quint32 itemIndex = 0 ; itemIndex < itemsCount ; itemIndex++) {
+        QScriptValue item;
+        QString type = typeDefault;
+        quint16 id = 0;
+        if(!itemsArePositions) {
+            item = items.property(itemIndex);
+            if(!item.isObject())
+                continue;
+            if(item.property("type").isString())
+                type = item.property("type").toString();
+            if(item.property("id").isNumber())
+                id = item.property("id").toUInt16();
+        }
+        if((id == 0) || (document->objects.contains(id)))
+            id = document->nextAvailableId();
+        if(id == 0)
+            break;
+
+        //Objects are attached to the inspector tree once, at the end of the batch
+        type = type.toLower();
+        if(type == "curve")         object = new NxCurve(this,   0);
+        else if(type == "cursor")   object = new NxCursor(this,  0);
+        else                        object = new NxTrigger(this, 0);
+        object->setInitialId(id);
+        object->setText(3, QString::number(id));
+        //Setters are called directly, the properties are flagged as the "add" command path does to be saved, copied and exported
+        object->propertyChanged(COMMAND_ID);
+        object->propertyChanged(COMMAND_POS);
+
+        //Position is set before registration, so that the trigger index is filled only once
+        if(itemsArePositions)
+            object->setPos(NxPoint(items.property(itemIndex*3).toNumber(), items.property(itemIndex*3+1).toNumber(), items.property(itemIndex*3+2).toNumber()));
+        else {
+            QScriptValue itemPos = item.property("pos");
+            if(itemPos.isArray())
+                object->setPos(NxPoint(itemPos.property(0).toNumber(), itemPos.property(1).toNumber(), itemPos.property(2).toNumber()));
+            else if(itemPos.isString())
+                object->setPosStr(itemPos.toString());
+        }
+        QScriptValue itemGroup = item.property("group");
+        if((itemGroup.isString()) || (itemGroup.isNumber())) {
+            object->setGroupId(itemGroup.toString());
+            object->propertyChanged(COMMAND_GROUP);
+        }
+        else
+            object->setGroupId("");
+        //Registered in its group table like the "add" command (ungrouped objects included)
+        setObjectActivity(object, ObjectsActivityInactive);
+
+        //Other properties map to the "set" commands (size is setsize, message is setmessage, etc.)
+        if(!itemsArePositions) {
+            QScriptValueIterator itemProperty(item);
+            while(itemProperty.hasNext()) {
+                itemProperty.next();
+                QString name = itemProperty.name();
+                if((name == "type") || (name == "id") || (name == "pos") || (name == "group"))
+                    continue;
+
+                QScriptValue value = itemProperty.value();
+                if((name == "curve") && (object->getType() == ObjectsTypeCursor)) {
+                    NxObject *curve = document->getObject(value.toUInt16());
+                    if((curve) && (curve->getType() == ObjectsTypeCurve)) {
+                        NxCursor *cursor = (NxCursor*)object;
+                        cursor->setCurve((NxCurve*)curve);
+                        cursor->propertyChanged(COMMAND_CURSOR_CURVE);
+                        cursor->calculate();
+                    }
+                    continue;
+                }
+
+                if(!propertyNames.contains(name))
+                    propertyNames.insert(name, (name.startsWith("set"))?(name.toLower().toUtf8()):(QString("set" + name).toLower().toUtf8()));
+                if(value.isArray()) {
+                    QStringList values;
+                    quint32 valuesCount = value.property("length").toUInt32();
+                    for(quint32 valueIndex = 0 ; valueIndex < valuesCount ; valueIndex++)
+                        values << value.property(valueIndex).toString();
+                    object->dispatchProperty(propertyNames.value(name).constData(), values.join(" "));
+                }
+                else
+                    object->dispatchProperty(propertyNames.value(name).constData(), value.toVariant());
+            }
+        }
+
+        document->insertObject(id, object);
+        document->undoJournal.recordAdd(object);
+        treeItems.append(object);
+        ids.append(id);
+    }
+
+    //Single inspector update for the whole batch
+    inspector->getObjectRootItem()->addChildren(treeItems);
+    if(object)
+        document->setCurrentObject(object);
+    return ids;
+}
 void IanniX::executeAsScript(const QString &script) {
     getCurrentDocument()->scriptEvaluate(script, false);
 }
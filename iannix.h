@@ -27,6 +27,7 @@
 #include <QObject>
 #include <QTimer>
 #include <QTime>
+#include <QElapsedTimer>
 #include <QFileDialog>
 #include <QInputDialog>
 #include <QNetworkAccessManager>
@@ -42,6 +43,9 @@
 #include <QFileOpenEvent>
 #include <QDesktopServices>
 #include <QWindow>
+#include <QThreadPool>
+#include <QtConcurrentMap>
+#include <QScriptValueIterator>
 #include <time.h>
 #include "misc/application.h"
 #include "gui/uimessagebox.h"
@@ -49,6 +53,7 @@
 #include "gui/uiinspector.h"
 #include "gui/uihelp.h"
 #include "messages/messagemanager.h"
+#include "transport/schedulerthread.h"
 #include "interfaces/interfacesyphon.h"
 #include "interfaces/interfacedirect.h"
 #include "interfaces/interfacehttp.h"
@@ -57,18 +62,36 @@
 #include "interfaces/interfaceserial.h"
 #include "interfaces/interfacetcp.h"
 #include "interfaces/interfaceudp.h"
+#include "interfaces/interfaceartnet.h"
 #ifdef WACOM_INSTALLED
 #include "interfaces/extwacommanager.h"
 #endif
 
+//Script commands, resolved once per verb to their argument kind and property name
+enum CommandKind { CommandUnknown = 0, CommandAdd, CommandGlobal, CommandString, CommandValueString, CommandSingle, CommandPoints, CommandActivation, CommandRemove, CommandColorGlobal, CommandColorGlobalHue, CommandTextureGlobal, CommandCursorCurve };
+class CommandEntry {
+public:
+    CommandEntry(const char *_verb = "", CommandKind _kind = CommandUnknown) : verb(_verb), property(_verb), kind(_kind) {}
+public:
+    QString     verb;
+    QByteArray  property;
+    CommandKind kind;
+};
+
 class IanniX : public ApplicationCurrent, public NxObjectDispatchProperty, public MessageDispatcher {
     Q_OBJECT
 
 private:
     QSettings *iniSettings, *globalSettings;
 public:
-    explicit IanniX(const QString &_projectToLoad = "", QObject *parent = 0);
+    explicit IanniX(const QString &_projectToLoad = "", bool _offline = false, QObject *parent = 0);
     void readyToStart();
+    bool renderOffline(const QString &outputFilename, qreal duration, qreal step);
+    bool replayOffline(const QString &journalFilename, qreal speed);
+private:
+    bool offline;
+    MessageJournal *messageJournal;
+public:
     inline void dispatchProperty(const QString &_property, const QVariant &value)  {    dispatchProperty(qPrintable(_property), value); }
     inline const QVariant getProperty(const QString &_property) const              {    return getProperty(qPrintable(_property));      }
     inline void dispatchProperty(const char *_property, const QVariant &value) {
@@ -102,6 +125,9 @@ public:
     void setObjectActivity(void *_object, quint8 activeOld);
     void setObjectGroupId(void *_object, const QString & groupIdOld);
     void setObjectId(void *_object, quint16 idOld);
+    void setObjectPos(void *_object);
+    void setObjectTrigEnd(void *_object, qreal delay);
+    void journalObjectProperty(void *_object, const char *_property);
     void removeObject(NxObject *object);
     quint16 getCount(qint8 objectType = -1);
     void* getObjectById(quint16 id) {
@@ -143,6 +169,8 @@ private:
 public slots:
     const QVariant execute(const MessageIncomming & command, bool createNewObjectIfExists = false, bool needOutput = false);
     const QVariant execute(const QString & command, ExecuteSource source, bool createNewObjectIfExists = false, bool needOutput = false);
+    bool execute(const QString & commande, const QVariantList & values);
+    const QVariant executeBatch(const QScriptValue &items, const QString &typeDefault);
     void executeAsScript(const QString &script);
     inline QString argvFullString(const QString &command, const QStringList &argv, quint16 index) const {
         if(index >= 1)   return command.mid(command.indexOf(argv.at(index), command.indexOf(argv.at(index-1))+argv.at(index-1).length())).trimmed();
@@ -156,17 +184,39 @@ public slots:
     void openMessageEditor();
     void send(const Message &message, QStringList *sentMessage = 0);
     QMainWindow* getMainWindow()        { return view; }
+    QTreeWidgetItem* getObjectRootItem() { return inspector->getObjectRootItem(); }
     UiRenderPreview* getRenderPreview() { return view->getRenderPreview(); }
     bool getPerformancePreview()        { return view->getPerformancePreview(); }
 
 
+    //COMMAND TABLE
+private:
+    static QHash<QString, CommandEntry> commands;
+    static const CommandEntry commandUnknown;
+    static void registerCommands();
+public:
+    static inline const CommandEntry & getCommand(const QString &verb) {
+        QHash<QString, CommandEntry>::const_iterator command = commands.constFind(verb);
+        if(command == commands.constEnd())
+            command = commands.constFind(verb.toLower());
+        if(command == commands.constEnd())
+            return commandUnknown;
+        return command.value();
+    }
+    void benchmarkCommands(const QString &filename, quint16 passes = 1);
+
+
     //EXTERNAL INTERFACES
 private:
 #ifdef WACOM_INSTALLED
     ExtWacomManager  *wacom;
 #endif
 public:
-    InterfaceOsc *interfaceOsc;
+    InterfaceOsc    *interfaceOsc;
+    InterfaceMidi   *interfaceMidi;
+    InterfaceHttp   *interfaceHttp;
+    InterfaceTcp    *interfaceTcp;
+    InterfaceArtnet *interfaceArtnet;
     bool projectIsLoaded;
     QString projectToLoad;
     void loadProject(const QString & projectFile = "");
@@ -175,7 +225,17 @@ public:
 private:
     UiRender *render;
     QTimer *timer;
+    SchedulerThread *schedulerThread;
+    QElapsedTimer schedulerClock;
+    qint64 schedulerClockOld;
     int timerTime, timerPerf;
+    QVector<NxCursor*> schedulerCursors;
+    QVector<const NxGroup*> schedulerCursorGroups;
+    QVector< QVector<NxCursor*> > schedulerCursorJobs;
+    static const int schedulerParallelThreshold = 64;
+    QList< QPair<QPointer<NxTrigger>, qreal> > schedulerTrigEnds;
+    qreal schedulerClockTime;
+    qint64 schedulerClockOrigin;
 private:
     SchedulerActivity schedulerActivity;
 public:
@@ -187,6 +247,11 @@ private slots:
     void timerTick(bool force);
     void timerTick(qreal delta);
     void timerTrig(void *object, bool force = false);
+    void schedulerTick(qreal delta, qreal interval);
+    void schedulerClockTick(qreal delta);
+    void measureSchedulerJitter(qreal interval);
+    void setSchedulerThread(bool);
+    void refreshWindowIcon();
 
 
     //USER INTERFACE
@@ -205,7 +270,7 @@ private slots:
 public:
     bool forceUpdate, forbidUpdate;
     void checkForUpdates();
-    const QString serialize() const;
+    const QString serialize(bool withObjects = true) const;
 public slots:
     void forceGoto(qreal, bool midiSync = true);
     void forceSchedulerTimer(qreal);
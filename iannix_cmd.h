@@ -133,5 +133,10 @@
 #define COMMAND_SLEEP                       "sleep"
 #define COMMAND_VIEWPORT                    "viewport"
 #define COMMAND_SNAPSHOT                    "snapshot"
+#define COMMAND_JOURNAL                     "journal"
+#define COMMAND_MIDICLOCK                   "midiclock"
+#define COMMAND_HTTPSINK                    "httpsink"
+#define COMMAND_TCPSOAK                     "tcpsoak"
+#define COMMAND_ARTNETSINK                  "artnetsink"
 
 #endif // IANNIX_CMD_H
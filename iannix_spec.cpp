@@ -26,10 +26,19 @@
 ExecuteSource NxObjectDispatchProperty::source = ExecuteSourceGui;
 
 void NxObjectDispatchProperty::propertyChanged(const char *_property) {
-    QString property = _property;
-    if(!propertiesToSerialize[source].contains(property))
-        propertiesToSerialize[source].append(property);
-    if(!propertiesToSerialize[ExecuteSourceCopyPaste].contains(property))
-        propertiesToSerialize[ExecuteSourceCopyPaste].append(property);
+    //Compared in place, the name is only copied the first time it is seen
+    QStringList &properties = propertiesToSerialize[source];
+    if(!containsProperty(properties, _property))
+        properties.append(QString::fromLatin1(_property));
+    QStringList &propertiesCopyPaste = propertiesToSerialize[ExecuteSourceCopyPaste];
+    if(!containsProperty(propertiesCopyPaste, _property))
+        propertiesCopyPaste.append(QString::fromLatin1(_property));
+}
+bool NxObjectDispatchProperty::containsProperty(const QStringList &properties, const char *_property) {
+    QLatin1String property(_property);
+    foreach(const QString &item, properties)
+        if(item == property)
+            return true;
+    return false;
 }
 
@@ -42,6 +42,10 @@ public:
 
 public:
     void propertyChanged(const char *_property);
+    static bool containsProperty(const QStringList &properties, const char *_property);
+    inline const QStringList getPropertiesToSerialize(ExecuteSource _source) const {
+        return propertiesToSerialize.value(_source);
+    }
 
 public:
     virtual quint8         getType() const    { return 0;         }
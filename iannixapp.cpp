@@ -27,6 +27,9 @@
 #include "misc/help.h"
 #include "misc/options.h"
 #include "gui/uisplashscreen.h"
+#ifdef IANNIX_TESTS
+#include "tests/iannixtests.h"
+#endif
 
 
 int main(int argc, char *argv[]) {
@@ -63,6 +66,11 @@ int main(int argc, char *argv[]) {
     appName += "Linux";
     qDebug("Command line syntax : ./IanniX <file path>");
 #endif
+    qDebug("Offline render      : <file path> -render <output file> [-duration <seconds>] [-step <milliseconds>]");
+    qDebug("                      (no window is shown, but Qt still needs a display or QT_QPA_PLATFORM=offscreen)");
+    qDebug("Message replay      : -replay <journal file> [-speed <factor, 0 = max>]");
+    qDebug("Tests               : -test (qmake CONFIG+=iannix_tests)");
+    qDebug("Benchmarks          : -benchmark (qmake CONFIG+=iannix_tests)");
 
     QCoreApplication::setApplicationName   (appName.trimmed());
     QCoreApplication::setApplicationVersion(appVersion.trimmed());
@@ -70,6 +78,8 @@ int main(int argc, char *argv[]) {
     QCoreApplication::setOrganizationDomain("iannix");
 
     iannixApp.launch(argc, argv);
+    if(iannixApp.offlineExitCode >= 0)
+        return iannixApp.offlineExitCode;
 
     return iannixApp.exec();
 }
@@ -79,11 +89,30 @@ int main(int argc, char *argv[]) {
 IanniXApp::IanniXApp(int &argc, char **argv) :
     QApplication(argc, argv) {
     iannix = 0;
+    offlineExitCode = -1;
 }
 
 void IanniXApp::launch(int &argc, char **argv) {
+    //Offline render options
+    QString offlineOutput;
+    qreal offlineDuration = 60, offlineStep = 0;
+    QString replayJournal;
+    qreal replaySpeed = 1;
+    bool tests = false, benchmarks = false;
+    for(quint16 i = 1 ; i < argc ; i++) {
+        QString argument = argv[i];
+        if((argument == "-render") && (i+1 < argc))         offlineOutput   = argv[++i];
+        else if((argument == "-duration") && (i+1 < argc))  offlineDuration = QString(argv[++i]).toDouble();
+        else if((argument == "-step") && (i+1 < argc))      offlineStep     = QString(argv[++i]).toDouble() / 1000.;
+        else if((argument == "-replay") && (i+1 < argc))    replayJournal   = argv[++i];
+        else if((argument == "-speed") && (i+1 < argc))     replaySpeed     = QString(argv[++i]).toDouble();
+        else if(argument == "-test")                        tests           = true;
+        else if(argument == "-benchmark")                   benchmarks      = true;
+    }
+
     //Display splash
-    Application::splash = new UiSplashScreen(QPixmap(":/general/res_splash.png"));
+    if((offlineOutput.isEmpty()) && (replayJournal.isEmpty()) && (!tests) && (!benchmarks))
+        Application::splash = new UiSplashScreen(QPixmap(":/general/res_splash.png"));
 
     //Start
     setHelp();
@@ -184,7 +213,33 @@ void IanniXApp::launch(int &argc, char **argv) {
         }
     }
 
-    if(project.exists()) {
+    if((tests) || (benchmarks)) {
+#ifdef IANNIX_TESTS
+        iannix = new IanniX("", true);
+        if(tests)   offlineExitCode = (IanniXTests::run(iannix))?(1):(0);
+        else        offlineExitCode = (IanniXTests::benchmark(iannix))?(1):(0);
+#else
+        qDebug("[TESTS] Tests are not built, run qmake CONFIG+=iannix_tests");
+        offlineExitCode = 1;
+#endif
+    }
+    else if(!replayJournal.isEmpty()) {
+        qDebug("Replaying journal %s", qPrintable(replayJournal));
+        iannix = new IanniX("", true);
+        offlineExitCode = (iannix->replayOffline(replayJournal, replaySpeed))?(0):(1);
+    }
+    else if(!offlineOutput.isEmpty()) {
+        if(project.exists()) {
+            qDebug("Rendering project %s offline", qPrintable(project.absoluteFilePath()));
+            iannix = new IanniX(project.absoluteFilePath(), true);
+            offlineExitCode = (iannix->renderOffline(offlineOutput, offlineDuration, offlineStep))?(0):(1);
+        }
+        else {
+            qDebug("[OFFLINE] No score to render");
+            offlineExitCode = 1;
+        }
+    }
+    else if(project.exists()) {
         qDebug("Loading project %s", qPrintable(project.absoluteFilePath()));
         iannix = new IanniX(project.absoluteFilePath());
     }
@@ -218,6 +273,7 @@ void IanniXApp::setHelp() {
     Help::categories["protocols"].infos << HelpInfo(QString("http"),               tr("HTTP request to a webpage/webservice (GET)"));
     Help::categories["protocols"].infos << HelpInfo(QString("udp"),                tr("Raw UDP message (compatible with PureData)"));
     Help::categories["protocols"].infos << HelpInfo(QString("tcp"),                tr("XML over TCP message (compatible with Flash/Director)"));
+    Help::categories["protocols"].infos << HelpInfo(QString("artnet"),             tr("Art-Net DMX message (universe/channel, values from 0 to 255)"));
 
     Help::categories["hostIp"].category = tr("Messages IP");
     Help::categories["hostIp"].infos << HelpInfo(QString("ip_out"),                tr("Destination is the default IP set in \"Network\" tab"));
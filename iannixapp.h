@@ -35,6 +35,7 @@ private:
     QFileInfo project;
 
 public:
+    int offlineExitCode;
     explicit IanniXApp(int &argc, char **argv);
     void launch(int &argc, char **argv);
     void setHelp();
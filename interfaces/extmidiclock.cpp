@@ -0,0 +1,173 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "extmidiclock.h"
+#include "interfacemidi.h"
+
+ExtMidiClock::ExtMidiClock() {
+    loopB = loopC = 0;
+    tickPeriod = tickRaw = tickLast = tickNext = 0;
+    positionLast = positionNext = 0;
+    tickCount = 0;
+    running = false;
+    jitterSum = jitterMax = driftSum = driftMax = 0;
+    jitterCount = driftCount = 0;
+    clock.start();
+}
+
+//Called by the MIDI thread for each tick, unit is the score time covered by a tick
+void ExtMidiClock::tick(qreal unit) {
+    double time = now();
+    QMutexLocker locker(&mutex);
+    running = true;
+    if((tickCount == 0) || ((time - tickRaw) > MIDICLOCK_TIMEOUT)) {
+        //First tick (or the clock resumed) : nothing to measure yet
+        tickCount = 1;
+        tickLast = tickNext = time;
+    }
+    else if(tickCount == 1) {
+        //Second tick : the loop starts from the measured period
+        tickPeriod = time - tickRaw;
+        double omega = 2 * M_PI * MIDICLOCK_BANDWIDTH * tickPeriod;
+        loopB = M_SQRT2 * omega;
+        loopC = omega * omega;
+        tickLast = time;
+        tickNext = time + tickPeriod;
+        tickCount++;
+    }
+    else {
+        //Second order loop : the prediction error corrects both phase and period
+        double error = time - tickNext;
+        tickLast    = tickNext;
+        tickNext   += loopB * error + tickPeriod;
+        tickPeriod += loopC * error;
+        tickCount++;
+        jitterSum += error * error;
+        jitterMax  = qMax(jitterMax, qAbs(error));
+        jitterCount++;
+    }
+    tickRaw = time;
+    positionLast  = positionNext;
+    positionNext += unit;
+}
+
+//Position of the next tick (song position pointer, start)
+void ExtMidiClock::reset(qreal position) {
+    QMutexLocker locker(&mutex);
+    positionLast = positionNext = position;
+}
+//Position of the last tick (full timecode)
+void ExtMidiClock::align(qreal position) {
+    QMutexLocker locker(&mutex);
+    positionNext = position + (positionNext - positionLast);
+    positionLast = position;
+}
+void ExtMidiClock::stop() {
+    QMutexLocker locker(&mutex);
+    running = false;
+    tickCount = 0;
+}
+
+bool ExtMidiClock::isLocked() const {
+    double time = now();
+    QMutexLocker locker(&mutex);
+    return isLockedUnsafe(time);
+}
+
+//Called by the scheduler before advancing time by delta : tempo is the master speed, speed also absorbs the phase error
+ExtMidiClock::FollowMode ExtMidiClock::follow(qreal timeLocal, qreal delta, qreal *tempo, qreal *speed, qreal *target) {
+    double time = now();
+    QMutexLocker locker(&mutex);
+    if((!isLockedUnsafe(time)) || (tickPeriod <= 0))
+        return FollowNone;
+
+    *tempo  = (positionNext - positionLast) / tickPeriod;
+    *target = positionAt(time);
+    qreal error = *target - (timeLocal + delta * *tempo);
+    driftSum += qAbs(error);
+    driftMax  = qMax(driftMax, (double)qAbs(error));
+    driftCount++;
+    if(qAbs(error) > MIDICLOCK_JUMP)
+        return FollowJump;
+    *speed = *tempo + qBound(-0.5 * *tempo, error / MIDICLOCK_CATCHUP, 0.5 * *tempo);
+    return FollowSmooth;
+}
+
+//Summary since the previous report
+const QString ExtMidiClock::report(qreal bpm) {
+    double time = now();
+    QMutexLocker locker(&mutex);
+    QString retour;
+    if(!isLockedUnsafe(time))
+        retour = QObject::tr("No clock");
+    else
+        retour = QObject::tr("%1 BPM - jitter %2 ms (max %3) - drift %4 ms (max %5)")
+                .arg(bpm * (positionNext - positionLast) / tickPeriod, 0, 'f', 2)
+                .arg((jitterCount)?(1000. * qSqrt(jitterSum / jitterCount)):(0.), 0, 'f', 3).arg(1000. * jitterMax, 0, 'f', 3)
+                .arg((driftCount )?(1000. * driftSum / driftCount):(0.),          0, 'f', 3).arg(1000. * driftMax,  0, 'f', 3);
+    jitterSum = jitterMax = driftSum = driftMax = 0;
+    jitterCount = driftCount = 0;
+    return retour;
+}
+
+
+
+ExtMidiClockGenerator::ExtMidiClockGenerator(InterfaceMidi *_midi, QObject *parent) :
+    QThread(parent) {
+    midi    = _midi;
+    bpm     = 120;
+    jitter  = 0;
+    running = false;
+}
+
+void ExtMidiClockGenerator::start(qreal _bpm, qreal _jitter) {
+    stop();
+    bpm     = _bpm;
+    jitter  = _jitter;
+    running = true;
+    QThread::start(QThread::TimeCriticalPriority);
+}
+void ExtMidiClockGenerator::stop() {
+    if(!isRunning())
+        return;
+    running = false;
+    wait();
+}
+
+void ExtMidiClockGenerator::run() {
+    //Behaves like a sequencer : position, start, then ticks at 24 ppqn (jitter in ms, uniform)
+    qreal period = 60. / (bpm * 24.);
+    QElapsedTimer timer;
+    timer.start();
+    midi->receivedMidiRealtime(MIDI_SPP, 0, 0);
+    midi->receivedMidiRealtime(MIDI_START, 0, 0);
+    for(quint32 tickIndex = 0 ; running ; tickIndex++) {
+        qreal due  = tickIndex * period + jitter * (2. * qrand() / RAND_MAX - 1.) / 1000.;
+        qreal wait = due - timer.nsecsElapsed() / 1000000000.;
+        if(wait > 0)
+            usleep(wait * 1000000);
+        midi->receivedMidiRealtime(MIDI_CLOCK, 0, 0);
+    }
+    midi->receivedMidiRealtime(MIDI_STOP, 0, 0);
+}
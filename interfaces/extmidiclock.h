@@ -0,0 +1,104 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef EXTMIDICLOCK_H
+#define EXTMIDICLOCK_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QString>
+#include <qmath.h>
+
+#define MIDICLOCK_BANDWIDTH     0.5     //Hz, bandwidth of the loop filter
+#define MIDICLOCK_LOCK_TICKS    24      //Ticks before the tempo is trusted
+#define MIDICLOCK_TIMEOUT       0.25    //s without tick before the loop is released
+#define MIDICLOCK_CATCHUP       0.5     //s to absorb a phase error
+#define MIDICLOCK_JUMP          0.25    //s of phase error above which IanniX jumps instead
+
+class InterfaceMidi;
+
+//Phase-locked loop on incoming clock ticks (24 ppqn MIDI clock or MTC quarter frames).
+//Ticks are timestamped by the MIDI thread, follow() is read by the scheduler.
+class ExtMidiClock {
+public:
+    enum FollowMode { FollowNone, FollowSmooth, FollowJump };
+
+public:
+    ExtMidiClock();
+
+private:
+    mutable QMutex mutex;
+    QElapsedTimer clock;
+    double loopB, loopC;            //Loop filter coefficients
+    double tickPeriod;              //Filtered period (s)
+    double tickRaw;                 //Unfiltered time of the last tick (s)
+    double tickLast, tickNext;      //Filtered time of the last tick, predicted time of the next one (s)
+    qreal  positionLast, positionNext;
+    quint32 tickCount;
+    bool   running;
+    //Report
+    double jitterSum, jitterMax, driftSum, driftMax;
+    quint32 jitterCount, driftCount;
+
+public:
+    void tick(qreal unit);
+    void reset(qreal position);
+    void align(qreal position);
+    void stop();
+    FollowMode follow(qreal timeLocal, qreal delta, qreal *tempo, qreal *speed, qreal *target);
+    bool isLocked() const;
+    const QString report(qreal bpm);
+private:
+    inline double now() const { return clock.nsecsElapsed() / 1000000000.; }
+    inline bool isLockedUnsafe(double time) const { return (running) && (tickCount >= MIDICLOCK_LOCK_TICKS) && ((time - tickLast) < MIDICLOCK_TIMEOUT); }
+    inline qreal positionAt(double time) const {
+        qreal phase = (tickNext > tickLast)?(qBound(0., (time - tickLast) / (tickNext - tickLast), 2.)):(0.);
+        return positionLast + phase * (positionNext - positionLast);
+    }
+};
+
+
+//Synthetic 24 ppqn clock with optional jitter, to test the slave mode without hardware
+class ExtMidiClockGenerator : public QThread {
+    Q_OBJECT
+
+public:
+    explicit ExtMidiClockGenerator(InterfaceMidi *_midi, QObject *parent = 0);
+
+private:
+    InterfaceMidi *midi;
+    qreal bpm, jitter;
+    volatile bool running;
+
+public:
+    void start(qreal _bpm, qreal _jitter);
+    void stop();
+protected:
+    void run();
+};
+
+#endif // EXTMIDICLOCK_H
@@ -0,0 +1,186 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "interfaceartnet.h"
+#include "ui_interfaceartnet.h"
+
+InterfaceArtnet::InterfaceArtnet(QWidget *parent) :
+    NetworkInterface(parent),
+    ui(new Ui::InterfaceArtnet) {
+    ui->setupUi(this);
+    socket = new QUdpSocket(this);
+    socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+    artnetSink = new InterfaceArtnetSink(this);
+    bundleOpen = false;
+    keepAlive = 0;
+    statMessages = statPackets = 0;
+
+    //Interfaces link
+    enable.setAction(ui->enable, "interfaceArtnetEnable");
+
+    //Output statistics and keep-alive
+    startTimer(1000);
+}
+
+InterfaceArtnetUniverse::InterfaceArtnetUniverse(const QHostAddress &_host, quint16 _port, quint16 _universe) {
+    host     = _host;
+    port     = _port;
+    universe = _universe;
+    length   = 0;
+    sequence = 0;
+    dirty    = false;
+
+    //Constant part of the ArtDmx header
+    packet.fill(0, ARTNETDMX_HEADER_LENGTH + ARTNET_DMX_LENGTH);
+    char *header = packet.data();
+    qstrcpy(header, "Art-Net");
+    header[8]  = ARTNETDMX_OPCODE & 0xFF;
+    header[9]  = ARTNETDMX_OPCODE >> 8;
+    header[10] = 0;
+    header[11] = ARTNETDMX_PROTOCOL;
+    header[14] = universe & 0xFF;
+    header[15] = (universe >> 8) & 0x7F;
+}
+
+
+bool InterfaceArtnet::send(const Message &message, QStringList *messageSent) {
+    if(!enable)
+        return false;
+
+    //Universe of the destination (Art-Net is IPv4 only)
+    QMutexLocker locker(&universesMutex);
+    quint64 key = ((quint64)message.getHost().toIPv4Address() << 32) | ((quint64)message.getPort() << 16) | message.getArtnetUniverse();
+    InterfaceArtnetUniverse *universe = universes.value(key, 0);
+    if(!universe) {
+        universe = new InterfaceArtnetUniverse(message.getHost(), message.getPort(), message.getArtnetUniverse());
+        universes.insert(key, universe);
+    }
+
+    //Values are written on consecutive channels, from the channel of the destination
+    const QList<qreal> &values = message.getValues();
+    char *data = universe->packet.data() + ARTNETDMX_HEADER_LENGTH;
+    quint16 channel = message.getArtnetChannel() - 1;
+    for(quint16 valueIndex = 0 ; (valueIndex < values.count()) && (channel < ARTNET_DMX_LENGTH) ; valueIndex++, channel++)
+        data[channel] = qBound(0, qRound(values.at(valueIndex)), 255);
+    universe->length = qMax(universe->length, channel);
+    universe->dirty = true;
+    statMessages++;
+
+    //Outside of a scheduler tick, no bundle will be closed
+    if(!bundleOpen)
+        flush();
+    locker.unlock();
+
+    //Log in console
+    MessageManager::logSend(message, messageSent);
+
+    return true;
+}
+void InterfaceArtnet::networkBundle(bool open) {
+    QMutexLocker locker(&universesMutex);
+    bundleOpen = open;
+    if(!open)
+        flush();
+}
+//Called with the universes locked
+void InterfaceArtnet::flush() {
+    foreach(InterfaceArtnetUniverse *universe, universes) {
+        if(!universe->dirty)
+            continue;
+
+        //DMX length must be even, between 2 and 512 ; sequence cycles from 1 to 255 (0 disables reordering)
+        quint16 length = qMin(qMax(universe->length + (universe->length % 2), 2), (int)ARTNET_DMX_LENGTH);
+        universe->sequence = (universe->sequence % 255) + 1;
+        char *header = universe->packet.data();
+        header[12] = universe->sequence;
+        header[16] = length >> 8;
+        header[17] = length & 0xFF;
+        socket->writeDatagram(universe->packet.constData(), ARTNETDMX_HEADER_LENGTH + length, universe->host, universe->port);
+        universe->dirty = false;
+        statPackets++;
+    }
+}
+
+void InterfaceArtnet::timerEvent(QTimerEvent *) {
+    //Receivers fall back to their failsafe state without data : frames are sent again regularly
+    QMutexLocker locker(&universesMutex);
+    if((++keepAlive >= ARTNETDMX_KEEPALIVE) && (!bundleOpen) && (enable)) {
+        keepAlive = 0;
+        foreach(InterfaceArtnetUniverse *universe, universes)
+            universe->dirty = true;
+        flush();
+    }
+
+    QString report = tr("Output: %1 messages in %2 packets (%3 universes)").arg(statMessages).arg(statPackets).arg(universes.count());
+    statMessages = statPackets = 0;
+    locker.unlock();
+    if(artnetSink->state() == QAbstractSocket::BoundState)
+        report += "\n" + tr("Sink: %1").arg(artnetSink->report());
+    ui->outputStats->setText(report);
+}
+
+InterfaceArtnet::~InterfaceArtnet() {
+    qDeleteAll(universes);
+    delete ui;
+}
+
+
+
+//Throughput sink
+InterfaceArtnetSink::InterfaceArtnetSink(QObject *parent) :
+    QUdpSocket(parent) {
+    statPackets = statGaps = 0;
+    connect(this, SIGNAL(readyRead()), SLOT(readPackets()));
+}
+bool InterfaceArtnet::sinkChanged(quint16 port) {
+    artnetSink->close();
+    if(port == 0)
+        return true;
+    bool ok = artnetSink->bind(QHostAddress::Any, port, QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint);
+    qDebug("[Art-Net] Sink %s on port %d", (ok)?("listening"):("can't listen"), port);
+    return ok;
+}
+const QString InterfaceArtnetSink::report() {
+    QString retour = tr("%1 packets on %2 universes, %3 sequence gaps").arg(statPackets).arg(universes.count()).arg(statGaps);
+    universes.clear();
+    statPackets = statGaps = 0;
+    return retour;
+}
+void InterfaceArtnetSink::readPackets() {
+    while(hasPendingDatagrams()) {
+        qint64 size = readDatagram(buffer, sizeof(buffer));
+        if((size < ARTNETDMX_HEADER_LENGTH) || (qstrcmp(buffer, "Art-Net") != 0) || ((quint8)buffer[8] != (ARTNETDMX_OPCODE & 0xFF)) || ((quint8)buffer[9] != (ARTNETDMX_OPCODE >> 8)))
+            continue;
+
+        //Packets lost or reordered show up as a break in the sequence of their universe
+        quint16 universe = (quint8)buffer[14] | (((quint8)buffer[15] & 0x7F) << 8);
+        quint8 sequence = buffer[12];
+        quint8 &sequenceLast = sequences[universe];
+        if((sequence) && (sequenceLast) && (sequence != (sequenceLast % 255) + 1))
+            statGaps++;
+        sequenceLast = sequence;
+        universes.insert(universe);
+        statPackets++;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef INTERFACEARTNET_H
+#define INTERFACEARTNET_H
+
+#include <QWidget>
+#include <QUdpSocket>
+#include <QSet>
+#include <QMutex>
+#include "misc/options.h"
+#include "messages/messagemanager.h"
+#include "artnet/common.h"
+
+#define ARTNETDMX_HEADER_LENGTH     18          //ArtDmx header before the DMX data
+#define ARTNETDMX_OPCODE            0x5000      //OpDmx (sent little-endian)
+#define ARTNETDMX_PROTOCOL          14          //Art-Net protocol revision (sent big-endian)
+#define ARTNETDMX_KEEPALIVE         2           //Seconds after which every universe is sent again
+
+namespace Ui {
+class InterfaceArtnet;
+}
+
+//A DMX universe of a destination : the whole frame is kept because an ArtDmx packet always carries it
+class InterfaceArtnetUniverse {
+public:
+    InterfaceArtnetUniverse(const QHostAddress &_host, quint16 _port, quint16 _universe);
+
+public:
+    QHostAddress host;
+    quint16 port, universe, length;
+    quint8  sequence;
+    bool    dirty;
+    QByteArray packet;
+};
+
+//Local Art-Net receiver that only counts ArtDmx packets, as a target for throughput tests
+class InterfaceArtnetSink : public QUdpSocket {
+    Q_OBJECT
+
+public:
+    InterfaceArtnetSink(QObject *parent);
+
+private:
+    char buffer[ARTNETDMX_HEADER_LENGTH + ARTNET_DMX_LENGTH];
+    QHash<quint16, quint8> sequences;
+    QSet<quint16> universes;
+    quint32 statPackets, statGaps;
+public:
+    const QString report();
+private slots:
+    void readPackets();
+};
+
+
+
+class InterfaceArtnet : public NetworkInterface {
+    Q_OBJECT
+
+public:
+    explicit InterfaceArtnet(QWidget *parent = 0);
+    ~InterfaceArtnet();
+
+private:
+    UiBool enable;
+    QUdpSocket *socket;
+    InterfaceArtnetSink *artnetSink;
+public:
+    bool sinkChanged(quint16 port);
+protected:
+    void timerEvent(QTimerEvent *);
+
+    //Channel writes are accumulated per universe during a scheduler tick, then one packet is sent per dirty universe
+private:
+    QMutex universesMutex;
+    QHash<quint64, InterfaceArtnetUniverse*> universes;
+    bool bundleOpen;
+    quint16 keepAlive;
+    quint32 statMessages, statPackets;
+private:
+    void flush();
+
+public:
+    bool send(const Message &message, QStringList *messageSent = 0);
+    void networkBundle(bool open);
+
+private:
+    Ui::InterfaceArtnet *ui;
+};
+
+#endif // INTERFACEARTNET_H
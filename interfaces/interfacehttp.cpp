@@ -35,6 +35,7 @@ InterfaceHttp::InterfaceHttp(QWidget *parent) :
     httpServer = new InterfaceHttpServer(this);
     connect(httpServer, SIGNAL(parseRequest(QNetworkReply*)), SLOT(parseRequest(QNetworkReply*)));
     connect(httpServer, SIGNAL(parseSocket(QTcpSocket*)),     SLOT(parseSocket(QTcpSocket*)));
+    httpSink = new InterfaceHttpSink(this);
 
     //Websockets server
     webSocketServer = new WebSocketServer(this);
@@ -55,12 +56,22 @@ InterfaceHttp::InterfaceHttp(QWidget *parent) :
     webSocketsPort.setAction(ui->portWebSockets, "interfaceHttpWebSocketsPort");
     connect(&webSocketsPort, SIGNAL(triggered(qreal)), SLOT(portWebSocketsChanged()));
     webSocketsPort = 1237;
+    httpServer->coalesce   .setAction(ui->coalesce,    "interfaceHttpCoalesce");
+    httpServer->maxInFlight.setAction(ui->maxInFlight, "interfaceHttpMaxInFlight");
+    httpServer->maxInFlight = 6;
+
+    //Output statistics
+    startTimer(1000);
 }
 
 InterfaceHttpServer::InterfaceHttpServer(QObject *parent) :
     QTcpServer(parent) {
     http = new QNetworkAccessManager(this);
     connect(http, SIGNAL(finished(QNetworkReply*)), SLOT(parse(QNetworkReply*)));
+    flushPending.fetchAndStoreOrdered(0);
+    bundleOpen   = false;
+    inFlight     = 0;
+    statMessages = statRequests = statDropped = 0;
 }
 
 
@@ -131,19 +142,113 @@ bool InterfaceHttp::send(const Message &message, QStringList *messageSent) {
 
     return httpServer->send(message, messageSent);
 }
+void InterfaceHttp::networkBundle(bool open) {
+    if(enable)
+        httpServer->networkBundle(open);
+}
 bool InterfaceHttpServer::send(const Message &message, QStringList *messageSent) {
-    //Send request
-    http->get(QNetworkRequest(message.getUrlMessage()));
+    //Queue request (sent at the end of the tick, or right away outside of a tick)
+    queueMutex.lock();
+    if(queue.count() >= HTTP_QUEUE_MAX) {
+        statDropped++;
+        queueMutex.unlock();
+        return false;
+    }
+    queue.append(message.getUrlMessage());
+    statMessages++;
+    queueMutex.unlock();
+    if(!bundleOpen)
+        requestFlush();
 
     //Log in console
     MessageManager::logSend(message, messageSent);
 
     return true;
 }
+void InterfaceHttpServer::networkBundle(bool open) {
+    bundleOpen = open;
+    if(!open)
+        requestFlush();
+}
+void InterfaceHttpServer::requestFlush() {
+    //QNetworkAccessManager belongs to the GUI thread
+    if(flushPending.testAndSetOrdered(0, 1))
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+}
+QNetworkRequest InterfaceHttpServer::request(const QUrl &url) const {
+    QNetworkRequest request(url);
+    request.setRawHeader("Connection", "keep-alive");
+    request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, true);
+    return request;
+}
+void InterfaceHttpServer::flush() {
+    flushPending.fetchAndStoreOrdered(0);
+    QMutexLocker locker(&queueMutex);
+    quint16 inFlightMax = qMax(1, qRound(maxInFlight.val()));
+
+    //One request per message
+    if(!coalesce) {
+        while((queue.count()) && (inFlight < inFlightMax)) {
+            http->get(request(queue.takeFirst()));
+            inFlight++;
+            statRequests++;
+        }
+        return;
+    }
+
+    //One POST per endpoint, with the queries of all its messages in the body (one per line)
+    QStringList endpoints;
+    QHash<QString, QList<QUrl> > endpointUrls;
+    foreach(const QUrl &url, queue) {
+        QString endpoint = url.toString(QUrl::RemoveQuery);
+        if(!endpointUrls.contains(endpoint))
+            endpoints.append(endpoint);
+        endpointUrls[endpoint].append(url);
+    }
+    queue.clear();
+    foreach(const QString &endpoint, endpoints) {
+        const QList<QUrl> &urls = endpointUrls.value(endpoint);
+        if(inFlight >= inFlightMax) {
+            queue.append(urls);
+            continue;
+        }
+        QByteArray body;
+        foreach(const QUrl &url, urls) {
+#ifdef QT4
+            body += url.encodedQuery() + "\n";
+#else
+            body += url.query(QUrl::FullyEncoded).toLatin1() + "\n";
+#endif
+        }
+        QNetworkRequest postRequest = request(QUrl(endpoint));
+        postRequest.setHeader(QNetworkRequest::ContentTypeHeader, "text/plain");
+        postRequest.setRawHeader("X-IanniX-Messages", QByteArray::number(urls.count()));
+        http->post(postRequest, body);
+        inFlight++;
+        statRequests++;
+    }
+}
+const QString InterfaceHttpServer::report() {
+    QMutexLocker locker(&queueMutex);
+    QString retour = tr("%1 messages in %2 requests - %3 queued - %4 dropped - %5 in flight").arg(statMessages).arg(statRequests).arg(queue.count()).arg(statDropped).arg(inFlight);
+    statMessages = statRequests = statDropped = 0;
+    return retour;
+}
 
 
 void InterfaceHttpServer::parse(QNetworkReply *reply) {
+    queueMutex.lock();
+    if(inFlight)
+        inFlight--;
+    bool hasQueue = queue.count();
+    queueMutex.unlock();
+
     emit(parseRequest(reply));
+    reply->deleteLater();
+
+    //A connection is free again
+    if(hasQueue)
+        flush();
 }
 void InterfaceHttp::parseRequest(QNetworkReply *reply) {
     if(!enable)
@@ -273,3 +378,79 @@ void InterfaceHttpServer::discardClient() {
 InterfaceHttp::~InterfaceHttp() {
     delete ui;
 }
+
+
+
+//Throughput sink
+InterfaceHttpSink::InterfaceHttpSink(QObject *parent) :
+    QTcpServer(parent) {
+    statMessages = statRequests = 0;
+}
+bool InterfaceHttp::sinkChanged(quint16 port) {
+    httpSink->close();
+    if(port == 0)
+        return true;
+    bool ok = httpSink->listen(QHostAddress::Any, port);
+    qDebug("[HTTP] Sink %s on port %d", (ok)?("listening"):("can't listen"), port);
+    return ok;
+}
+void InterfaceHttp::timerEvent(QTimerEvent *) {
+    stats = tr("Output: %1").arg(httpServer->report());
+    if(httpSink->isListening())
+        stats += "\n" + tr("Sink: %1").arg(httpSink->report());
+    ui->outputStats->setText(stats);
+}
+const QString InterfaceHttpSink::report() {
+    QString retour = tr("%1 messages in %2 requests").arg(statMessages).arg(statRequests);
+    statMessages = statRequests = 0;
+    return retour;
+}
+#ifdef QT4
+void InterfaceHttpSink::incomingConnection(int handle) {
+#else
+void InterfaceHttpSink::incomingConnection(qintptr handle) {
+#endif
+    QTcpSocket *socket = new QTcpSocket(this);
+    connect(socket, SIGNAL(readyRead()),    this, SLOT(readClient()));
+    connect(socket, SIGNAL(disconnected()), this, SLOT(discardClient()));
+    socket->setSocketDescriptor(handle);
+}
+void InterfaceHttpSink::readClient() {
+    QTcpSocket *socket = (QTcpSocket*)sender();
+    QByteArray &buffer = buffers[socket];
+    buffer += socket->readAll();
+
+    //Requests may be pipelined : answer each complete one (headers and body)
+    while(true) {
+        int headerEnd = buffer.indexOf("\r\n\r\n");
+        if(headerEnd < 0)
+            break;
+        QList<QByteArray> headers = buffer.left(headerEnd).split('\n');
+        int contentLength = 0;
+        bool close = false;
+        foreach(const QByteArray &header, headers) {
+            QByteArray headerLower = header.trimmed().toLower();
+            if(headerLower.startsWith("content-length:"))
+                contentLength = headerLower.mid(15).trimmed().toInt();
+            else if(headerLower == "connection: close")
+                close = true;
+        }
+        if(buffer.length() < headerEnd + 4 + contentLength)
+            break;
+        QByteArray body = buffer.mid(headerEnd + 4, contentLength);
+        buffer.remove(0, headerEnd + 4 + contentLength);
+
+        statRequests++;
+        statMessages += (body.isEmpty())?(1):(body.count('\n'));
+        socket->write("HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n");
+        if(close) {
+            socket->disconnectFromHost();
+            break;
+        }
+    }
+}
+void InterfaceHttpSink::discardClient() {
+    QTcpSocket *socket = (QTcpSocket*)sender();
+    buffers.remove(socket);
+    socket->deleteLater();
+}
@@ -33,12 +33,16 @@
 #include <QDir>
 #include <QBuffer>
 #include <QApplication>
+#include <QMutex>
+#include <QAtomicInt>
 #include "misc/options.h"
 #include "messages/messagemanager.h"
 #include "qwebsockets/websocketserver.h"
 #include "qwebsockets/websocket.h"
 
 
+#define HTTP_QUEUE_MAX      4096    //Outgoing messages waiting for a free connection, new ones are dropped above
+
 namespace Ui {
 class InterfaceHttp;
 }
@@ -51,9 +55,28 @@ public:
 
 private:
     QNetworkAccessManager *http;
+public:
+    UiBool coalesce;
+    UiReal maxInFlight;
+
+    //Outgoing requests : filled by the scheduler, sent by the GUI thread on persistent connections
+private:
+    QMutex queueMutex;
+    QList<QUrl> queue;
+    QAtomicInt flushPending;
+    volatile bool bundleOpen;
+    quint16 inFlight;
+    quint32 statMessages, statRequests, statDropped;
+private:
+    void requestFlush();
+    QNetworkRequest request(const QUrl &url) const;
+public slots:
+    void flush();
 
 public:
     bool send(const Message &message, QStringList *messageSent = 0);
+    void networkBundle(bool open);
+    const QString report();
 public:
     bool portChanged(quint16 port);
 protected:
@@ -73,6 +96,31 @@ signals:
 
 
 
+//Minimal keep-alive HTTP server that only counts what it receives, as a local target for throughput tests
+class InterfaceHttpSink : public QTcpServer {
+    Q_OBJECT
+
+public:
+    InterfaceHttpSink(QObject *parent);
+
+private:
+    QHash<QTcpSocket*, QByteArray> buffers;
+    quint32 statMessages, statRequests;
+public:
+    const QString report();
+protected:
+#ifdef QT4
+    void incomingConnection(int handle);
+#else
+    void incomingConnection(qintptr handle);
+#endif
+private slots:
+    void readClient();
+    void discardClient();
+};
+
+
+
 class InterfaceHttp : public NetworkInterface {
     Q_OBJECT
     
@@ -82,6 +130,13 @@ public:
 
 private:
     InterfaceHttpServer *httpServer;
+    InterfaceHttpSink   *httpSink;
+    QString stats;
+public:
+    bool sinkChanged(quint16 port);
+    inline const QString & getStats() const { return stats; }
+protected:
+    void timerEvent(QTimerEvent *);
 private slots:
     void portChanged();
     void parseRequest(QNetworkReply*);
@@ -111,6 +166,7 @@ private slots:
 
 public:
     bool send(const Message &message, QStringList *messageSent = 0);
+    void networkBundle(bool open);
 
 
 private:
@@ -26,6 +26,8 @@
 
 UiBool  InterfaceMidi::syncTransportIn  = true;
 UiBool  InterfaceMidi::syncTransportOut = true;
+UiBool  InterfaceMidi::syncClockIn      = false;
+ExtMidiClock InterfaceMidi::clockSlave;
 QString InterfaceMidi::portInName    = "from_iannix";
 QString InterfaceMidi::portOutName   = "to_iannix";
 
@@ -67,11 +69,13 @@ InterfaceMidi::InterfaceMidi(QWidget *parent) :
         portIn.value(getPortName(portInName))->setCallback(&midiCallback, this);
         portIn.value(getPortName(portInName))->ignoreTypes(true, false, true);
     }
+    clockGenerator = new ExtMidiClockGenerator(this, this);
 
     //Interfaces link
     enable          .setAction(ui->enable,                       "interfaceMidiEnable");
     syncTransportIn .setAction(ui->syncTransportIn,              "interfaceMidiSyncTransportIn");
     syncTransportOut.setAction(ui->syncTransportOut,             "interfaceMidiSyncTransportOut");
+    syncClockIn     .setAction(ui->syncClockIn,                  "interfaceMidiSyncClockIn");
     syncBpm         .setAction(ui->bpm,                          "interfaceMidiSyncBpm");
     MessageManager::aliases["midi_out"].setAction(ui->aliasPort, "interfaceMidiPortAlias");
 
@@ -85,6 +89,7 @@ InterfaceMidi::InterfaceMidi(QWidget *parent) :
 
     timerEvent(0);
     startTimer(5000);
+    clockReportTimer = startTimer(500);
 }
 
 QString InterfaceMidi::getNoteName(quint16 noteValue) {
@@ -92,7 +97,14 @@ QString InterfaceMidi::getNoteName(quint16 noteValue) {
 }
 
 
-void InterfaceMidi::timerEvent(QTimerEvent*) {
+void InterfaceMidi::timerEvent(QTimerEvent *e) {
+    //Clock slave report
+    if((e) && (e->timerId() == clockReportTimer)) {
+        if(syncClockIn) ui->syncClockReport->setText(clockSlave.report(syncBpm));
+        else            ui->syncClockReport->setText("");
+        return;
+    }
+
     RtMidiIn *portListIn = new RtMidiIn();
     quint8 portListInCount = portListIn->getPortCount();
     for(quint8 portListInIndex = 0; portListInIndex < portListInCount ; portListInIndex++) {
@@ -102,7 +114,7 @@ void InterfaceMidi::timerEvent(QTimerEvent*) {
                 portIn.insert(getPortName(portName), new RtMidiIn());
                 portIn.value(getPortName(portName))->openPort(portListInIndex);
                 portIn.value(getPortName(portName))->setCallback(&midiCallback, this);
-                portIn.value(getPortName(portName))->ignoreTypes(true, true, true);
+                portIn.value(getPortName(portName))->ignoreTypes(true, false, true);
             }
         }
         catch(RtError &err) {}
@@ -335,6 +347,25 @@ void InterfaceMidi::networkManualParsing() {
     mutex.unlock();
 }
 void InterfaceMidi::receivedMidiRealtime(quint8 type, quint8 val1, quint8 val2) {
+    //Clock slave : ticks are timestamped right here, on the MIDI thread
+    if(syncClockIn) {
+        if(type == MIDI_CLOCK)
+            clockSlave.tick((60. / syncBpm) / 24.);
+        else if(type == MIDI_TIMECODE) {
+            qreal time = 0;
+            bool complete = midiMtc.decode(val1, &time);
+            clockSlave.tick(1. / (4. * midiMtc.getFps()));
+            if(complete)
+                clockSlave.align(time);
+        }
+        else if(type == MIDI_SPP)
+            clockSlave.reset((128*val2 + val1) * 4 * ((60. / syncBpm) / 16));
+        else if(type == MIDI_START)
+            clockSlave.reset(0);
+        else if(type == MIDI_STOP)
+            clockSlave.stop();
+    }
+
     if(syncTransportIn) {
         mutex.lock();
         if(type == MIDI_SPP) {
@@ -342,11 +373,6 @@ void InterfaceMidi::receivedMidiRealtime(quint8 type, quint8 val1, quint8 val2)
             if(time == 0)   receivedCommands << COMMAND_FF;
             else            receivedCommands << QString("%1 %2").arg(COMMAND_GOTO).arg(time);
         }
-        else if((type == MIDI_CLOCK) || (type == MIDI_TICK) || (type == MIDI_TIMECODE)) {
-            //qreal delta = (60. / syncBpm) / 24.;
-            //qreal slaveTime = midiMtc.decode(val1);
-            //qDebug("TIMECODE %f", slaveTime);
-        }
         else if(type == MIDI_CONTINUE)
             receivedCommands << COMMAND_PLAY;
         else if(type == MIDI_STOP)
@@ -361,51 +387,32 @@ void InterfaceMidi::receivedMidiRealtime(quint8 type, quint8 val1, quint8 val2)
 
 
 
-qreal ExtMidiMTC::decode(quint16 msg) {
-    int times[4]   = {0, 0, 0, 0};
-    QString szType = "";
-    int numFrames  = 100;
-    qreal smpteTime = 0;
+ExtMidiMTC::ExtMidiMTC() {
+    for(quint8 pieceIndex = 0 ; pieceIndex < 8 ; pieceIndex++)
+        pieces[pieceIndex] = 0;
+    fps = 25;
+}
 
-    int messageIndex        = msg >> 4;
-    int value               = msg & 0x0F;
-    int timeIndex           = messageIndex>>1;
-    bool bNewFrame          = messageIndex % 4 == 0;
+//Quarter frame : high nibble is the piece index, low nibble its value
+bool ExtMidiMTC::decode(quint8 data, qreal *time) {
+    quint8 pieceIndex = (data >> 4) & 0x07;
+    pieces[pieceIndex] = data & 0x0F;
+    if(pieceIndex != 7)
+        return false;
 
-    if(bNewFrame) {
-        times[kMTCFrames]++;
-        if(times[kMTCFrames] >= numFrames) {
-            times[kMTCFrames] %= numFrames;
-            times[kMTCSeconds]++;
-            if(times[kMTCSeconds] >= 60) {
-                times[kMTCSeconds] %= 60;
-                times[kMTCMinutes]++;
-                if(times[kMTCMinutes] >= 60) {
-                    times[kMTCMinutes] %= 60;
-                    times[kMTCHours]++;
-                }
-            }
-        }
-        Q_ASSERT_X(numFrames > 0, "MTCDecoder", "Error in received MIDI Time Code");
-        smpteTime = (qreal)(3600*times[kMTCHours] + 60*times[kMTCMinutes] + times[kMTCSeconds] + times[kMTCFrames]) / (qreal)numFrames;
+    switch((pieces[7] >> 1) & 0x03) {
+    case 0:  fps = 24; break;
+    case 1:  fps = 25; break;
+    default: fps = 30; break;
     }
+    quint8 frames  = pieces[0] | (pieces[1] << 4);
+    quint8 seconds = pieces[2] | (pieces[3] << 4);
+    quint8 minutes = pieces[4] | (pieces[5] << 4);
+    quint8 hours   = pieces[6] | ((pieces[7] & 0x01) << 4);
 
-
-    if(messageIndex % 2 == 0)   times[timeIndex]  = value;
-    else                        times[timeIndex] |= value<<4;
-
-    if(messageIndex == 7) {
-        times[kMTCHours] &= 0x1F;
-        int smpteType = value >> 1;
-        switch(smpteType) {
-        case 0: numFrames = 24; szType = "24 fps"; break;
-        case 1: numFrames = 25; szType = "25 fps"; break;
-        case 2: numFrames = 30; szType = "30 fps (drop-frame)"; break;
-        case 3: numFrames = 30; szType = "30 fps"; break;
-        default: numFrames = 100; szType = " **** unknown SMPTE type ****";
-        }
-    }
-    return smpteTime;
+    //The timecode is the one of the first quarter frame, 7 quarter frames ago
+    *time = 3600*hours + 60*minutes + seconds + (frames + 7 / 4.) / (qreal)fps;
+    return true;
 }
 
 void InterfaceMidi::clear() {
@@ -421,6 +428,7 @@ void InterfaceMidi::clear() {
     portOut.clear();
 }
 InterfaceMidi::~InterfaceMidi() {
+    clockGenerator->stop();
     clear();
     delete ui;
 }
@@ -33,6 +33,7 @@
 #include "misc/options.h"
 #include "qrtmidi/RtMidi.h"
 #include "messages/messagemanager.h"
+#include "extmidiclock.h"
 
 #define MASK_CHANNEL      0x0f
 #define MASK_STATUS       0xf0
@@ -62,14 +63,17 @@
 void midiCallback(double deltatime, std::vector< unsigned char > *receivedMessage, void *userData);
 
 
+//MIDI timecode : the full time is known once the 8 quarter frames are received
 class ExtMidiMTC : public QObject {
     Q_OBJECT
 public:
-    qreal decode(quint16);
+    ExtMidiMTC();
+    bool decode(quint8 data, qreal *time);
+    inline quint8 getFps() const { return fps; }
 
 private:
-    int     port, channel, status, byteOne, byteTwo;
-    double  timestamp;
+    quint8 pieces[8];
+    quint8 fps;
 };
 
 namespace Ui {
@@ -85,7 +89,8 @@ public:
     ~InterfaceMidi();
 
 public:
-    static UiBool syncTransportIn, syncTransportOut;
+    static UiBool syncTransportIn, syncTransportOut, syncClockIn;
+    static ExtMidiClock clockSlave;
     static QString midiNotes[12];
     static QString getNoteName(quint16 noteValue);
 private:
@@ -115,6 +120,9 @@ private:
 
 public:
     ExtMidiMTC midiMtc;
+    ExtMidiClockGenerator *clockGenerator;
+private:
+    int clockReportTimer;
 
 protected:
     void timerEvent(QTimerEvent *);
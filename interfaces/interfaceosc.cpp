@@ -284,110 +284,92 @@ void InterfaceOsc::parseOSC() {
         //Extract host, port & UDP datagram
         QHostAddress receivedHost;
         quint16 receivedPort;
-        bufferISize = socket->readDatagram((char*)bufferI, 4096*4, &receivedHost, &receivedPort);
-
-        if(enable) {
-            quint16 indexBuffer = 0;
-            //Parse UDP content
-            while(indexBuffer < bufferISize) {
-                indexAddressBuffer = 0;
-                indexArgumentsBuffer = 0;
-
-                //Looking for '/'
-                while((indexBuffer < bufferISize) && (bufferI[indexBuffer] != '/'))
-                    indexBuffer++;
-
-                //Parse header
-                if((bufferI[indexBuffer] =='/') && (bufferISize%4 == 0)) {
-                    //OSC Adress
-                    while((indexBuffer < bufferISize) && (bufferI[indexBuffer] != 0))
-                        addressBuffer[indexAddressBuffer++] = bufferI[indexBuffer++];
-                    addressBuffer[indexAddressBuffer] = 0;
-
-                    //Looking for ','
-                    while((indexBuffer < bufferISize) && (bufferI[indexBuffer++] != ',')) {}
-
-                    //OSC arguments type
-                    indexBuffer--;
-                    while((indexBuffer < bufferISize) && (bufferI[++indexBuffer] != 0))
-                        argumentsBuffer[indexArgumentsBuffer++] = bufferI[indexBuffer];
-                    argumentsBuffer[indexArgumentsBuffer] = 0;
-                    indexBuffer++;
-
-                    //Index modulo 4
-                    while((indexBuffer < bufferISize) && ((indexBuffer++)%4 != 0)) {}
-                    indexBuffer--;
-
-
-                    //Parse content
-                    QString commandDestination = QString(addressBuffer).remove(oscMatchAdressIanniX).remove(oscMatchAdressTransport);
-                    QString command = commandDestination + " ";
-                    QStringList commandArguments;
-                    quint16 indexDataBuffer = 0;
-                    while((indexBuffer < bufferISize) && (indexDataBuffer < indexArgumentsBuffer)) {
-                        //Integer argument
-                        if(argumentsBuffer[indexDataBuffer] == 'i') {
-                            union { int i; char ch[4]; } u;
-                            u.ch[3] = bufferI[indexBuffer + 0];
-                            u.ch[2] = bufferI[indexBuffer + 1];
-                            u.ch[1] = bufferI[indexBuffer + 2];
-                            u.ch[0] = bufferI[indexBuffer + 3];
-                            indexBuffer += 4;
-                            QString commandValue = QString::number(u.i);
-                            command += commandValue + " ";
-                            commandArguments << commandValue;
-                        }
-                        //Float argument
-                        else if(argumentsBuffer[indexDataBuffer] == 'f') {
-                            union { float f; char ch[4]; } u;
-                            u.ch[3] = bufferI[indexBuffer + 0];
-                            u.ch[2] = bufferI[indexBuffer + 1];
-                            u.ch[1] = bufferI[indexBuffer + 2];
-                            u.ch[0] = bufferI[indexBuffer + 3];
-                            indexBuffer += 4;
-                            QString commandValue = QString::number(u.f);
-                            command += commandValue + " ";
-                            commandArguments << commandValue;
-                        }
-                        //String argument
-                        else if(argumentsBuffer[indexDataBuffer] == 's') {
-                            QString commandValue = "";
-                            while((indexBuffer < bufferISize) && (bufferI[indexBuffer]) != 0)
-                                commandValue += bufferI[indexBuffer++];
-                            indexBuffer++;
-                            while(indexBuffer % 4 != 0)
-                                indexBuffer++;
-                            command += commandValue + " ";
-                            commandArguments << commandValue;
-                        }
-                        else
-                            indexBuffer += 4;
-                        indexDataBuffer++;
-                    }
+        bufferI.resize(qMax(socket->pendingDatagramSize(), (qint64)0));
+        qint64 bufferISize = socket->readDatagram(bufferI.data(), bufferI.size(), &receivedHost, &receivedPort);
 
-                    MessageManager::incomingMessage(MessageIncomming("osc", receivedHost.toString(), receivedPort, commandDestination, command, commandArguments));
-                    //QApplication::processEvents();
-
-                    /*
-                    Application::synchroLoopGuard = this;
-                    if(command.toLower().startsWith("transport play"))
-                        Application::current->execute(COMMAND_PLAY, ExecuteSourceNetwork);
-                    else if(command.toLower().startsWith("transport stop"))
-                        Application::current->execute(COMMAND_STOP, ExecuteSourceNetwork);
-                    else if(command.toLower().startsWith("transport fastrewind")) {
-                        Application::current->execute(COMMAND_FF, ExecuteSourceNetwork);
-                    }
-                    else if(command.toLower().startsWith("transport goto")) {
-                        qreal time = command.remove("transport goto").trimmed().toDouble();
-                        if(time == 0)   Application::current->execute(COMMAND_FF, ExecuteSourceNetwork);
-                        else            Application::current->execute(QString("%1 %2").arg(COMMAND_GOTO).arg(time), ExecuteSourceNetwork);
-                    }
-                    Application::synchroLoopGuard = 0;
-                    */
-                }
-            }
+        if((enable) && (bufferISize > 0))
+            parseOSC(bufferI.constData(), bufferISize, receivedHost, receivedPort);
+    }
+}
+void InterfaceOsc::parseOSC(const char *buffer, qint32 bufferSize, const QHostAddress &receivedHost, quint16 receivedPort, const QString &protocol) {
+    //Bundle (#bundle, timetag and size-prefixed elements, possibly nested)
+    if((bufferSize >= 16) && (qstrncmp(buffer, "#bundle", 8) == 0)) {
+        qint32 indexBuffer = 16;
+        while(indexBuffer + 4 <= bufferSize) {
+            qint32 elementSize = qFromBigEndian<qint32>((const uchar*)(buffer + indexBuffer));
+            indexBuffer += 4;
+            if((elementSize <= 0) || (elementSize > bufferSize - indexBuffer))
+                break;
+            parseOSC(buffer + indexBuffer, elementSize, receivedHost, receivedPort, protocol);
+            indexBuffer += elementSize;
         }
+        return;
     }
+
+    //Message
+    if((bufferSize < 4) || (bufferSize % 4 != 0) || (buffer[0] != '/'))
+        return;
+
+    //OSC Adress
+    qint32 indexBuffer = 0;
+    qint32 addressSize = qstrnlen(buffer, bufferSize);
+    indexBuffer = (addressSize + 4) & ~3;
+
+    //OSC arguments type
+    const char *typetags = "";
+    qint32 typetagsSize = 0;
+    if((indexBuffer < bufferSize) && (buffer[indexBuffer] == ',')) {
+        typetags     = buffer + indexBuffer + 1;
+        typetagsSize = qstrnlen(typetags, bufferSize - indexBuffer - 1);
+        indexBuffer  = (indexBuffer + typetagsSize + 1 + 4) & ~3;
+    }
+
+    //Parse content, arguments stay typed until a command needs their text form
+    QString commandDestination = QString::fromLatin1(buffer, addressSize).remove(oscMatchAdressIanniX).remove(oscMatchAdressTransport);
+    QVariantList commandValues;
+    commandValues.reserve(typetagsSize);
+    for(qint32 indexTypetag = 0 ; (indexTypetag < typetagsSize) && (indexBuffer <= bufferSize) ; indexTypetag++) {
+        const uchar *data = (const uchar*)(buffer + indexBuffer);
+        char typetag = typetags[indexTypetag];
+        //Integer argument
+        if((typetag == 'i') && (indexBuffer + 4 <= bufferSize)) {
+            commandValues << (qint32)qFromBigEndian<qint32>(data);
+            indexBuffer += 4;
+        }
+        //Float argument
+        else if((typetag == 'f') && (indexBuffer + 4 <= bufferSize)) {
+            union { quint32 i; float f; } u;
+            u.i = qFromBigEndian<quint32>(data);
+            commandValues << (qreal)u.f;
+            indexBuffer += 4;
+        }
+        //Double argument
+        else if((typetag == 'd') && (indexBuffer + 8 <= bufferSize)) {
+            union { quint64 i; double d; } u;
+            u.i = qFromBigEndian<quint64>(data);
+            commandValues << (qreal)u.d;
+            indexBuffer += 8;
+        }
+        //String argument
+        else if((typetag == 's') || (typetag == 'S')) {
+            qint32 stringSize = qstrnlen(buffer + indexBuffer, bufferSize - indexBuffer);
+            commandValues << QString::fromLatin1(buffer + indexBuffer, stringSize);
+            indexBuffer = (indexBuffer + stringSize + 4) & ~3;
+        }
+        //Blob argument (skipped)
+        else if((typetag == 'b') && (indexBuffer + 4 <= bufferSize))
+            indexBuffer += 4 + ((qFromBigEndian<qint32>(data) + 3) & ~3);
+        //64-bit arguments (skipped)
+        else if((typetag == 'h') || (typetag == 't'))
+            indexBuffer += 8;
+        //Arguments without data
+        else if((typetag == 'T') || (typetag == 'F') || (typetag == 'N') || (typetag == 'I')) {}
+        else
+            indexBuffer += 4;
+    }
+
+    MessageManager::incomingMessage(MessageIncomming(protocol, receivedHost.toString(), receivedPort, commandDestination, commandValues));
+    Transport::perfOscReceiveCounter++;
 }
 
 void InterfaceOsc::networkSynchro(bool start) {
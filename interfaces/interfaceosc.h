@@ -27,6 +27,7 @@
 #include <QTimer>
 #include <QWidget>
 #include <QByteArray>
+#include <QtEndian>
 #include <QNetworkInterface>
 #include <QHostInfo>
 #include "misc/options.h"
@@ -117,12 +118,11 @@ private:
     QList<Message> bundleMessages;
     quint64 bundleMessageId;
 private:
-    quint8 bufferI[4096*4], bufferO[4096*4];
-    qint16 bufferISize, bufferOSize;
-    char addressBuffer[255], argumentsBuffer[255];
-    quint16 indexAddressBuffer, indexArgumentsBuffer;
+    QByteArray bufferI;
 public slots:
     void parseOSC();
+public:
+    void parseOSC(const char *buffer, qint32 bufferSize, const QHostAddress &receivedHost, quint16 receivedPort, const QString &protocol = "osc");
 
 public:
     bool send(const Message &message, QStringList *messageSent = 0);
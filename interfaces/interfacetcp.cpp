@@ -23,6 +23,7 @@
 
 #include "interfacetcp.h"
 #include "ui_interfacetcp.h"
+#include "interfaceosc.h"
 
 InterfaceTcp::InterfaceTcp(QWidget *parent) :
     NetworkInterface(parent),
@@ -33,19 +34,27 @@ InterfaceTcp::InterfaceTcp(QWidget *parent) :
     tcpServer = new InterfaceTcpServer(this);
     connect(tcpServer, SIGNAL(updateConnectedClients()),           SLOT(updateConnectedClients()));
     connect(tcpServer, SIGNAL(parseXml(QDomDocument,QTcpSocket*)), SLOT(parseXml(QDomDocument,QTcpSocket*)));
+    connect(tcpServer, SIGNAL(parseOsc(QByteArray,QTcpSocket*)),   SLOT(parseOsc(QByteArray,QTcpSocket*)));
+    tcpSoak = new InterfaceTcpSoak(tcpServer, this);
 
     //Interfaces link
     enable.setAction(ui->enable, "interfaceTcpEnable");
     port.setAction(ui->port,     "interfaceTcpPort");
     connect(&port, SIGNAL(triggered(qreal)), SLOT(portChanged()));
-    type.setAction(QList<QRadioButton*>() << ui->typeRaw << ui->typeXml, "interfaceTcpXml");
+    type.setAction(QList<QRadioButton*>() << ui->typeRaw << ui->typeXml << ui->typeOsc, "interfaceTcpXml");
     connect(&type, SIGNAL(triggered(qreal)), SLOT(typeChanged()));
     port = 3000;
+
+    //Clients statistics
+    startTimer(1000);
 }
 
 InterfaceTcpServer::InterfaceTcpServer(QObject *parent) :
     QTcpServer(parent) {
-    xmlMode = false;
+    mode = TcpModeRaw;
+    queueDropped = 0;
+    flushPending.fetchAndStoreOrdered(0);
+    clientCount.fetchAndStoreOrdered(0);
 }
 
 void InterfaceTcp::portChanged() {
@@ -53,7 +62,7 @@ void InterfaceTcp::portChanged() {
     else                                    ui->port->setStyleSheet(ihmFeedbackNok);
 }
 void InterfaceTcp::typeChanged() {
-    tcpServer->xmlMode = (type.val() > 0);
+    tcpServer->mode = type.val();
 }
 bool InterfaceTcpServer::portChanged(quint16 port) {
     //Initialization
@@ -68,13 +77,21 @@ bool InterfaceTcp::send(const Message &message, QStringList *messageSent) {
     return tcpServer->send(message, messageSent);
 }
 bool InterfaceTcpServer::send(const Message &message, QStringList *messageSent) {
-    bool ok = false;
     QByteArray bytes;
-    if(xmlMode) {
+    if(mode == TcpModeXml) {
         //bytes += "<OSCPACKET ADDRESS=\"" + socket->localAddress().toString() + "\" PORT=\"" + QByteArray::number(socket->localPort()) + "\" TIME=\"" + QByteArray::number(Transport::timeLocal) + "\"><MESSAGE NAME=\"/" + message.getAddress() + "\">" + message.getAsciiMessageXml() + "</MESSAGE></OSCPACKET>";
         bytes += "<OSCPACKET TIME=\"" + QByteArray::number(Transport::timeLocal) + "\"><MESSAGE NAME=\"/" + message.getAddress() + "\">" + message.getAsciiMessageXml() + "</MESSAGE></OSCPACKET>";
         bytes += (char)0;
     }
+    else if(mode == TcpModeOsc) {
+        //OSC packet built by Message (address, i/f/s/t typetags, big-endian arguments) preceded by its size
+        const QByteArray &packet = message.getBuffer();
+
+        uchar size[4];
+        qToBigEndian<qint32>(packet.size(), size);
+        bytes.append((const char*)size, 4);
+        bytes += packet;
+    }
     else {
         foreach(const QVariant &valeur, message.verboseValues) {
             bool isFloat = false;
@@ -91,16 +108,53 @@ bool InterfaceTcpServer::send(const Message &message, QStringList *messageSent)
         }
     }
 
-    //Send request
-    foreach(QTcpSocket *socket, sockets) {
-        socket->write(bytes);
-        socket->flush();
+    //Queue request (sockets belong to the GUI thread, only their count is shared)
+    if(clientCount.fetchAndAddOrdered(0) == 0)
+        return false;
+    queueMutex.lock();
+    if(queue.count() >= TCP_QUEUE_MAX) {
+        queueDropped++;
+        queueMutex.unlock();
+        return false;
+    }
+    queue.append(bytes);
+    queueMutex.unlock();
+    if(flushPending.testAndSetOrdered(0, 1))
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
 
-        //Log in console
-        MessageManager::logSend(message, messageSent);
-        ok = true;
+    //Log in console
+    MessageManager::logSend(message, messageSent);
+    return true;
+}
+void InterfaceTcpServer::flush() {
+    flushPending.fetchAndStoreOrdered(0);
+    queueMutex.lock();
+    QList<QByteArray> messages = queue;
+    queue.clear();
+    queueMutex.unlock();
+
+    //A slow client only loses its own messages, and is disconnected if it does not recover
+    QList<QTcpSocket*> slowSockets;
+    foreach(QTcpSocket *socket, sockets) {
+        InterfaceTcpClient &client = clients[socket];
+        foreach(const QByteArray &bytes, messages) {
+            if(socket->bytesToWrite() > TCP_HIGH_WATER) {
+                client.dropped++;
+                client.droppedInRow++;
+            }
+            else {
+                socket->write(bytes);
+                client.messagesOut++;
+                client.droppedInRow = 0;
+            }
+        }
+        if(client.droppedInRow >= TCP_DROP_LIMIT)
+            slowSockets.append(socket);
+    }
+    foreach(QTcpSocket *socket, slowSockets) {
+        qDebug("[TCP] Client %s:%d too slow, disconnected (%d messages dropped)", qPrintable(socket->peerAddress().toString()), socket->peerPort(), clients.value(socket).dropped);
+        socket->abort();
     }
-    return ok;
 }
 
 
@@ -112,6 +166,8 @@ void InterfaceTcpServer::incomingConnection(int handle) {
     connect(socket, SIGNAL(disconnected()), this, SLOT(discardClient()));
     socket->setSocketDescriptor(handle);
     sockets.append(socket);
+    clients.insert(socket, InterfaceTcpClient());
+    clientCount.fetchAndStoreOrdered(sockets.count());
     emit(updateConnectedClients());
 }
 #else
@@ -121,36 +177,90 @@ void InterfaceTcpServer::incomingConnection(qintptr handle) {
     connect(socket, SIGNAL(disconnected()), this, SLOT(discardClient()));
     socket->setSocketDescriptor(handle);
     sockets.append(socket);
+    clients.insert(socket, InterfaceTcpClient());
+    clientCount.fetchAndStoreOrdered(sockets.count());
     emit(updateConnectedClients());
 }
 #endif
 void InterfaceTcpServer::readClient() {
     QTcpSocket *socket = (QTcpSocket*)sender();
-    if(socket->isReadable()) {
-        if(xmlMode) {
-            //XML parsing
-            QDomDocument xmlDoc;
-            xmlDoc.setContent(socket->readAll());
+    if(!socket->isReadable())
+        return;
+
+    //TCP is a stream : data is accumulated until a whole message is received
+    //(parsing may run scripts, so the client is only looked up again at the end)
+    QByteArray received = clients.value(socket).received + socket->readAll();
+    qint32 indexBuffer = 0;
+    quint32 messagesIn = 0;
+    if(mode == TcpModeXml) {
+        //XML packets end with a null character
+        while(true) {
+            qint32 packetEnd = received.indexOf((char)0, indexBuffer);
+            if(packetEnd < 0)
+                break;
+            if(packetEnd > indexBuffer) {
+                QDomDocument xmlDoc;
+                xmlDoc.setContent(received.mid(indexBuffer, packetEnd - indexBuffer));
+                messagesIn++;
+                emit(parseXml(xmlDoc, socket));
+            }
+            indexBuffer = packetEnd + 1;
+        }
+        //Clients that do not terminate their packets
+        QDomDocument xmlDoc;
+        if((indexBuffer < received.size()) && (xmlDoc.setContent(received.mid(indexBuffer)))) {
+            messagesIn++;
             emit(parseXml(xmlDoc, socket));
+            indexBuffer = received.size();
         }
-        else {
-            //RAW data
-            QByteArray dataReceived = socket->readAll();
-            QStringList arguments;
-            for(quint16 indexBuffer = 0 ; indexBuffer < dataReceived.count() ; indexBuffer += 4) {
-                union { float f; char ch[4]; } u;
-                u.ch[0] = dataReceived[indexBuffer + 0];
-                u.ch[1] = dataReceived[indexBuffer + 1];
-                u.ch[2] = dataReceived[indexBuffer + 2];
-                u.ch[3] = dataReceived[indexBuffer + 3];
-                qreal val = u.f;
-                arguments << QString::number(val);
+    }
+    else if(mode == TcpModeOsc) {
+        //OSC packets preceded by their size
+        while(indexBuffer + 4 <= received.size()) {
+            qint32 packetSize = qFromBigEndian<qint32>((const uchar*)(received.constData() + indexBuffer));
+            if((packetSize <= 0) || (packetSize > TCP_FRAME_MAX)) {
+                qDebug("[TCP] Client %s:%d sent an invalid OSC packet size (%d), disconnected", qPrintable(socket->peerAddress().toString()), socket->peerPort(), packetSize);
+                socket->abort();
+                return;
             }
+            if(indexBuffer + 4 + packetSize > received.size())
+                break;
+            messagesIn++;
+            emit(parseOsc(received.mid(indexBuffer + 4, packetSize), socket));
+            indexBuffer += 4 + packetSize;
+        }
+    }
+    else {
+        //RAW data : whole floats only
+        QStringList arguments;
+        for(; indexBuffer + 4 <= received.size() ; indexBuffer += 4) {
+            union { float f; char ch[4]; } u;
+            u.ch[0] = received[indexBuffer + 0];
+            u.ch[1] = received[indexBuffer + 1];
+            u.ch[2] = received[indexBuffer + 2];
+            u.ch[3] = received[indexBuffer + 3];
+            qreal val = u.f;
+            arguments << QString::number(val);
+        }
+        if(arguments.count()) {
+            messagesIn++;
             MessageManager::incomingMessage(MessageIncomming("tcp", socket->peerAddress().toString(), socket->peerPort(), "tcp_raw", "", arguments));
         }
     }
+    if(clients.contains(socket)) {
+        InterfaceTcpClient &client = clients[socket];
+        client.received = (received.size() - indexBuffer > TCP_FRAME_MAX)?(QByteArray()):(received.mid(indexBuffer));
+        client.messagesIn += messagesIn;
+    }
 }
 
+void InterfaceTcp::parseOsc(const QByteArray &packet, QTcpSocket *socket) {
+    if(!enable)
+        return;
+    InterfaceOsc *interfaceOsc = (InterfaceOsc*)MessageManager::interfaces.value(MessagesTypeOsc);
+    if(interfaceOsc)
+        interfaceOsc->parseOSC(packet.constData(), packet.size(), socket->peerAddress(), socket->peerPort(), "tcp");
+}
 void InterfaceTcp::parseXml(const QDomDocument &xmlDoc, QTcpSocket *socket) {
     if(!enable)
         return;
@@ -180,6 +290,8 @@ void InterfaceTcp::parseXml(const QDomDocument &xmlDoc, QTcpSocket *socket) {
 void InterfaceTcpServer::discardClient() {
     QTcpSocket* socket = (QTcpSocket*)sender();
     sockets.removeOne(socket);
+    clients.remove(socket);
+    clientCount.fetchAndStoreOrdered(sockets.count());
     emit(updateConnectedClients());
     socket->deleteLater();
 }
@@ -187,16 +299,128 @@ void InterfaceTcpServer::discardClient() {
 
 void InterfaceTcp::updateConnectedClients() {
     QString clients;
-    foreach(QTcpSocket *socket, tcpServer->sockets)
-        clients += QString("%1:%2\n").arg(socket->peerAddress().toString()).arg(socket->peerPort());
+    foreach(QTcpSocket *socket, tcpServer->sockets) {
+        const InterfaceTcpClient &client = tcpServer->clients.value(socket);
+        clients += QString("%1:%2 (%3 in, %4 out, %5 dropped)\n").arg(socket->peerAddress().toString()).arg(socket->peerPort()).arg(client.messagesIn).arg(client.messagesOut).arg(client.dropped);
+    }
     clients.chop(1);
     if(tcpServer->sockets.count() == 0)        ui->clients->setText(tr("No client connected"));
     else if(tcpServer->sockets.count() == 1)   ui->clients->setText(tr("1 client connected\n(%1)").arg(clients));
     else                                       ui->clients->setText(tr("%1 clients connected").arg(tcpServer->sockets.count()));
+    if(tcpServer->queueDropped)
+        clients += "\n" + tr("%1 messages dropped (queue full)").arg(tcpServer->queueDropped);
     ui->clients->setToolTip(clients);
 }
+void InterfaceTcp::timerEvent(QTimerEvent *) {
+    updateConnectedClients();
+}
 
 
 InterfaceTcp::~InterfaceTcp() {
     delete ui;
 }
+
+
+
+//Soak test
+bool InterfaceTcp::soak(quint16 clientCount, qreal duration) {
+    if(type.val() != TcpModeOsc) {
+        qDebug("[TCP] The soak test needs the OSC stream format");
+        return false;
+    }
+    return tcpSoak->start(port.val(), clientCount, duration);
+}
+
+InterfaceTcpSoak::InterfaceTcpSoak(InterfaceTcpServer *_server, QObject *parent) :
+    QObject(parent) {
+    server = _server;
+    timer = -1;
+    tickCount = tickMax = 0;
+}
+bool InterfaceTcpSoak::start(quint16 port, quint16 clientCount, qreal duration) {
+    stop();
+    for(quint16 clientIndex = 0 ; clientIndex < clientCount ; clientIndex++) {
+        QTcpSocket *socket = new QTcpSocket(this);
+        socket->connectToHost(QHostAddress::LocalHost, port);
+        sockets.append(socket);
+    }
+    tickCount = 0;
+    tickMax   = qMax(1, qRound(duration * 100));
+    timer     = startTimer(10);
+    qDebug("[TCP] Soak test : %d clients for %.1f s", clientCount, duration);
+    return true;
+}
+void InterfaceTcpSoak::timerEvent(QTimerEvent *) {
+    for(quint16 clientIndex = 0 ; clientIndex < sockets.count() ; clientIndex++) {
+        QTcpSocket *socket = sockets.at(clientIndex);
+        if(socket->state() != QAbstractSocket::ConnectedState)
+            continue;
+
+        //Odd clients never read : the server must drop their messages, then disconnect them
+        if(clientIndex % 2 == 0) {
+            QByteArray &buffer = received[socket];
+            buffer += socket->readAll();
+            qint32 indexBuffer = 0;
+            while(indexBuffer + 4 <= buffer.size()) {
+                qint32 packetSize = qFromBigEndian<qint32>((const uchar*)(buffer.constData() + indexBuffer));
+                if((packetSize <= 0) || (packetSize > TCP_FRAME_MAX)) {
+                    errors[socket]++;
+                    indexBuffer = buffer.size();
+                    break;
+                }
+                if(indexBuffer + 4 + packetSize > buffer.size())
+                    break;
+                if(buffer.at(indexBuffer + 4) == '/')   framesIn[socket]++;
+                else                                    errors[socket]++;
+                indexBuffer += 4 + packetSize;
+            }
+            buffer.remove(0, indexBuffer);
+        }
+
+        //Every client sends a few packets, written in random pieces so that the server has to reassemble them
+        QByteArray &outgoing = pending[socket];
+        for(quint16 packetIndex = 0 ; packetIndex < 4 ; packetIndex++) {
+            QByteArray packet = "/soak";
+            packet += QByteArray(3, 0);
+            packet += ",i";
+            packet += QByteArray(2, 0);
+            uchar data[4];
+            qToBigEndian<qint32>(framesOut[socket]++, data);
+            packet.append((const char*)data, 4);
+            qToBigEndian<qint32>(packet.size(), data);
+            outgoing.append((const char*)data, 4);
+            outgoing += packet;
+        }
+        qint32 pieceSize = qMin(outgoing.size(), 1 + qrand() % 64);
+        socket->write(outgoing.left(pieceSize));
+        outgoing.remove(0, pieceSize);
+    }
+    if(++tickCount >= tickMax)
+        stop();
+}
+void InterfaceTcpSoak::stop() {
+    if(timer < 0)
+        return;
+    killTimer(timer);
+    timer = -1;
+
+    //Report, client by client (server side statistics are found with the client port)
+    quint16 clientIndex = 0;
+    foreach(QTcpSocket *socket, sockets) {
+        InterfaceTcpClient serverClient;
+        foreach(QTcpSocket *serverSocket, server->sockets)
+            if(serverSocket->peerPort() == socket->localPort())
+                serverClient = server->clients.value(serverSocket);
+        quint32 framesSent = framesOut.value(socket) - pending.value(socket).size() / 20;
+        qDebug("[TCP] Soak client %2d (%s) : %s, %d packets sent / %d reassembled by the server, %d packets received (%d framing errors) / %d written by the server, %d dropped", clientIndex, (clientIndex % 2)?("never reads"):("reads"), (socket->state() == QAbstractSocket::ConnectedState)?("connected"):("disconnected"), framesSent, serverClient.messagesIn, framesIn.value(socket), errors.value(socket), serverClient.messagesOut, serverClient.dropped);
+        socket->abort();
+        socket->deleteLater();
+        clientIndex++;
+    }
+    sockets.clear();
+    received.clear();
+    pending.clear();
+    framesIn.clear();
+    framesOut.clear();
+    errors.clear();
+}
@@ -25,14 +25,32 @@
 #define INTERFACETCP_H
 
 #include <QTcpServer>
+#include <QTcpSocket>
 #include <QDomDocument>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QtEndian>
 #include "misc/options.h"
 #include "messages/messagemanager.h"
 
+#define TCP_HIGH_WATER      (1 << 20)   //Bytes waiting for a client above which its messages are dropped
+#define TCP_DROP_LIMIT      1000        //Messages dropped in a row before a client is disconnected
+#define TCP_QUEUE_MAX       4096        //Messages waiting to be written by the GUI thread
+#define TCP_FRAME_MAX       (1 << 16)   //Largest OSC packet accepted from a client
+
 namespace Ui {
 class InterfaceTcp;
 }
 
+enum TcpMode { TcpModeRaw = 0, TcpModeXml = 1, TcpModeOsc = 2 };
+
+class InterfaceTcpClient {
+public:
+    InterfaceTcpClient() { messagesIn = messagesOut = dropped = droppedInRow = 0; }
+    QByteArray received;
+    quint32 messagesIn, messagesOut, dropped, droppedInRow;
+};
+
 class InterfaceTcpServer : public QTcpServer {
     Q_OBJECT
 
@@ -40,9 +58,21 @@ public:
     InterfaceTcpServer(QObject *parent);
 
 public:
-    bool xmlMode;
+    quint8 mode;
     QList<QTcpSocket*> sockets;
+    QHash<QTcpSocket*, InterfaceTcpClient> clients;
     bool send(const Message &message, QStringList *messageSent = 0);
+
+    //Outgoing messages : filled by the scheduler, written to each client by the GUI thread
+private:
+    QMutex queueMutex;
+    QList<QByteArray> queue;
+    QAtomicInt flushPending;
+    QAtomicInt clientCount;
+public:
+    quint32 queueDropped;
+private slots:
+    void flush();
 public:
     bool portChanged(quint16 port);
 protected:
@@ -57,6 +87,29 @@ private slots:
 signals:
     void updateConnectedClients();
     void parseXml(const QDomDocument&, QTcpSocket*);
+    void parseOsc(const QByteArray&, QTcpSocket*);
+};
+
+
+//Local clients for soak tests : half of them read everything and check the framing, the others never read
+class InterfaceTcpSoak : public QObject {
+    Q_OBJECT
+
+public:
+    explicit InterfaceTcpSoak(InterfaceTcpServer *_server, QObject *parent = 0);
+
+private:
+    InterfaceTcpServer *server;
+    QList<QTcpSocket*> sockets;
+    QHash<QTcpSocket*, QByteArray> received, pending;
+    QHash<QTcpSocket*, quint32> framesIn, framesOut, errors;
+    int timer, tickCount, tickMax;
+
+public:
+    bool start(quint16 port, quint16 clientCount, qreal duration);
+    void stop();
+protected:
+    void timerEvent(QTimerEvent *);
 };
 
 class InterfaceTcp : public NetworkInterface {
@@ -68,6 +121,12 @@ public:
 
 private:
     InterfaceTcpServer *tcpServer;
+    InterfaceTcpSoak   *tcpSoak;
+public:
+    bool soak(quint16 clientCount, qreal duration);
+protected:
+    void timerEvent(QTimerEvent *);
+private:
     UiReal port;
     UiBool enable;
     UiReal type;
@@ -76,6 +135,7 @@ private slots:
     void typeChanged();
     void updateConnectedClients();
     void parseXml(const QDomDocument&, QTcpSocket*);
+    void parseOsc(const QByteArray&, QTcpSocket*);
     void openExamples() {
         QDesktopServices::openUrl(QUrl::fromLocalFile(QFileInfo(Application::pathPatches.absoluteFilePath() + "/Adobe Flash/").absoluteFilePath()));
     }
@@ -23,6 +23,7 @@
 
 #include "uicoloritem.h"
 #include "misc/uitheme.h"
+#include "misc/application.h"
 
 UiColorItems::UiColorItems(UiSyncItem *_parent) :
     UiSyncItem(_parent) {
@@ -74,6 +75,7 @@ bool UiColorItems::update() {
 }
 
 void UiColorItems::dataChanged() {
+    Render::triggersRevision++;
     treeWidget()->sortItems(1, Qt::AscendingOrder);
 }
 
@@ -251,6 +251,10 @@ const QFileInfo UiFileItem::fileGetName(const QFileInfo &base) {
     return retour;
 }
 bool UiFileItem::fileCopy(const QFileInfo &source, const QFileInfo &dest) {
+    //Binary objects file (.nxbin) follows its score
+    QFileInfo sourceBinary(source.absolutePath() + "/" + source.completeBaseName() + ".nxbin");
+    if((source.isFile()) && (sourceBinary.exists()))
+        QFile::copy(sourceBinary.absoluteFilePath(), dest.absolutePath() + "/" + dest.completeBaseName() + ".nxbin");
     return QFile::copy(source.absoluteFilePath(), dest.absoluteFilePath());
 }
 void UiFileItem::fileRename() {
@@ -263,6 +267,9 @@ bool UiFileItem::fileRename(const QFileInfo &source, const QString &newNameWitho
 bool UiFileItem::fileRename(const QFileInfo &source, const QFileInfo &destination, UiFileItem *item) {
     if(source != destination) {
         QFileInfo correctDestination = fileGetName(destination);
+        QFileInfo sourceBinary(source.absolutePath() + "/" + source.completeBaseName() + ".nxbin");
+        if((source.isFile()) && (sourceBinary.exists()))
+            QFile::rename(sourceBinary.absoluteFilePath(), correctDestination.absolutePath() + "/" + correctDestination.completeBaseName() + ".nxbin");
         if(QFile::rename(source.absoluteFilePath(), correctDestination.absoluteFilePath())) {
             if(item)
                 item->filename = QFileInfo(correctDestination.absoluteFilePath());
@@ -22,6 +22,7 @@
 */
 
 #include "uitextureitem.h"
+#include "misc/application.h"
 
 UiTextureItems::UiTextureItems(UiSyncItem *_parent) :
     UiSyncItem(_parent) {
@@ -78,6 +79,7 @@ void UiTextureItems::update() {
 }
 
 void UiTextureItems::dataChanged() {
+    Render::triggersRevision++;
     treeWidget()->sortItems(0, Qt::AscendingOrder);
 }
 
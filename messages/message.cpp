@@ -22,6 +22,7 @@
 */
 
 #include "message.h"
+#include <QtEndian>
 #include "objects/nxtrigger.h"
 #include "objects/nxcursor.h"
 #include "objects/nxcurve.h"
@@ -31,6 +32,8 @@ Message::Message() {
     hasAdd = false;
     messageScriptEngine = 0;
     isTransportMessage = false;
+    artnetUniverse = 0;
+    artnetChannel = 1;
 }
 
 void Message::setUrl(QString url, QScriptEngine *_messageScriptEngine, const QHash<QString,UiString> &aliases) {
@@ -43,8 +46,13 @@ void Message::setUrl(QString url, QScriptEngine *_messageScriptEngine, const QHa
 }
 void Message::setUrl(const QUrl & url, QScriptEngine *_messageScriptEngine) {
     messageScriptEngine = _messageScriptEngine;
-    if(messageScriptEngine)
+    if(messageScriptEngine) {
+        //Variables stay on the global object (scripts and score functions read them there), names are interned
         messageScriptValue = messageScriptEngine->globalObject();
+        messageScriptNames.resize(MessageArgumentOpcodeCount);
+        for(quint16 opcode = 0 ; opcode < MessageArgumentOpcodeCount ; opcode++)
+            messageScriptNames[opcode] = messageScriptEngine->toStringHandle(MessageArgument::getKeyword((MessageArgumentOpcode)opcode));
+    }
     hasAdd = false;
     urlMessage = url;
 
@@ -71,6 +79,7 @@ void Message::setUrl(const QUrl & url, QScriptEngine *_messageScriptEngine) {
     else if(scheme == "tcp") {
         type = MessagesTypeTcp;
         address += urlMessage.authority() + urlMessage.path();
+        typetag += ',';
     }
     else if(scheme == "udp") {
         type = MessagesTypeUdp;
@@ -88,10 +97,27 @@ void Message::setUrl(const QUrl & url, QScriptEngine *_messageScriptEngine) {
         midiPort = urlMessage.host().toLower();
         midiCommand = urlMessage.path().toLower();
     }
+    else if(scheme == "artnet") {
+        type = MessagesTypeArtnet;
+        if(urlMessage.host().toLower() == "broadcast")  host = QHostAddress::Broadcast;
+        else                                            host = urlMessage.host();
+        port = urlMessage.port(6454);
+        setArtnetAddress();
+    }
+}
+//Art-Net destination is written as /universe/channel (universe is the 15 bits port-address, channel starts at 1)
+void Message::setArtnetAddress() {
+    QStringList artnetAddress = urlMessage.path().split("/", QString::SkipEmptyParts);
+    artnetUniverse = (artnetAddress.count() > 0)?(artnetAddress.at(0).toUInt() & 0x7FFF):(0);
+    artnetChannel  = (artnetAddress.count() > 1)?(qMax(artnetAddress.at(1).toUInt(), 1u)):(1);
 }
 
 
-bool Message::parse(const QVector<QByteArray> & patternItems, const MessageManagerDestination &destination) {
+bool Message::parse(const QVector<MessageArgument> & patternItems, const MessageManagerDestination &destination) {
+    NxTrigger *trigger        = (NxTrigger*)destination.trigger;
+    NxCursor  *cursor         = (NxCursor*)destination.cursor;
+    NxCurve   *curve          = (NxCurve*)destination.curve;
+    NxCurve   *collisionCurve = (NxCurve*)destination.collisionCurve;
     bool suppressSend = false;
     midiValues   .clear();
     asciiMessage .clear();
@@ -103,482 +129,714 @@ bool Message::parse(const QVector<QByteArray> & patternItems, const MessageManag
     if(patternItems.count() >= 2) {
         //Messages
         for(quint16 patternIndex = 1 ; patternIndex < patternItems.count() ; patternIndex++) {
-            QByteArray patternArgument = patternItems.at(patternIndex);
+            const MessageArgument &argument = patternItems.at(patternIndex);
             bool found = false;
 
-            if((patternArgument.at(0) == '{') && (messageScriptEngine)) {
-                patternArgument = patternArgument.trimmed().remove(0, 1);
-                patternArgument.chop(1);
-
-                if(((NxTrigger*)destination.trigger)) {
-                    if(patternArgument.contains("trigger_id"))
-                        messageScriptValue.setProperty("trigger_id", ((NxTrigger*)destination.trigger)->getId());
-                    if(patternArgument.contains("trigger_group_id"))
-                        messageScriptValue.setProperty("trigger_group_id", ((NxTrigger*)destination.trigger)->getGroupId());
-                    if(patternArgument.contains("trigger_label"))
-                        messageScriptValue.setProperty("trigger_label", ((NxTrigger*)destination.trigger)->getLabel());
-                    if(patternArgument.contains("trigger_xPos"))
-                        messageScriptValue.setProperty("trigger_xPos", ((NxTrigger*)destination.trigger)->getPos().x());
-                    if(patternArgument.contains("trigger_yPos"))
-                        messageScriptValue.setProperty("trigger_yPos", ((NxTrigger*)destination.trigger)->getPos().y());
-                    if(patternArgument.contains("trigger_zPos"))
-                        messageScriptValue.setProperty("trigger_zPos", ((NxTrigger*)destination.trigger)->getPos().z());
-                    if((patternArgument.contains("trigger_value_x")) && (((NxCursor*)destination.cursor)))
-                        messageScriptValue.setProperty("trigger_value_x", ((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).x());
-                    if((patternArgument.contains("trigger_value_y")) && (((NxCursor*)destination.cursor)))
-                        messageScriptValue.setProperty("trigger_value_y", ((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).y());
-                    if((patternArgument.contains("trigger_value_z")) && (((NxCursor*)destination.cursor)))
-                        messageScriptValue.setProperty("trigger_value_z", ((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).z());
-                    if(patternArgument.contains("trigger_value"))
-                        messageScriptValue.setProperty("trigger_value", ((NxTrigger*)destination.trigger)->getTrigged());
-                    if(patternArgument.contains("trigger_duration"))
-                        messageScriptValue.setProperty("trigger_duration", ((NxTrigger*)destination.trigger)->getTriggerOff());
-                    if((patternArgument.contains("trigger_distance")) && (((NxCursor*)destination.cursor))) {
-                        NxPoint cursorPosDelta = ((NxTrigger*)destination.trigger)->getPos() - ((NxCursor*)destination.cursor)->getCurrentPos();
-                        messageScriptValue.setProperty("trigger_distance", qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()));
+            if((argument.opcode == MessageArgumentScript) && (messageScriptEngine)) {
+                if(trigger) {
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerId), trigger->getId());
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerGroupId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerGroupId), trigger->getGroupId());
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerLabel))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerLabel), trigger->getLabel());
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerXPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerXPos), trigger->getPos().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerYPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerYPos), trigger->getPos().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerZPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerZPos), trigger->getPos().z());
+                    if((argument.scriptVariables.testBit(MessageArgumentTriggerValueX)) && (cursor))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerValueX), cursor->getCursorValue(trigger->getPos()).x());
+                    if((argument.scriptVariables.testBit(MessageArgumentTriggerValueY)) && (cursor))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerValueY), cursor->getCursorValue(trigger->getPos()).y());
+                    if((argument.scriptVariables.testBit(MessageArgumentTriggerValueZ)) && (cursor))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerValueZ), cursor->getCursorValue(trigger->getPos()).z());
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerValue))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerValue), trigger->getTrigged());
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerDuration))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerDuration), trigger->getTriggerOff());
+                    if((argument.scriptVariables.testBit(MessageArgumentTriggerDistance)) && (cursor)) {
+                        NxPoint cursorPosDelta = trigger->getPos() - cursor->getCurrentPos();
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerDistance), qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()));
                     }
-                    if((patternArgument.contains("trigger_side")) && (((NxCursor*)destination.cursor))) {
-                        qreal cursorAngle = fmod(((NxCursor*)destination.cursor)->getCurrentAngle().z(), 360);
+                    if((argument.scriptVariables.testBit(MessageArgumentTriggerSide)) && (cursor)) {
+                        qreal cursorAngle = fmod(cursor->getCurrentAngle().z(), 360);
                         float side = 0;
                         if(cursorAngle == 90) //cursor going straight up
-                            side = (((NxTrigger*)destination.trigger)->getPos().x() > ((NxCursor*)destination.cursor)->getCurrentPos().x()) ? 1:0;
+                            side = (trigger->getPos().x() > cursor->getCurrentPos().x()) ? 1:0;
                         else if (cursorAngle == 270) //cursor going straight down
-                            side = (((NxTrigger*)destination.trigger)->getPos().x() > ((NxCursor*)destination.cursor)->getCurrentPos().x()) ? 0:1;
+                            side = (trigger->getPos().x() > cursor->getCurrentPos().x()) ? 0:1;
                         else if(((0<cursorAngle) && (cursorAngle<90)) || ((270<cursorAngle) && (cursorAngle<360)) ) //cursor going to left
-                            side = (((NxTrigger*)destination.trigger)->getPos().y() > ((NxCursor*)destination.cursor)->getCurrentPos().y()) ? 1:0;
+                            side = (trigger->getPos().y() > cursor->getCurrentPos().y()) ? 1:0;
                         else //cursor going to right
-                            side = (((NxTrigger*)destination.trigger)->getPos().y() > ((NxCursor*)destination.cursor)->getCurrentPos().y()) ? 0:1;
-                        messageScriptValue.setProperty("trigger_side", side);
+                            side = (trigger->getPos().y() > cursor->getCurrentPos().y()) ? 0:1;
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerSide), side);
                     }
-                    if(patternArgument.contains("trigger_message_id"))
-                        messageScriptValue.setProperty("trigger_message_id", (quint32)((NxTrigger*)destination.trigger)->getMessageId());
+                    if(argument.scriptVariables.testBit(MessageArgumentTriggerMessageId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentTriggerMessageId), (quint32)trigger->getMessageId());
                 }
-                if(((NxCursor*)destination.cursor)) {
-                    if(patternArgument.contains("cursor_id"))
-                        messageScriptValue.setProperty("cursor_id", ((NxCursor*)destination.cursor)->getId());
-                    if(patternArgument.contains("cursor_group_id"))
-                        messageScriptValue.setProperty("cursor_group_id", ((NxCursor*)destination.cursor)->getGroupId());
-                    if(patternArgument.contains("cursor_label"))
-                        messageScriptValue.setProperty("cursor_label", ((NxCursor*)destination.cursor)->getLabel());
-
-                    if(patternArgument.contains("cursor_xPos"))
-                        messageScriptValue.setProperty("cursor_xPos", ((NxCursor*)destination.cursor)->getCurrentPos().x());
-                    if(patternArgument.contains("cursor_yPos"))
-                        messageScriptValue.setProperty("cursor_yPos", ((NxCursor*)destination.cursor)->getCurrentPos().y());
-                    if(patternArgument.contains("cursor_zPos"))
-                        messageScriptValue.setProperty("cursor_zPos", ((NxCursor*)destination.cursor)->getCurrentPos().z());
-                    if(patternArgument.contains("cursor_value_x"))
-                        messageScriptValue.setProperty("cursor_value_x", ((NxCursor*)destination.cursor)->getCurrentValue().x());
-                    if(patternArgument.contains("cursor_value_y"))
-                        messageScriptValue.setProperty("cursor_value_y", ((NxCursor*)destination.cursor)->getCurrentValue().y());
-                    if(patternArgument.contains("cursor_value_z"))
-                        messageScriptValue.setProperty("cursor_value_z", ((NxCursor*)destination.cursor)->getCurrentValue().z());
-
-                    if(patternArgument.contains("cursor_aPos"))
-                        messageScriptValue.setProperty("cursor_aPos", ((NxCursor*)destination.cursor)->getCurrentAed().x());
-                    if(patternArgument.contains("cursor_ePos"))
-                        messageScriptValue.setProperty("cursor_ePos", ((NxCursor*)destination.cursor)->getCurrentAed().y());
-                    if(patternArgument.contains("cursor_dPos"))
-                        messageScriptValue.setProperty("cursor_dPos", ((NxCursor*)destination.cursor)->getCurrentAed().z());
-                    if(patternArgument.contains("cursor_value_a"))
-                        messageScriptValue.setProperty("cursor_value_a", ((NxCursor*)destination.cursor)->getCurrentValueAed().x());
-                    if(patternArgument.contains("cursor_value_e"))
-                        messageScriptValue.setProperty("cursor_value_e", ((NxCursor*)destination.cursor)->getCurrentValueAed().y());
-                    if(patternArgument.contains("cursor_value_d"))
-                        messageScriptValue.setProperty("cursor_value_d", ((NxCursor*)destination.cursor)->getCurrentValueAed().z());
-
-                    if(patternArgument.contains("cursor_sxPos"))
-                        messageScriptValue.setProperty("cursor_sxPos", ((NxCursor*)destination.cursor)->getCurrentPos().sx());
-                    if(patternArgument.contains("cursor_syPos"))
-                        messageScriptValue.setProperty("cursor_syPos", ((NxCursor*)destination.cursor)->getCurrentPos().sy());
-                    if(patternArgument.contains("cursor_szPos"))
-                        messageScriptValue.setProperty("cursor_szPos", ((NxCursor*)destination.cursor)->getCurrentPos().sz());
-                    if(patternArgument.contains("cursor_value_sx"))
-                        messageScriptValue.setProperty("cursor_value_sx", ((NxCursor*)destination.cursor)->getCurrentValue().sx());
-                    if(patternArgument.contains("cursor_value_sy"))
-                        messageScriptValue.setProperty("cursor_value_sy", ((NxCursor*)destination.cursor)->getCurrentValue().sy());
-                    if(patternArgument.contains("cursor_value_sz"))
-                        messageScriptValue.setProperty("cursor_value_sz", ((NxCursor*)destination.cursor)->getCurrentValue().sz());
-                    if(patternArgument.contains("cursor_time"))
-                        messageScriptValue.setProperty("cursor_time", ((NxCursor*)destination.cursor)->getTimeLocal());
-                    if(patternArgument.contains("cursor_time_percent"))
-                        messageScriptValue.setProperty("cursor_time_percent", ((NxCursor*)destination.cursor)->getTimeLocalPercent());
-                    if(patternArgument.contains("cursor_angle"))
-                        messageScriptValue.setProperty("cursor_angle", fmod(((NxCursor*)destination.cursor)->getCurrentAngle().z(), 360));
-
-                    if(patternArgument.contains("cursor_xPos_delta"))
-                        messageScriptValue.setProperty("cursor_xPos_delta",     ((NxCursor*)destination.cursor)->getCurrentPos().x()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().x());
-                    if(patternArgument.contains("cursor_yPos_delta"))
-                        messageScriptValue.setProperty("cursor_yPos_delta",     ((NxCursor*)destination.cursor)->getCurrentPos().y()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().y());
-                    if(patternArgument.contains("cursor_zPos_delta"))
-                        messageScriptValue.setProperty("cursor_zPos_delta",     ((NxCursor*)destination.cursor)->getCurrentPos().z()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().z());
-                    if(patternArgument.contains("cursor_value_x_delta"))
-                        messageScriptValue.setProperty("cursor_value_x_delta",  ((NxCursor*)destination.cursor)->getCurrentValue().x()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().x());
-                    if(patternArgument.contains("cursor_value_y_delta"))
-                        messageScriptValue.setProperty("cursor_value_y_delta",  ((NxCursor*)destination.cursor)->getCurrentValue().y()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().y());
-                    if(patternArgument.contains("cursor_value_z_delta"))
-                        messageScriptValue.setProperty("cursor_value_z_delta",  ((NxCursor*)destination.cursor)->getCurrentValue().z()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().z());
-
-                    if(patternArgument.contains("cursor_aPos_delta"))
-                        messageScriptValue.setProperty("cursor_aPos_delta",     ((NxCursor*)destination.cursor)->getCurrentAed().x()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().x());
-                    if(patternArgument.contains("cursor_ePos_delta"))
-                        messageScriptValue.setProperty("cursor_ePos_delta",     ((NxCursor*)destination.cursor)->getCurrentAed().y()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().y());
-                    if(patternArgument.contains("cursor_dPos_delta"))
-                        messageScriptValue.setProperty("cursor_dPos_delta",     ((NxCursor*)destination.cursor)->getCurrentAed().z()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().z());
-                    if(patternArgument.contains("cursor_value_a_delta"))
-                        messageScriptValue.setProperty("cursor_value_a_delta",  ((NxCursor*)destination.cursor)->getCurrentValueAed().x()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().x());
-                    if(patternArgument.contains("cursor_value_e_delta"))
-                        messageScriptValue.setProperty("cursor_value_e_delta",  ((NxCursor*)destination.cursor)->getCurrentValueAed().y()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().y());
-                    if(patternArgument.contains("cursor_value_d_delta"))
-                        messageScriptValue.setProperty("cursor_value_d_delta",  ((NxCursor*)destination.cursor)->getCurrentValueAed().z()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().z());
-
-                    if(patternArgument.contains("cursor_sxPos_delta"))
-                        messageScriptValue.setProperty("cursor_sxPos_delta",    ((NxCursor*)destination.cursor)->getCurrentPos().sx()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sx());
-                    if(patternArgument.contains("cursor_syPos_delta"))
-                        messageScriptValue.setProperty("cursor_syPos_delta",    ((NxCursor*)destination.cursor)->getCurrentPos().sy()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sy());
-                    if(patternArgument.contains("cursor_szPos_delta"))
-                        messageScriptValue.setProperty("cursor_szPos_delta",    ((NxCursor*)destination.cursor)->getCurrentPos().sz()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sz());
-                    if(patternArgument.contains("cursor_value_sx_delta"))
-                        messageScriptValue.setProperty("cursor_value_sx_delta", ((NxCursor*)destination.cursor)->getCurrentValue().sx() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sx());
-                    if(patternArgument.contains("cursor_value_sy_delta"))
-                        messageScriptValue.setProperty("cursor_value_sy_delta", ((NxCursor*)destination.cursor)->getCurrentValue().sy() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sy());
-                    if(patternArgument.contains("cursor_value_sz_delta"))
-                        messageScriptValue.setProperty("cursor_value_sz_delta", ((NxCursor*)destination.cursor)->getCurrentValue().sz() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sz());
-                    if(patternArgument.contains("cursor_time_delta"))
-                        messageScriptValue.setProperty("cursor_time_delta",         ((NxCursor*)destination.cursor)->getTimeLocal()        - ((NxCursor*)destination.cursor)->getTimeLocalLastSend());
-                    if(patternArgument.contains("cursor_time_percent_delta"))
-                        messageScriptValue.setProperty("cursor_time_percent_delta", ((NxCursor*)destination.cursor)->getTimeLocalPercent() - ((NxCursor*)destination.cursor)->getTimeLocalPercentLastSend());
-                    if(patternArgument.contains("cursor_angle_delta"))
-                        messageScriptValue.setProperty("cursor_angle_delta",        ((NxCursor*)destination.cursor)->getCurrentAngle().z() - ((NxCursor*)destination.cursor)->getCurrentAngleLastSend().z());
-
-                    if(patternArgument.contains("cursor_nb_loop"))
-                        messageScriptValue.setProperty("cursor_nb_loop", ((NxCursor*)destination.cursor)->getNbLoop());
-                    if(patternArgument.contains("cursor_message_id"))
-                        messageScriptValue.setProperty("cursor_message_id", (quint32)((NxCursor*)destination.cursor)->getMessageId());
+                if(cursor) {
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorId), cursor->getId());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorGroupId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorGroupId), cursor->getGroupId());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorLabel))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorLabel), cursor->getLabel());
+
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorXPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorXPos), cursor->getCurrentPos().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorYPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorYPos), cursor->getCurrentPos().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorZPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorZPos), cursor->getCurrentPos().z());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueX))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueX), cursor->getCurrentValue().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueY))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueY), cursor->getCurrentValue().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueZ))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueZ), cursor->getCurrentValue().z());
+
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorAPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorAPos), cursor->getCurrentAed().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorEPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorEPos), cursor->getCurrentAed().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorDPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorDPos), cursor->getCurrentAed().z());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueA))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueA), cursor->getCurrentValueAed().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueE))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueE), cursor->getCurrentValueAed().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueD))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueD), cursor->getCurrentValueAed().z());
+
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorSxPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorSxPos), cursor->getCurrentPos().sx());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorSyPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorSyPos), cursor->getCurrentPos().sy());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorSzPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorSzPos), cursor->getCurrentPos().sz());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueSx))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueSx), cursor->getCurrentValue().sx());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueSy))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueSy), cursor->getCurrentValue().sy());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueSz))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueSz), cursor->getCurrentValue().sz());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorTime))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorTime), cursor->getTimeLocal());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorTimePercent))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorTimePercent), cursor->getTimeLocalPercent());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorAngle))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorAngle), fmod(cursor->getCurrentAngle().z(), 360));
+
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorXPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorXPosDelta),     cursor->getCurrentPos().x()    - cursor->getCurrentPosLastSend().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorYPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorYPosDelta),     cursor->getCurrentPos().y()    - cursor->getCurrentPosLastSend().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorZPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorZPosDelta),     cursor->getCurrentPos().z()    - cursor->getCurrentPosLastSend().z());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueXDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueXDelta),  cursor->getCurrentValue().x()  - cursor->getCurrentValueLastSend().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueYDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueYDelta),  cursor->getCurrentValue().y()  - cursor->getCurrentValueLastSend().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueZDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueZDelta),  cursor->getCurrentValue().z()  - cursor->getCurrentValueLastSend().z());
+
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorAPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorAPosDelta),     cursor->getCurrentAed().x()    - cursor->getCurrentAedLastSend().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorEPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorEPosDelta),     cursor->getCurrentAed().y()    - cursor->getCurrentAedLastSend().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorDPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorDPosDelta),     cursor->getCurrentAed().z()    - cursor->getCurrentAedLastSend().z());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueADelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueADelta),  cursor->getCurrentValueAed().x()  - cursor->getCurrentValueAedLastSend().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueEDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueEDelta),  cursor->getCurrentValueAed().y()  - cursor->getCurrentValueAedLastSend().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueDDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueDDelta),  cursor->getCurrentValueAed().z()  - cursor->getCurrentValueAedLastSend().z());
+
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorSxPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorSxPosDelta),    cursor->getCurrentPos().sx()   - cursor->getCurrentPosLastSend().sx());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorSyPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorSyPosDelta),    cursor->getCurrentPos().sy()   - cursor->getCurrentPosLastSend().sy());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorSzPosDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorSzPosDelta),    cursor->getCurrentPos().sz()   - cursor->getCurrentPosLastSend().sz());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueSxDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueSxDelta), cursor->getCurrentValue().sx() - cursor->getCurrentValueLastSend().sx());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueSyDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueSyDelta), cursor->getCurrentValue().sy() - cursor->getCurrentValueLastSend().sy());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorValueSzDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorValueSzDelta), cursor->getCurrentValue().sz() - cursor->getCurrentValueLastSend().sz());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorTimeDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorTimeDelta),         cursor->getTimeLocal()        - cursor->getTimeLocalLastSend());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorTimePercentDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorTimePercentDelta), cursor->getTimeLocalPercent() - cursor->getTimeLocalPercentLastSend());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorAngleDelta))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorAngleDelta),        cursor->getCurrentAngle().z() - cursor->getCurrentAngleLastSend().z());
+
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorNbLoop))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorNbLoop), cursor->getNbLoop());
+                    if(argument.scriptVariables.testBit(MessageArgumentCursorMessageId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCursorMessageId), (quint32)cursor->getMessageId());
                 }
-                if(((NxCurve*)destination.curve)) {
-                    if(patternArgument.contains("curve_id"))
-                        messageScriptValue.setProperty("curve_id", ((NxCurve*)destination.curve)->getId());
-                    if(patternArgument.contains("curve_group_id"))
-                        messageScriptValue.setProperty("curve_group_id", ((NxCurve*)destination.curve)->getGroupId());
-                    if(patternArgument.contains("curve_label"))
-                        messageScriptValue.setProperty("curve_label", ((NxCurve*)destination.curve)->getLabel());
-                    if(patternArgument.contains("curve_xPos"))
-                        messageScriptValue.setProperty("curve_xPos", ((NxCurve*)destination.curve)->getPos().x());
-                    if(patternArgument.contains("curve_yPos"))
-                        messageScriptValue.setProperty("curve_yPos", ((NxCurve*)destination.curve)->getPos().y());
-                    if(patternArgument.contains("curve_zPos"))
-                        messageScriptValue.setProperty("curve_zPos", ((NxCurve*)destination.curve)->getPos().z());
+                if(curve) {
+                    if(argument.scriptVariables.testBit(MessageArgumentCurveId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCurveId), curve->getId());
+                    if(argument.scriptVariables.testBit(MessageArgumentCurveGroupId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCurveGroupId), curve->getGroupId());
+                    if(argument.scriptVariables.testBit(MessageArgumentCurveLabel))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCurveLabel), curve->getLabel());
+                    if(argument.scriptVariables.testBit(MessageArgumentCurveXPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCurveXPos), curve->getPos().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCurveYPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCurveYPos), curve->getPos().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCurveZPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCurveZPos), curve->getPos().z());
                 }
-                if(((NxCurve*)destination.collisionCurve)) {
-                    if(patternArgument.contains("collision_curve_id"))
-                        messageScriptValue.setProperty("collision_curve_id", ((NxCurve*)destination.collisionCurve)->getId());
-                    if(patternArgument.contains("collision_curve_group_id"))
-                        messageScriptValue.setProperty("collision_curve_group_id", ((NxCurve*)destination.collisionCurve)->getGroupId());
-                    if(patternArgument.contains("collision_curve_label"))
-                        messageScriptValue.setProperty("collision_curve_label", ((NxCurve*)destination.collisionCurve)->getLabel());
-                    if(patternArgument.contains("collision_curve_xPos"))
-                        messageScriptValue.setProperty("collision_curve_xPos", ((NxCurve*)destination.collisionCurve)->getPos().x());
-                    if(patternArgument.contains("collision_curve_yPos"))
-                        messageScriptValue.setProperty("collision_curve_yPos", ((NxCurve*)destination.collisionCurve)->getPos().y());
-                    if(patternArgument.contains("collision_curve_zPos"))
-                        messageScriptValue.setProperty("collision_curve_zPos", ((NxCurve*)destination.collisionCurve)->getPos().z());
-                    if(patternArgument.contains("collision_xPos"))
-                        messageScriptValue.setProperty("collision_xPos", destination.collisionPoint.x());
-                    if(patternArgument.contains("collision_yPos"))
-                        messageScriptValue.setProperty("collision_yPos", destination.collisionPoint.y());
-                    if(patternArgument.contains("collision_zPos"))
-                        messageScriptValue.setProperty("collision_zPos", destination.collisionPoint.z());
-                    if(patternArgument.contains("collision_value_x"))
-                        messageScriptValue.setProperty("collision_value_x", destination.collisionValue.x());
-                    if(patternArgument.contains("collision_value_y"))
-                        messageScriptValue.setProperty("collision_value_y", destination.collisionValue.y());
-                    if(patternArgument.contains("collision_value_z"))
-                        messageScriptValue.setProperty("collision_value_z", destination.collisionValue.z());
-                    if((patternArgument.contains("collision_distance")) && (((NxCursor*)destination.cursor))) {
-                        NxPoint cursorPosDelta = (((NxCursor*)destination.cursor))?(destination.collisionPoint - ((NxCursor*)destination.cursor)->getCurrentPos()):(NxPoint());
-                        messageScriptValue.setProperty("collision_distance", qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()));
+                if(collisionCurve) {
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionCurveId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionCurveId), collisionCurve->getId());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionCurveGroupId))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionCurveGroupId), collisionCurve->getGroupId());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionCurveLabel))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionCurveLabel), collisionCurve->getLabel());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionCurveXPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionCurveXPos), collisionCurve->getPos().x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionCurveYPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionCurveYPos), collisionCurve->getPos().y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionCurveZPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionCurveZPos), collisionCurve->getPos().z());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionXPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionXPos), destination.collisionPoint.x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionYPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionYPos), destination.collisionPoint.y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionZPos))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionZPos), destination.collisionPoint.z());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionValueX))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionValueX), destination.collisionValue.x());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionValueY))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionValueY), destination.collisionValue.y());
+                    if(argument.scriptVariables.testBit(MessageArgumentCollisionValueZ))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionValueZ), destination.collisionValue.z());
+                    if((argument.scriptVariables.testBit(MessageArgumentCollisionDistance)) && (cursor)) {
+                        NxPoint cursorPosDelta = (cursor)?(destination.collisionPoint - cursor->getCurrentPos()):(NxPoint());
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentCollisionDistance), qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()));
                     }
                 }
                 {
-                    if(patternArgument.contains("status")) {
-                        messageScriptValue.setProperty("status", destination.status.status);
+                    if(argument.scriptVariables.testBit(MessageArgumentStatus)) {
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentStatus), destination.status.status);
                         isTransportMessage = true;
                     }
-                    if(patternArgument.contains("nb_triggers"))
-                        messageScriptValue.setProperty("nb_triggers", destination.status.nbTriggers);
-                    if(patternArgument.contains("nb_cursors"))
-                        messageScriptValue.setProperty("nb_cursors", destination.status.nbCursors);
-                    if(patternArgument.contains("nb_curves"))
-                        messageScriptValue.setProperty("nb_curves", destination.status.nbCurves);
-                    if(patternArgument.contains("global_time"))
-                        messageScriptValue.setProperty("global_time", Transport::timeLocal);
-                    if(patternArgument.contains("global_time_verbose"))
-                        messageScriptValue.setProperty("global_time_verbose", Transport::getTimeLocalStr());
+                    if(argument.scriptVariables.testBit(MessageArgumentNbTriggers))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentNbTriggers), destination.status.nbTriggers);
+                    if(argument.scriptVariables.testBit(MessageArgumentNbCursors))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentNbCursors), destination.status.nbCursors);
+                    if(argument.scriptVariables.testBit(MessageArgumentNbCurves))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentNbCurves), destination.status.nbCurves);
+                    if(argument.scriptVariables.testBit(MessageArgumentGlobalTime))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentGlobalTime), Transport::timeLocal);
+                    if(argument.scriptVariables.testBit(MessageArgumentGlobalTimeVerbose))
+                        messageScriptValue.setProperty(messageScriptNames.at(MessageArgumentGlobalTimeVerbose), Transport::getTimeLocalStr());
                 }
 
-                messageScriptResult = messageScriptEngine->evaluate(patternArgument);
+                messageScriptResult = messageScriptEngine->evaluate(argument.program);
+                Transport::perfScriptEvaluationCounter++;
                 if(messageScriptResult.isError())
-                    addString("**error**", patternArgument, patternIndex);
+                    addString("**error**", argument.name, patternIndex);
                 else if(messageScriptResult.isString()) {
                     if(messageScriptResult.toString() == "suppress")
                         suppressSend = true;
                     else
-                        found = addString(messageScriptResult.toString(), QString("script %1").arg(patternIndex), patternIndex);
+                        found = addString(messageScriptResult.toString(), argument.scriptName, patternIndex);
                 }
                 else
-                    found = addFloat(messageScriptResult.toNumber(), QString("script %1").arg(patternIndex), patternIndex);
-
-
+                    found = addFloat(messageScriptResult.toNumber(), argument.scriptName, patternIndex);
             }
             else {
-                if(((NxTrigger*)destination.trigger)) {
-                    if(patternArgument == "trigger_id")
-                        found = addFloat(((NxTrigger*)destination.trigger)->getId(), patternArgument, patternIndex);
-                    else if(patternArgument == "trigger_group_id")
-                        found = addString(((NxTrigger*)destination.trigger)->getGroupId(), patternArgument, patternIndex);
-                    else if(patternArgument == "trigger_label")
-                        found = addString(((NxTrigger*)destination.trigger)->getLabel(), patternArgument, patternIndex);
-                    else if(patternArgument == "trigger_xPos")
-                        found = addFloat(((NxTrigger*)destination.trigger)->getPos().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "trigger_yPos")
-                        found = addFloat(((NxTrigger*)destination.trigger)->getPos().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "trigger_zPos")
-                        found = addFloat(((NxTrigger*)destination.trigger)->getPos().z(), patternArgument, patternIndex);
-                    else if((patternArgument == "trigger_value_x") && (((NxCursor*)destination.cursor)))
-                        found = addFloat(((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).x(), patternArgument, patternIndex);
-                    else if((patternArgument == "trigger_value_y") && (((NxCursor*)destination.cursor)))
-                        found = addFloat(((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).y(), patternArgument, patternIndex);
-                    else if((patternArgument == "trigger_value_z") && (((NxCursor*)destination.cursor)))
-                        found = addFloat(((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).z(), patternArgument, patternIndex);
-                    else if(patternArgument == "trigger_value")
-                        found = addFloat(((NxTrigger*)destination.trigger)->getTrigged(), patternArgument, patternIndex);
-                    else if(patternArgument == "trigger_duration")
-                        found = addFloat(((NxTrigger*)destination.trigger)->getTriggerOff(), patternArgument, patternIndex);
-                    else if((patternArgument == "trigger_distance") && (((NxCursor*)destination.cursor))) {
-                        NxPoint cursorPosDelta = ((NxTrigger*)destination.trigger)->getPos() - ((NxCursor*)destination.cursor)->getCurrentPos();
-                        found = addFloat(qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()), patternArgument, patternIndex);
+                switch(argument.opcode) {
+                case MessageArgumentTriggerId:
+                    if(trigger)
+                        found = addFloat(trigger->getId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerGroupId:
+                    if(trigger)
+                        found = addString(trigger->getGroupId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerLabel:
+                    if(trigger)
+                        found = addString(trigger->getLabel(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerXPos:
+                    if(trigger)
+                        found = addFloat(trigger->getPos().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerYPos:
+                    if(trigger)
+                        found = addFloat(trigger->getPos().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerZPos:
+                    if(trigger)
+                        found = addFloat(trigger->getPos().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerValueX:
+                    if((trigger) && (cursor))
+                        found = addFloat(cursor->getCursorValue(trigger->getPos()).x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerValueY:
+                    if((trigger) && (cursor))
+                        found = addFloat(cursor->getCursorValue(trigger->getPos()).y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerValueZ:
+                    if((trigger) && (cursor))
+                        found = addFloat(cursor->getCursorValue(trigger->getPos()).z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerValue:
+                    if(trigger)
+                        found = addFloat(trigger->getTrigged(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerDuration:
+                    if(trigger)
+                        found = addFloat(trigger->getTriggerOff(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerDistance:
+                    if((trigger) && (cursor)) {
+                        NxPoint cursorPosDelta = trigger->getPos() - cursor->getCurrentPos();
+                        found = addFloat(qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()), argument.name, patternIndex);
                     }
-                    else if(patternArgument == "trigger_message_id")
-                        found = addFloat(((NxTrigger*)destination.trigger)->getMessageId(), patternArgument, patternIndex);
-                    else if((patternArgument == "trigger_side") && (((NxCursor*)destination.cursor))) {
-                        qreal cursorAngle = fmod(((NxCursor*)destination.cursor)->getCurrentAngle().z(), 360);
+                    break;
+                case MessageArgumentTriggerMessageId:
+                    if(trigger)
+                        found = addFloat(trigger->getMessageId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentTriggerSide:
+                    if((trigger) && (cursor)) {
+                        qreal cursorAngle = fmod(cursor->getCurrentAngle().z(), 360);
                         float side = 0;
                         if(cursorAngle == 90 ) //cursor going straight up
-                            side = (((NxTrigger*)destination.trigger)->getPos().x() > ((NxCursor*)destination.cursor)->getCurrentPos().x()) ? 1:0;
+                            side = (trigger->getPos().x() > cursor->getCurrentPos().x()) ? 1:0;
                         else if (cursorAngle == 270) //cursor going straight down
-                            side = (((NxTrigger*)destination.trigger)->getPos().x() > ((NxCursor*)destination.cursor)->getCurrentPos().x()) ? 0:1;
+                            side = (trigger->getPos().x() > cursor->getCurrentPos().x()) ? 0:1;
                         else if(((0<cursorAngle) && (cursorAngle<90)) || ((270<cursorAngle) && (cursorAngle<360)) ) //cursor going to left
-                            side = (((NxTrigger*)destination.trigger)->getPos().y() > ((NxCursor*)destination.cursor)->getCurrentPos().y()) ? 1:0;
+                            side = (trigger->getPos().y() > cursor->getCurrentPos().y()) ? 1:0;
                         else //cursor going to right
-                            side = (((NxTrigger*)destination.trigger)->getPos().y() > ((NxCursor*)destination.cursor)->getCurrentPos().y()) ? 0:1;
-                        found = addFloat(side, patternArgument, patternIndex);
-                    }
-                }
-                if(((NxCursor*)destination.cursor)) {
-                    if(patternArgument == "cursor_id")
-                        found = addFloat(((NxCursor*)destination.cursor)->getId(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_group_id")
-                        found = addString(((NxCursor*)destination.cursor)->getGroupId(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_label")
-                        found = addString(((NxCursor*)destination.cursor)->getLabel(), patternArgument, patternIndex);
-
-                    else if(patternArgument == "cursor_sxPos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sx(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_syPos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sy(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_szPos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sz(), patternArgument, patternIndex);
-
-                    else if(patternArgument == "cursor_value_sx")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sx(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_sy")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sy(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_sz")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sz(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_time")
-                        found = addFloat(((NxCursor*)destination.cursor)->getTimeLocal(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_time_percent")
-                        found = addFloat(((NxCursor*)destination.cursor)->getTimeLocalPercent(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_angle")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAngle().z(), patternArgument, patternIndex);
-
-                    else if(patternArgument == "cursor_xPos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_yPos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_zPos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().z(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_x")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_y")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_z")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().z(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_xPos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().x()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_yPos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().y()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_zPos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().z()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().z(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_x_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().x()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_y_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().y()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_z_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().z()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().z(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_sx_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sx() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sx(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_sy_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sy() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sy(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_sz_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sz() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sz(), patternArgument, patternIndex);
-
-                    else if(patternArgument == "cursor_aPos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_ePos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_dPos")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().z(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_a")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_e")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_d")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().z(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_aPos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().x()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_ePos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().y()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_dPos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().z()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().z(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_a_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().x()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_e_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().y()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_d_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().z()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().z(), patternArgument, patternIndex);
-
-                    else if(patternArgument == "cursor_value_sx_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sx() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sx(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_sy_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sy() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sy(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_value_sz_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sz() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sz(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_sxPos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sx()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sx(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_syPos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sy()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sy(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_szPos_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sz()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sz(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_time_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getTimeLocal()         - ((NxCursor*)destination.cursor)->getTimeLocalLastSend(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_time_percent_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getTimeLocalPercent()  - ((NxCursor*)destination.cursor)->getTimeLocalPercentLastSend(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_angle_delta")
-                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAngle().z()  - ((NxCursor*)destination.cursor)->getCurrentAngleLastSend().z(), patternArgument, patternIndex);
-
-                    else if(patternArgument == "cursor_nb_loop")
-                        found = addFloat(((NxCursor*)destination.cursor)->getNbLoop(), patternArgument, patternIndex);
-                    else if(patternArgument == "cursor_message_id")
-                        found = addFloat(((NxCursor*)destination.cursor)->getMessageId(), patternArgument, patternIndex);
-                }
-                if(((NxCurve*)destination.curve)) {
-                    if(patternArgument == "curve_id")
-                        found = addFloat(((NxCurve*)destination.curve)->getId(), patternArgument, patternIndex);
-                    else if(patternArgument == "curve_group_id")
-                        found = addString(((NxCurve*)destination.curve)->getGroupId(), patternArgument, patternIndex);
-                    else if(patternArgument == "curve_label")
-                        found = addString(((NxCurve*)destination.curve)->getLabel(), patternArgument, patternIndex);
-                    else if(patternArgument == "curve_xPos")
-                        found = addFloat(((NxCurve*)destination.curve)->getPos().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "curve_yPos")
-                        found = addFloat(((NxCurve*)destination.curve)->getPos().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "curve_zPos")
-                        found = addFloat(((NxCurve*)destination.curve)->getPos().z(), patternArgument, patternIndex);
-                }
-                if(((NxCurve*)destination.collisionCurve)) {
-                    if(patternArgument == "collision_curve_id")
-                        found = addFloat(((NxCurve*)destination.collisionCurve)->getId(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_curve_group_id")
-                        found = addString(((NxCurve*)destination.collisionCurve)->getGroupId(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_curve_label")
-                        found = addString(((NxCurve*)destination.collisionCurve)->getLabel(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_curve_xPos")
-                        found = addFloat(((NxCurve*)destination.collisionCurve)->getPos().x(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_curve_yPos")
-                        found = addFloat(((NxCurve*)destination.collisionCurve)->getPos().y(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_curve_zPos")
-                        found = addFloat(((NxCurve*)destination.collisionCurve)->getPos().z(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_xPos")
-                        found = addFloat(destination.collisionPoint.x(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_yPos")
-                        found = addFloat(destination.collisionPoint.y(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_zPos")
-                        found = addFloat(destination.collisionPoint.z(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_value_x")
-                        found = addFloat(destination.collisionValue.x(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_value_y")
-                        found = addFloat(destination.collisionValue.y(), patternArgument, patternIndex);
-                    else if(patternArgument == "collision_value_z")
-                        found = addFloat(destination.collisionValue.z(), patternArgument, patternIndex);
-                    else if((patternArgument == "collision_distance") && (((NxCursor*)destination.cursor))) {
-                        NxPoint cursorPosDelta = destination.collisionPoint - ((NxCursor*)destination.cursor)->getCurrentPos();
-                        found = addFloat(qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()), patternArgument, patternIndex);
+                            side = (trigger->getPos().y() > cursor->getCurrentPos().y()) ? 0:1;
+                        found = addFloat(side, argument.name, patternIndex);
                     }
-                }
-                {
-                    if(patternArgument == "timetag")
-                        found = addTimeTag(generateTimeTag(), patternArgument, patternIndex);
-                    else if(patternArgument == "status") {
-                        found = addString(destination.status.status, patternArgument, patternIndex);
-                        isTransportMessage = true;
+                    break;
+                case MessageArgumentCursorId:
+                    if(cursor)
+                        found = addFloat(cursor->getId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorGroupId:
+                    if(cursor)
+                        found = addString(cursor->getGroupId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorLabel:
+                    if(cursor)
+                        found = addString(cursor->getLabel(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorSxPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().sx(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorSyPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().sy(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorSzPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().sz(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueSx:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().sx(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueSy:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().sy(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueSz:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().sz(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorTime:
+                    if(cursor)
+                        found = addFloat(cursor->getTimeLocal(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorTimePercent:
+                    if(cursor)
+                        found = addFloat(cursor->getTimeLocalPercent(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorAngle:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentAngle().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorXPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorYPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorZPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueX:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueY:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueZ:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorXPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().x()    - cursor->getCurrentPosLastSend().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorYPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().y()    - cursor->getCurrentPosLastSend().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorZPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().z()    - cursor->getCurrentPosLastSend().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueXDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().x()  - cursor->getCurrentValueLastSend().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueYDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().y()  - cursor->getCurrentValueLastSend().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueZDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().z()  - cursor->getCurrentValueLastSend().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueSxDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().sx() - cursor->getCurrentValueLastSend().sx(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueSyDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().sy() - cursor->getCurrentValueLastSend().sy(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueSzDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValue().sz() - cursor->getCurrentValueLastSend().sz(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorAPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentAed().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorEPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentAed().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorDPos:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentAed().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueA:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValueAed().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueE:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValueAed().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueD:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValueAed().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorAPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentAed().x()    - cursor->getCurrentAedLastSend().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorEPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentAed().y()    - cursor->getCurrentAedLastSend().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorDPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentAed().z()    - cursor->getCurrentAedLastSend().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueADelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValueAed().x()  - cursor->getCurrentValueAedLastSend().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueEDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValueAed().y()  - cursor->getCurrentValueAedLastSend().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorValueDDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentValueAed().z()  - cursor->getCurrentValueAedLastSend().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorSxPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().sx()   - cursor->getCurrentPosLastSend().sx(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorSyPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().sy()   - cursor->getCurrentPosLastSend().sy(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorSzPosDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentPos().sz()   - cursor->getCurrentPosLastSend().sz(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorTimeDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getTimeLocal()         - cursor->getTimeLocalLastSend(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorTimePercentDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getTimeLocalPercent()  - cursor->getTimeLocalPercentLastSend(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorAngleDelta:
+                    if(cursor)
+                        found = addFloat(cursor->getCurrentAngle().z()  - cursor->getCurrentAngleLastSend().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorNbLoop:
+                    if(cursor)
+                        found = addFloat(cursor->getNbLoop(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCursorMessageId:
+                    if(cursor)
+                        found = addFloat(cursor->getMessageId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCurveId:
+                    if(curve)
+                        found = addFloat(curve->getId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCurveGroupId:
+                    if(curve)
+                        found = addString(curve->getGroupId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCurveLabel:
+                    if(curve)
+                        found = addString(curve->getLabel(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCurveXPos:
+                    if(curve)
+                        found = addFloat(curve->getPos().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCurveYPos:
+                    if(curve)
+                        found = addFloat(curve->getPos().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCurveZPos:
+                    if(curve)
+                        found = addFloat(curve->getPos().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionCurveId:
+                    if(collisionCurve)
+                        found = addFloat(collisionCurve->getId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionCurveGroupId:
+                    if(collisionCurve)
+                        found = addString(collisionCurve->getGroupId(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionCurveLabel:
+                    if(collisionCurve)
+                        found = addString(collisionCurve->getLabel(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionCurveXPos:
+                    if(collisionCurve)
+                        found = addFloat(collisionCurve->getPos().x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionCurveYPos:
+                    if(collisionCurve)
+                        found = addFloat(collisionCurve->getPos().y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionCurveZPos:
+                    if(collisionCurve)
+                        found = addFloat(collisionCurve->getPos().z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionXPos:
+                    if(collisionCurve)
+                        found = addFloat(destination.collisionPoint.x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionYPos:
+                    if(collisionCurve)
+                        found = addFloat(destination.collisionPoint.y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionZPos:
+                    if(collisionCurve)
+                        found = addFloat(destination.collisionPoint.z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionValueX:
+                    if(collisionCurve)
+                        found = addFloat(destination.collisionValue.x(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionValueY:
+                    if(collisionCurve)
+                        found = addFloat(destination.collisionValue.y(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionValueZ:
+                    if(collisionCurve)
+                        found = addFloat(destination.collisionValue.z(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentCollisionDistance:
+                    if((collisionCurve) && (cursor)) {
+                        NxPoint cursorPosDelta = destination.collisionPoint - cursor->getCurrentPos();
+                        found = addFloat(qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()), argument.name, patternIndex);
                     }
-                    else if(patternArgument == "nb_triggers")
-                        found = addFloat(destination.status.nbTriggers, patternArgument, patternIndex);
-                    else if(patternArgument == "nb_cursors")
-                        found = addFloat(destination.status.nbCursors, patternArgument, patternIndex);
-                    else if(patternArgument == "nb_curves")
-                        found = addFloat(destination.status.nbCurves, patternArgument, patternIndex);
-                    else if(patternArgument == "global_time")
-                        found = addFloat(Transport::timeLocal, patternArgument, patternIndex);
-                    else if(patternArgument == "global_time_verbose")
-                        found = addString(Transport::getTimeLocalStr(), patternArgument, patternIndex);
+                    break;
+                case MessageArgumentTimetag:
+                    found = addTimeTag(generateTimeTag(), argument.name, patternIndex);
+                    break;
+                case MessageArgumentStatus:
+                    found = addString(destination.status.status, argument.name, patternIndex);
+                    isTransportMessage = true;
+                    break;
+                case MessageArgumentNbTriggers:
+                    found = addFloat(destination.status.nbTriggers, argument.name, patternIndex);
+                    break;
+                case MessageArgumentNbCursors:
+                    found = addFloat(destination.status.nbCursors, argument.name, patternIndex);
+                    break;
+                case MessageArgumentNbCurves:
+                    found = addFloat(destination.status.nbCurves, argument.name, patternIndex);
+                    break;
+                case MessageArgumentGlobalTime:
+                    found = addFloat(Transport::timeLocal, argument.name, patternIndex);
+                    break;
+                case MessageArgumentGlobalTimeVerbose:
+                    found = addString(Transport::getTimeLocalStr(), argument.name, patternIndex);
+                    break;
+                default:
+                    break;
                 }
             }
 
             if(!found) {
-                if(patternArgument.startsWith("collision_"))
+                if((argument.opcode == MessageArgumentScript) && (!messageScriptEngine))
+                    found = addString(argument.pattern, argument.customName, patternIndex);
+                else if(argument.isCollision)
                     suppressSend = true;
-                else if(Help::keywords.contains(patternArgument))
-                    addFloat(-1, patternArgument, patternIndex);
+                else if(argument.isKeyword)
+                    addFloat(-1, argument.name, patternIndex);
                 else {
                     //If value is not a keyword, add raw value
-                    bool ok = false;
-                    qreal val = patternArgument.toDouble(&ok);
-                    if(ok)
-                        found = addFloat(val, QString("custom %1").arg(patternIndex), patternIndex);
+                    if(argument.isNumber)
+                        found = addFloat(argument.number, argument.customName, patternIndex);
                     else
-                        found = addString(patternArgument, QString("custom %1").arg(patternIndex), patternIndex);
+                        found = addString(argument.name, argument.customName, patternIndex);
                 }
             }
         }
 
 
-        if(type == MessagesTypeOsc) {
-            buffer += address;
-            buffer += typetag;
-            buffer += (char)0;
-            pad(buffer);
-            buffer += arguments;
-        }
-        else if((type == MessagesTypeTcp) || (type == MessagesTypeSerial) || (type == MessagesTypeUdp) || (type == MessagesTypeDirect)) {
-            asciiMessage = asciiMessage.trimmed();
-        }
+        encode();
     }
 
     return (hasAdd && !suppressSend);
 }
+void Message::encode() {
+    if(type == MessagesTypeOsc) {
+        buffer += address;
+        buffer += typetag;
+        buffer += (char)0;
+        pad(buffer);
+        buffer += arguments;
+    }
+    else if((type == MessagesTypeTcp) || (type == MessagesTypeSerial) || (type == MessagesTypeUdp) || (type == MessagesTypeDirect)) {
+        asciiMessage = asciiMessage.trimmed();
+    }
+    //OSC stream form of TCP messages, with the same typetags as osc://
+    if(type == MessagesTypeTcp) {
+        buffer += "/" + address;
+        buffer += (char)0;
+        pad(buffer);
+        buffer += typetag;
+        buffer += (char)0;
+        pad(buffer);
+        buffer += arguments;
+    }
+}
+
+//Journal record : type, destination and the payload the interface sends (other forms are rebuilt on load)
+void Message::save(QDataStream &stream) const {
+    QByteArray payload;
+    if((type == MessagesTypeOsc) || (type == MessagesTypeTcp))
+        payload = buffer;
+    else if(type == MessagesTypeHttp)
+        payload = urlMessage.toEncoded();
+    else if((type == MessagesTypeMidi) || (type == MessagesTypeArtnet)) {
+        QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+        payloadStream << midiValues;
+    }
+    else
+        payload = asciiMessage;
+    stream << (quint8)type << urlMessageString << payload;
+}
+void Message::load(QDataStream &stream) {
+    quint8 typeValue = 0;
+    QByteArray destination, payload;
+    stream >> typeValue >> destination >> payload;
+    setUrl(QUrl(QString(destination), QUrl::TolerantMode));
+    type = (MessagesType)typeValue;
+    isTransportMessage = false;
+    midiValues   .clear();
+    verboseValues.clear();
+    buffer       .clear();
+
+    if((type == MessagesTypeOsc) || (type == MessagesTypeTcp)) {
+        //Arguments are decoded from the packet and added again, which rebuilds the text forms and the packet itself
+        qint32 index = 0;
+        loadOscString(payload, index);
+        QByteArray typetags = loadOscString(payload, index);
+        for(quint16 typetagIndex = 1 ; typetagIndex < typetags.count() ; typetagIndex++) {
+            char typetagItem = typetags.at(typetagIndex);
+            if((typetagItem == 'f') && (index + 4 <= payload.size())) {
+                union { float f; quint32 i; } u;
+                u.i = qFromBigEndian<quint32>((const uchar*)payload.constData() + index);
+                addFloat(u.f, "", typetagIndex);
+                index += 4;
+            }
+            else if((typetagItem == 't') && (index + 8 <= payload.size())) {
+                addTimeTag(qFromBigEndian<qint64>((const uchar*)payload.constData() + index), "", typetagIndex);
+                index += 8;
+            }
+            else if((typetagItem == 's') && (index < payload.size()))
+                addString(QString(loadOscString(payload, index)), "", typetagIndex);
+            else
+                break;
+        }
+        encode();
+    }
+    else if(type == MessagesTypeHttp)
+        urlMessage = QUrl::fromEncoded(payload);
+    else if((type == MessagesTypeMidi) || (type == MessagesTypeArtnet)) {
+        QDataStream payloadStream(payload);
+        payloadStream >> midiValues;
+        foreach(qreal midiValue, midiValues)
+            verboseValues << midiValue;
+    }
+    else {
+        asciiMessage = payload;
+        foreach(const QByteArray &asciiItem, asciiMessage.split(' '))
+            if(!asciiItem.isEmpty())
+                verboseValues << QString(asciiItem);
+    }
+}
+//Reads a null-terminated and padded OSC string, and moves index after its padding
+QByteArray Message::loadOscString(const QByteArray &packet, qint32 &index) const {
+    qint32 end = packet.indexOf((char)0, index);
+    if(end < 0)
+        end = packet.size();
+    QByteArray str = packet.mid(index, end - index);
+    index = (end + 4) & ~3;
+    return str;
+}
 
 const QByteArray Message::getVerboseMessage(bool) const {
     if(type == MessagesTypeHttp)
@@ -611,15 +869,41 @@ void Message::addInt(int i, const char *name, quint16) {
         typetag += 'i';
 }
 */
+//OSC encoding of arguments (osc:// messages and the OSC stream form of tcp://)
+void Message::addOscString(const QString &str) {
+    arguments += str;
+    arguments += (char)0;
+    pad(arguments);
+    typetag += 's';
+}
+void Message::addOscFloat(float f) {
+    union { float f; char ch[4]; } u;
+    u.f = f;
+    arguments += u.ch[3];
+    arguments += u.ch[2];
+    arguments += u.ch[1];
+    arguments += u.ch[0];
+    typetag += 'f';
+}
+void Message::addOscTimeTag(qint64 t) {
+    union { qint64 t; char ch[8]; } u;
+    u.t = t;
+    arguments += u.ch[7];
+    arguments += u.ch[6];
+    arguments += u.ch[5];
+    arguments += u.ch[4];
+    arguments += u.ch[3];
+    arguments += u.ch[2];
+    arguments += u.ch[1];
+    arguments += u.ch[0];
+    typetag += 't';
+}
 bool Message::addString(QString str, const QString & name, quint16) {
     str = str.replace("_", " ");
     verboseValues << str;
     hasAdd = true;
     if(type == MessagesTypeOsc) {
-        arguments += str;
-        arguments += (char)0;
-        pad(arguments);
-        typetag += 's';
+        addOscString(str);
         return true;
     }
     else if(type == MessagesTypeHttp) {
@@ -635,6 +919,7 @@ bool Message::addString(QString str, const QString & name, quint16) {
     else if(type == MessagesTypeTcp) {
         asciiMessage    = asciiMessage + " " + qPrintable(str);
         asciiMessageXml = asciiMessageXml + qPrintable("<ARGUMENT TYPE=\"s\" VALUE=\"" + str + "\"/>");
+        addOscString(str);
         return true;
     }
     else if((type == MessagesTypeSerial) || (type == MessagesTypeUdp) || (type == MessagesTypeDirect)) {
@@ -647,13 +932,7 @@ bool Message::addFloat(float f, const QString & name, quint16) {
     verboseValues << f;
     hasAdd = true;
     if(type == MessagesTypeOsc) {
-        union { float f; char ch[4]; } u;
-        u.f = f;
-        arguments += u.ch[3];
-        arguments += u.ch[2];
-        arguments += u.ch[1];
-        arguments += u.ch[0];
-        typetag += 'f';
+        addOscFloat(f);
         return true;
     }
     else if(type == MessagesTypeHttp) {
@@ -669,9 +948,10 @@ bool Message::addFloat(float f, const QString & name, quint16) {
     else if(type == MessagesTypeTcp) {
         asciiMessage    = asciiMessage    + " " + QByteArray::number(f);
         asciiMessageXml = asciiMessageXml + qPrintable("<ARGUMENT TYPE=\"f\" VALUE=\"" + QString::number(f) + "\"/>");
+        addOscFloat(f);
         return true;
     }
-    else if(type == MessagesTypeMidi) {
+    else if((type == MessagesTypeMidi) || (type == MessagesTypeArtnet)) {
         midiValues.append(f);
         return true;
     }
@@ -685,17 +965,7 @@ bool Message::addTimeTag(qint64 t, const QString & name, quint16) {
     verboseValues << t;
     hasAdd = true;
     if(type == MessagesTypeOsc) {
-        union { qint64 t; char ch[8]; } u;
-        u.t = t;
-        arguments += u.ch[7];
-        arguments += u.ch[6];
-        arguments += u.ch[5];
-        arguments += u.ch[4];
-        arguments += u.ch[3];
-        arguments += u.ch[2];
-        arguments += u.ch[1];
-        arguments += u.ch[0];
-        typetag += 't';
+        addOscTimeTag(t);
         return true;
     }
     else if(type == MessagesTypeHttp) {
@@ -711,6 +981,7 @@ bool Message::addTimeTag(qint64 t, const QString & name, quint16) {
     else if(type == MessagesTypeTcp) {
         asciiMessage    = asciiMessage    + " " + QByteArray::number(t);
         asciiMessageXml = asciiMessageXml + qPrintable("<ARGUMENT TYPE=\"t\" VALUE=\"" + QString::number(t) + "\"/>");
+        addOscTimeTag(t);
         return true;
     }
     else if(type == MessagesTypeMidi) {
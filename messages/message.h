@@ -26,22 +26,27 @@
 
 #include <qmath.h>
 #include <QScriptEngine>
+#include <QScriptString>
 #include <QUdpSocket>
 #include <QTcpSocket>
 #include <QStringList>
+#include <QDataStream>
 #include "messages/messagemanagerloginterface.h"
+#include "messages/messageargument.h"
 #include "misc/application.h"
 
 class Message : public MessageLog {
 private:
     QByteArray      arguments, typetag, address, buffer;
     QString         midiCommand, midiPort;
+    quint16         artnetUniverse, artnetChannel;
     QUrl            urlMessage;
     QByteArray      urlMessageString;
     QByteArray      asciiMessage, asciiMessageXml;
 private:
     bool            hasAdd, isTransportMessage;
     QScriptValue    messageScriptValue, messageScriptResult;
+    QVector<QScriptString> messageScriptNames;
 private:
     QHostAddress    host;
     quint16         port;
@@ -56,14 +61,34 @@ public:
 public:
     void setUrl(QString url, QScriptEngine *_messageScriptEngine, const QHash<QString, UiString> &aliases);
     void setUrl(const QUrl & url, QScriptEngine *_messageScriptEngine = 0);
-    bool parse(const QVector<QByteArray> & patternItems, const MessageManagerDestination &destination);
+    bool parse(const QVector<MessageArgument> & patternItems, const MessageManagerDestination &destination);
+    void save(QDataStream &stream) const;
+    void load(QDataStream &stream);
+#ifdef IANNIX_TESTS
+    bool parseLegacy(const QVector<QByteArray> & patternItems, const MessageManagerDestination &destination);
+    QStringList parseDifferences(const Message &reference) const;
+#endif
+    //Queued copies keep plain data only, script handles stay with their engine
+    inline void detachScript() {
+        messageScriptValue  = QScriptValue();
+        messageScriptResult = QScriptValue();
+        messageScriptNames.clear();
+        messageScriptEngine = 0;
+    }
     
 private:
     bool addString(QString str, const QString & name, quint16);
     bool addFloat(float f, const QString & name, quint16);
     bool addTimeTag(qint64 t, const QString & name, quint16);
+    void addOscString(const QString &str);
+    void addOscFloat(float f);
+    void addOscTimeTag(qint64 t);
+    void encode();
+    QByteArray loadOscString(const QByteArray &packet, qint32 &index) const;
 private:
     qint64 generateTimeTag() const;
+    void setArtnetAddress();
+public:
     inline void pad(QByteArray & b) const {
         while (b.size() % 4 != 0)
             b += (char)0;
@@ -79,6 +104,9 @@ public:
     
     inline const QString &      getMidiCommand()     const { return midiCommand;        }
     inline const QString &      getMidiPort()        const { return midiPort;           }
+    inline       quint16        getArtnetUniverse()  const { return artnetUniverse;     }
+    inline       quint16        getArtnetChannel()   const { return artnetChannel;      }
+    inline const QList<qreal> & getValues()          const { return midiValues;         }
     inline const QByteArray &   getAddress()         const { return address;            }
     inline const QUrl &         getUrlMessage()      const { return urlMessage;         }
     inline const QByteArray &   getAsciiMessage()    const { return asciiMessage;       }
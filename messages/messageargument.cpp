@@ -0,0 +1,180 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "messageargument.h"
+#include "misc/help.h"
+
+QHash<QByteArray, MessageArgumentOpcode> MessageArgument::opcodes;
+QVector<QByteArray>                      MessageArgument::keywords;
+
+MessageArgument::MessageArgument(const QByteArray &_pattern, quint16 index) {
+    if(opcodes.isEmpty())
+        initOpcodes();
+
+    pattern    = _pattern;
+    name       = pattern;
+    customName = QString("custom %1").arg(index);
+    opcode     = opcodes.value(pattern, MessageArgumentLiteral);
+
+    //JavaScript between curly brackets
+    if((pattern.count()) && (pattern.at(0) == '{')) {
+        opcode = MessageArgumentScript;
+        script = pattern.trimmed().remove(0, 1);
+        script.chop(1);
+        name       = script;
+        scriptName = QString("script %1").arg(index);
+        program    = QScriptProgram(name, scriptName);
+
+        //Variables referenced by the script, bound before each evaluation
+        scriptVariables.resize(MessageArgumentOpcodeCount);
+        QHashIterator<QByteArray, MessageArgumentOpcode> opcodesIterator(opcodes);
+        while(opcodesIterator.hasNext()) {
+            opcodesIterator.next();
+            if(script.contains(opcodesIterator.key()))
+                scriptVariables.setBit(opcodesIterator.value());
+        }
+    }
+
+    //Fallbacks when the keyword can't be resolved at send time
+    const QByteArray &fallback = (opcode == MessageArgumentScript)?(script):(pattern);
+    isCollision = fallback.startsWith("collision_");
+    isKeyword   = Help::keywords.contains(fallback);
+    isNumber    = false;
+    number      = fallback.toDouble(&isNumber);
+}
+
+QVector<MessageArgument> MessageArgument::compile(const QVector<QByteArray> &patternItems) {
+    QVector<MessageArgument> arguments;
+    arguments.reserve(patternItems.count());
+    for(quint16 patternIndex = 0 ; patternIndex < patternItems.count() ; patternIndex++)
+        arguments.append(MessageArgument(patternItems.at(patternIndex), patternIndex));
+    return arguments;
+}
+
+const QByteArray & MessageArgument::getKeyword(MessageArgumentOpcode opcode) {
+    if(opcodes.isEmpty())
+        initOpcodes();
+    return keywords.at(opcode);
+}
+
+void MessageArgument::initOpcodes() {
+    opcodes.insert("trigger_id",                MessageArgumentTriggerId);
+    opcodes.insert("trigger_group_id",          MessageArgumentTriggerGroupId);
+    opcodes.insert("trigger_label",             MessageArgumentTriggerLabel);
+    opcodes.insert("trigger_xPos",              MessageArgumentTriggerXPos);
+    opcodes.insert("trigger_yPos",              MessageArgumentTriggerYPos);
+    opcodes.insert("trigger_zPos",              MessageArgumentTriggerZPos);
+    opcodes.insert("trigger_value_x",           MessageArgumentTriggerValueX);
+    opcodes.insert("trigger_value_y",           MessageArgumentTriggerValueY);
+    opcodes.insert("trigger_value_z",           MessageArgumentTriggerValueZ);
+    opcodes.insert("trigger_value",             MessageArgumentTriggerValue);
+    opcodes.insert("trigger_duration",          MessageArgumentTriggerDuration);
+    opcodes.insert("trigger_distance",          MessageArgumentTriggerDistance);
+    opcodes.insert("trigger_message_id",        MessageArgumentTriggerMessageId);
+    opcodes.insert("trigger_side",              MessageArgumentTriggerSide);
+
+    opcodes.insert("cursor_id",                 MessageArgumentCursorId);
+    opcodes.insert("cursor_group_id",           MessageArgumentCursorGroupId);
+    opcodes.insert("cursor_label",              MessageArgumentCursorLabel);
+    opcodes.insert("cursor_xPos",               MessageArgumentCursorXPos);
+    opcodes.insert("cursor_yPos",               MessageArgumentCursorYPos);
+    opcodes.insert("cursor_zPos",               MessageArgumentCursorZPos);
+    opcodes.insert("cursor_sxPos",              MessageArgumentCursorSxPos);
+    opcodes.insert("cursor_syPos",              MessageArgumentCursorSyPos);
+    opcodes.insert("cursor_szPos",              MessageArgumentCursorSzPos);
+    opcodes.insert("cursor_value_x",            MessageArgumentCursorValueX);
+    opcodes.insert("cursor_value_y",            MessageArgumentCursorValueY);
+    opcodes.insert("cursor_value_z",            MessageArgumentCursorValueZ);
+    opcodes.insert("cursor_value_sx",           MessageArgumentCursorValueSx);
+    opcodes.insert("cursor_value_sy",           MessageArgumentCursorValueSy);
+    opcodes.insert("cursor_value_sz",           MessageArgumentCursorValueSz);
+    opcodes.insert("cursor_aPos",               MessageArgumentCursorAPos);
+    opcodes.insert("cursor_ePos",               MessageArgumentCursorEPos);
+    opcodes.insert("cursor_dPos",               MessageArgumentCursorDPos);
+    opcodes.insert("cursor_value_a",            MessageArgumentCursorValueA);
+    opcodes.insert("cursor_value_e",            MessageArgumentCursorValueE);
+    opcodes.insert("cursor_value_d",            MessageArgumentCursorValueD);
+    opcodes.insert("cursor_time",               MessageArgumentCursorTime);
+    opcodes.insert("cursor_time_percent",       MessageArgumentCursorTimePercent);
+    opcodes.insert("cursor_angle",              MessageArgumentCursorAngle);
+    opcodes.insert("cursor_xPos_delta",         MessageArgumentCursorXPosDelta);
+    opcodes.insert("cursor_yPos_delta",         MessageArgumentCursorYPosDelta);
+    opcodes.insert("cursor_zPos_delta",         MessageArgumentCursorZPosDelta);
+    opcodes.insert("cursor_sxPos_delta",        MessageArgumentCursorSxPosDelta);
+    opcodes.insert("cursor_syPos_delta",        MessageArgumentCursorSyPosDelta);
+    opcodes.insert("cursor_szPos_delta",        MessageArgumentCursorSzPosDelta);
+    opcodes.insert("cursor_value_x_delta",      MessageArgumentCursorValueXDelta);
+    opcodes.insert("cursor_value_y_delta",      MessageArgumentCursorValueYDelta);
+    opcodes.insert("cursor_value_z_delta",      MessageArgumentCursorValueZDelta);
+    opcodes.insert("cursor_value_sx_delta",     MessageArgumentCursorValueSxDelta);
+    opcodes.insert("cursor_value_sy_delta",     MessageArgumentCursorValueSyDelta);
+    opcodes.insert("cursor_value_sz_delta",     MessageArgumentCursorValueSzDelta);
+    opcodes.insert("cursor_aPos_delta",         MessageArgumentCursorAPosDelta);
+    opcodes.insert("cursor_ePos_delta",         MessageArgumentCursorEPosDelta);
+    opcodes.insert("cursor_dPos_delta",         MessageArgumentCursorDPosDelta);
+    opcodes.insert("cursor_value_a_delta",      MessageArgumentCursorValueADelta);
+    opcodes.insert("cursor_value_e_delta",      MessageArgumentCursorValueEDelta);
+    opcodes.insert("cursor_value_d_delta",      MessageArgumentCursorValueDDelta);
+    opcodes.insert("cursor_time_delta",         MessageArgumentCursorTimeDelta);
+    opcodes.insert("cursor_time_percent_delta", MessageArgumentCursorTimePercentDelta);
+    opcodes.insert("cursor_angle_delta",        MessageArgumentCursorAngleDelta);
+    opcodes.insert("cursor_nb_loop",            MessageArgumentCursorNbLoop);
+    opcodes.insert("cursor_message_id",         MessageArgumentCursorMessageId);
+
+    opcodes.insert("curve_id",                  MessageArgumentCurveId);
+    opcodes.insert("curve_group_id",            MessageArgumentCurveGroupId);
+    opcodes.insert("curve_label",               MessageArgumentCurveLabel);
+    opcodes.insert("curve_xPos",                MessageArgumentCurveXPos);
+    opcodes.insert("curve_yPos",                MessageArgumentCurveYPos);
+    opcodes.insert("curve_zPos",                MessageArgumentCurveZPos);
+
+    opcodes.insert("collision_curve_id",        MessageArgumentCollisionCurveId);
+    opcodes.insert("collision_curve_group_id",  MessageArgumentCollisionCurveGroupId);
+    opcodes.insert("collision_curve_label",     MessageArgumentCollisionCurveLabel);
+    opcodes.insert("collision_curve_xPos",      MessageArgumentCollisionCurveXPos);
+    opcodes.insert("collision_curve_yPos",      MessageArgumentCollisionCurveYPos);
+    opcodes.insert("collision_curve_zPos",      MessageArgumentCollisionCurveZPos);
+    opcodes.insert("collision_xPos",            MessageArgumentCollisionXPos);
+    opcodes.insert("collision_yPos",            MessageArgumentCollisionYPos);
+    opcodes.insert("collision_zPos",            MessageArgumentCollisionZPos);
+    opcodes.insert("collision_value_x",         MessageArgumentCollisionValueX);
+    opcodes.insert("collision_value_y",         MessageArgumentCollisionValueY);
+    opcodes.insert("collision_value_z",         MessageArgumentCollisionValueZ);
+    opcodes.insert("collision_distance",        MessageArgumentCollisionDistance);
+
+    opcodes.insert("timetag",                   MessageArgumentTimetag);
+    opcodes.insert("status",                    MessageArgumentStatus);
+    opcodes.insert("nb_triggers",               MessageArgumentNbTriggers);
+    opcodes.insert("nb_cursors",                MessageArgumentNbCursors);
+    opcodes.insert("nb_curves",                 MessageArgumentNbCurves);
+    opcodes.insert("global_time",               MessageArgumentGlobalTime);
+    opcodes.insert("global_time_verbose",       MessageArgumentGlobalTimeVerbose);
+
+    keywords.resize(MessageArgumentOpcodeCount);
+    QHashIterator<QByteArray, MessageArgumentOpcode> opcodesIterator(opcodes);
+    while(opcodesIterator.hasNext()) {
+        opcodesIterator.next();
+        keywords[opcodesIterator.value()] = opcodesIterator.key();
+    }
+}
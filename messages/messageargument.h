@@ -0,0 +1,99 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MESSAGEARGUMENT_H
+#define MESSAGEARGUMENT_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QBitArray>
+#include <QScriptProgram>
+
+enum MessageArgumentOpcode {
+    MessageArgumentLiteral, MessageArgumentScript,
+
+    MessageArgumentTriggerId, MessageArgumentTriggerGroupId, MessageArgumentTriggerLabel,
+    MessageArgumentTriggerXPos, MessageArgumentTriggerYPos, MessageArgumentTriggerZPos,
+    MessageArgumentTriggerValueX, MessageArgumentTriggerValueY, MessageArgumentTriggerValueZ,
+    MessageArgumentTriggerValue, MessageArgumentTriggerDuration, MessageArgumentTriggerDistance,
+    MessageArgumentTriggerMessageId, MessageArgumentTriggerSide,
+
+    MessageArgumentCursorId, MessageArgumentCursorGroupId, MessageArgumentCursorLabel,
+    MessageArgumentCursorXPos, MessageArgumentCursorYPos, MessageArgumentCursorZPos,
+    MessageArgumentCursorSxPos, MessageArgumentCursorSyPos, MessageArgumentCursorSzPos,
+    MessageArgumentCursorValueX, MessageArgumentCursorValueY, MessageArgumentCursorValueZ,
+    MessageArgumentCursorValueSx, MessageArgumentCursorValueSy, MessageArgumentCursorValueSz,
+    MessageArgumentCursorAPos, MessageArgumentCursorEPos, MessageArgumentCursorDPos,
+    MessageArgumentCursorValueA, MessageArgumentCursorValueE, MessageArgumentCursorValueD,
+    MessageArgumentCursorTime, MessageArgumentCursorTimePercent, MessageArgumentCursorAngle,
+    MessageArgumentCursorXPosDelta, MessageArgumentCursorYPosDelta, MessageArgumentCursorZPosDelta,
+    MessageArgumentCursorSxPosDelta, MessageArgumentCursorSyPosDelta, MessageArgumentCursorSzPosDelta,
+    MessageArgumentCursorValueXDelta, MessageArgumentCursorValueYDelta, MessageArgumentCursorValueZDelta,
+    MessageArgumentCursorValueSxDelta, MessageArgumentCursorValueSyDelta, MessageArgumentCursorValueSzDelta,
+    MessageArgumentCursorAPosDelta, MessageArgumentCursorEPosDelta, MessageArgumentCursorDPosDelta,
+    MessageArgumentCursorValueADelta, MessageArgumentCursorValueEDelta, MessageArgumentCursorValueDDelta,
+    MessageArgumentCursorTimeDelta, MessageArgumentCursorTimePercentDelta, MessageArgumentCursorAngleDelta,
+    MessageArgumentCursorNbLoop, MessageArgumentCursorMessageId,
+
+    MessageArgumentCurveId, MessageArgumentCurveGroupId, MessageArgumentCurveLabel,
+    MessageArgumentCurveXPos, MessageArgumentCurveYPos, MessageArgumentCurveZPos,
+
+    MessageArgumentCollisionCurveId, MessageArgumentCollisionCurveGroupId, MessageArgumentCollisionCurveLabel,
+    MessageArgumentCollisionCurveXPos, MessageArgumentCollisionCurveYPos, MessageArgumentCollisionCurveZPos,
+    MessageArgumentCollisionXPos, MessageArgumentCollisionYPos, MessageArgumentCollisionZPos,
+    MessageArgumentCollisionValueX, MessageArgumentCollisionValueY, MessageArgumentCollisionValueZ,
+    MessageArgumentCollisionDistance,
+
+    MessageArgumentTimetag, MessageArgumentStatus,
+    MessageArgumentNbTriggers, MessageArgumentNbCursors, MessageArgumentNbCurves,
+    MessageArgumentGlobalTime, MessageArgumentGlobalTimeVerbose,
+
+    MessageArgumentOpcodeCount
+};
+
+//Pattern item resolved once when a message pattern is set
+class MessageArgument {
+public:
+    MessageArgumentOpcode opcode;
+    QByteArray pattern, script;
+    QString    name, customName, scriptName;
+    bool       isCollision, isKeyword, isNumber;
+    qreal      number;
+    QScriptProgram program;
+    QBitArray      scriptVariables;
+
+public:
+    explicit MessageArgument(const QByteArray &_pattern = QByteArray(), quint16 index = 0);
+    static QVector<MessageArgument> compile(const QVector<QByteArray> &patternItems);
+    static const QByteArray & getKeyword(MessageArgumentOpcode opcode);
+
+private:
+    static QHash<QByteArray, MessageArgumentOpcode> opcodes;
+    static QVector<QByteArray> keywords;
+    static void initOpcodes();
+};
+
+#endif // MESSAGEARGUMENT_H
@@ -0,0 +1,226 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "messagejournal.h"
+#include "messagemanager.h"
+
+QFile*        MessageJournal::recordFile = 0;
+QDataStream   MessageJournal::recordStream;
+QMutex        MessageJournal::recordMutex;
+QElapsedTimer MessageJournal::recordClock;
+quint32       MessageJournal::recordCounter = 0;
+
+MessageJournal::MessageJournal(QObject *parent) :
+    QObject(parent) {
+    replaySpeed     = 1;
+    replayWallStart = 0;
+    replayCounter   = 0;
+    replaySkipped   = 0;
+    replayTimer     = -1;
+}
+
+bool MessageJournal::readHeader(QDataStream &stream) {
+    char magic[4];
+    quint32 version = 0;
+    if(stream.readRawData(magic, 4) != 4)
+        return false;
+    stream >> version;
+    return (qstrncmp(magic, MESSAGEJOURNAL_MAGIC, 4) == 0) && (version == MESSAGEJOURNAL_VERSION);
+}
+
+
+//Recording : each record is direction, score time, wall time (us since start) and the encoded message
+bool MessageJournal::startRecording(const QString &filename) {
+    stopRecording();
+    QMutexLocker locker(&recordMutex);
+    QFile *file = new QFile(filename);
+    if(!file->open(QIODevice::WriteOnly)) {
+        qDebug("[JOURNAL] Can't write %s", qPrintable(filename));
+        delete file;
+        return false;
+    }
+    recordStream.setDevice(file);
+    recordStream.setVersion(QDataStream::Qt_4_8);
+    recordStream.writeRawData(MESSAGEJOURNAL_MAGIC, 4);
+    recordStream << (quint32)MESSAGEJOURNAL_VERSION;
+    recordCounter = 0;
+    recordClock.start();
+    recordFile = file;
+    qDebug("[JOURNAL] Recording to %s", qPrintable(filename));
+    return true;
+}
+void MessageJournal::stopRecording() {
+    QMutexLocker locker(&recordMutex);
+    if(!recordFile)
+        return;
+    QFile *file = recordFile;
+    recordFile = 0;
+    recordStream.setDevice(0);
+    file->close();
+    qDebug("[JOURNAL] %d messages recorded to %s", recordCounter, qPrintable(file->fileName()));
+    delete file;
+}
+void MessageJournal::record(const Message &message) {
+    QMutexLocker locker(&recordMutex);
+    if(!recordFile)
+        return;
+    recordStream << (quint8)MessageJournalOutgoing << (double)Transport::timeLocal << (qint64)(recordClock.nsecsElapsed() / 1000);
+    message.save(recordStream);
+    recordCounter++;
+}
+void MessageJournal::record(const MessageIncomming &message) {
+    QMutexLocker locker(&recordMutex);
+    if(!recordFile)
+        return;
+    recordStream << (quint8)MessageJournalIncoming << (double)Transport::timeLocal << (qint64)(recordClock.nsecsElapsed() / 1000);
+    recordStream << message.protocol << message.host << message.port << message.destination << message.command << message.arguments << message.values;
+    recordCounter++;
+}
+
+//Incoming records only (the control traffic received by IanniX), used as a corpus for benchmarks
+bool MessageJournal::loadIncoming(const QString &filename, QList<MessageIncomming> *messages) {
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly)) {
+        qDebug("[JOURNAL] Can't read %s", qPrintable(filename));
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_8);
+    if(!readHeader(stream)) {
+        qDebug("[JOURNAL] %s is not a message journal", qPrintable(filename));
+        return false;
+    }
+    while(!stream.atEnd()) {
+        quint8 direction = 0;
+        double scoreTime = 0;
+        qint64 wallTime = 0;
+        stream >> direction >> scoreTime >> wallTime;
+        if(direction == MessageJournalOutgoing) {
+            Message message;
+            message.load(stream);
+        }
+        else {
+            QString protocol, host, destination, command;
+            QVariant port;
+            QStringList arguments;
+            QVariantList values;
+            stream >> protocol >> host >> port >> destination >> command >> arguments >> values;
+            if(values.count())  messages->append(MessageIncomming(protocol, host, port, destination, values));
+            else                messages->append(MessageIncomming(protocol, host, port, destination, command, arguments));
+        }
+        if(stream.status() != QDataStream::Ok) {
+            qDebug("[JOURNAL] Truncated journal");
+            break;
+        }
+    }
+    return true;
+}
+
+
+//Replay : outgoing records are sent again through their interface, at the recorded pace (speed > 0) or as fast as possible (speed = 0)
+bool MessageJournal::replay(const QString &filename, qreal speed) {
+    stop();
+    replayFile.setFileName(filename);
+    if(!replayFile.open(QIODevice::ReadOnly)) {
+        qDebug("[JOURNAL] Can't read %s", qPrintable(filename));
+        return false;
+    }
+    replayStream.setDevice(&replayFile);
+    replayStream.setVersion(QDataStream::Qt_4_8);
+    if(!readHeader(replayStream)) {
+        qDebug("[JOURNAL] %s is not a message journal", qPrintable(filename));
+        replayStream.setDevice(0);
+        replayFile.close();
+        return false;
+    }
+    replaySpeed     = qMax((qreal)0, speed);
+    replayWallStart = -1;
+    replayCounter   = 0;
+    replaySkipped   = 0;
+    replayClock.start();
+#ifdef QT5
+    replayTimer = startTimer(1, Qt::PreciseTimer);
+#else
+    replayTimer = startTimer(1);
+#endif
+    qDebug("[JOURNAL] Replaying %s (%s)", qPrintable(filename), (replaySpeed > 0)?(qPrintable(QString("x%1").arg(replaySpeed))):("max speed"));
+    return true;
+}
+void MessageJournal::stop() {
+    if(replayTimer < 0)
+        return;
+    killTimer(replayTimer);
+    replayTimer = -1;
+    qreal elapsed = replayClock.nsecsElapsed() / 1000000000.;
+    qDebug("[JOURNAL] %d messages replayed (%d skipped) in %.3f s : %.0f msg/s, %.1f kB/s", replayCounter, replaySkipped, elapsed, (elapsed > 0)?(replayCounter / elapsed):(0.), (elapsed > 0)?(replayFile.pos() / 1024. / elapsed):(0.));
+    replayStream.setDevice(0);
+    replayFile.close();
+    emit(replayFinished());
+}
+
+void MessageJournal::timerEvent(QTimerEvent *) {
+    qint64 now = replayClock.nsecsElapsed() / 1000;
+    for(quint16 burst = 0 ; burst < MESSAGEJOURNAL_BURST ; burst++) {
+        if(replayStream.atEnd()) {
+            stop();
+            return;
+        }
+
+        //Peek the header of the next record, and wait if it is not due yet
+        qint64 position = replayFile.pos();
+        quint8 direction = 0;
+        double scoreTime = 0;
+        qint64 wallTime = 0;
+        replayStream >> direction >> scoreTime >> wallTime;
+        if(replayWallStart < 0)
+            replayWallStart = wallTime;
+        if((replaySpeed > 0) && ((wallTime - replayWallStart) / replaySpeed > now)) {
+            replayFile.seek(position);
+            return;
+        }
+
+        if(direction == MessageJournalOutgoing) {
+            Message message;
+            message.load(replayStream);
+            NetworkInterface *networkInterface = MessageManager::interfaces.value(message.getType());
+            if((networkInterface) && (message.getType() != MessagesTypeDirect) && (networkInterface->send(message)))
+                replayCounter++;
+            else
+                replaySkipped++;
+        }
+        else {
+            QString protocol, host, destination, command;
+            QVariant port;
+            QStringList arguments;
+            QVariantList values;
+            replayStream >> protocol >> host >> port >> destination >> command >> arguments >> values;
+            replaySkipped++;
+        }
+        if(replayStream.status() != QDataStream::Ok) {
+            qDebug("[JOURNAL] Truncated journal");
+            stop();
+            return;
+        }
+    }
+}
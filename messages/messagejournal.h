@@ -0,0 +1,85 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef MESSAGEJOURNAL_H
+#define MESSAGEJOURNAL_H
+
+#include <QObject>
+#include <QFile>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QDataStream>
+#include "messages/message.h"
+
+#define MESSAGEJOURNAL_MAGIC        "NXJ1"
+#define MESSAGEJOURNAL_VERSION      2
+#define MESSAGEJOURNAL_BURST        10000   //Records sent per timer event at max speed
+
+enum MessageJournalDirection { MessageJournalOutgoing = 0, MessageJournalIncoming = 1 };
+
+class MessageJournal : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MessageJournal(QObject *parent = 0);
+
+    //Recording (any thread)
+private:
+    static QFile *recordFile;
+    static QDataStream recordStream;
+    static QMutex recordMutex;
+    static QElapsedTimer recordClock;
+    static quint32 recordCounter;
+public:
+    static bool startRecording(const QString &filename);
+    static void stopRecording();
+    static inline bool isRecording() { return recordFile != 0; }
+    static void record(const Message &message);
+    static void record(const MessageIncomming &message);
+    static bool loadIncoming(const QString &filename, QList<MessageIncomming> *messages);
+
+    //Replay (GUI thread)
+private:
+    QFile replayFile;
+    QDataStream replayStream;
+    QElapsedTimer replayClock;
+    qreal replaySpeed;
+    qint64 replayWallStart;
+    quint32 replayCounter, replaySkipped;
+    int replayTimer;
+public:
+    bool replay(const QString &filename, qreal speed = 1);
+    void stop();
+    inline bool isReplaying() const { return replayTimer >= 0; }
+private:
+    static bool readHeader(QDataStream &stream);
+protected:
+    void timerEvent(QTimerEvent *);
+
+signals:
+    void replayFinished();
+};
+
+#endif // MESSAGEJOURNAL_H
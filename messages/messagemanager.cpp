@@ -23,6 +23,7 @@
 
 #include "messagemanager.h"
 #include "objects/nxobject.h"
+#include "objects/nxdocument.h"
 
 QList<MessageManagerLogInterface*>      MessageManager::logs;
 Message                                 MessageManager::message;
@@ -31,25 +32,44 @@ QHash<MessagesType, NetworkInterface*>  MessageManager::interfaces;
 QHash<QString, UiString>                MessageManager::aliases;
 MessageDispatcher*                      MessageManager::dispatcher        = 0;
 MessageManagerLog*                      MessageManager::messageManagerLog = 0;
+MessageManagerLogBuffer*                MessageManager::logBuffer         = 0;
 QScriptEngine*                          MessageManager::scriptEngine      = 0;
 void*                                   MessageManager::transportObject   = 0;
 void*                                   MessageManager::syncObject        = 0;
+QIODevice*                              MessageManager::offlineOutput     = 0;
+quint32                                 MessageManager::offlineOutputCounter = 0;
+MessageManager*                         MessageManager::instance          = 0;
+QMutex                                  MessageManager::outgoingQueueLock;
+QList<MessageManagerQueued>             MessageManager::outgoingQueue;
+QAtomicInt                              MessageManager::outgoingQueueFlush;
+QScriptEngine*                          MessageManager::scriptEngineScheduler = 0;
+QHash<QByteArray, Message>              MessageManager::messagesCacheScheduler;
+Message                                 MessageManager::messageScheduler;
+QAtomicInt                              MessageManager::messagesCacheSchedulerReset;
 quint16 MessageManager::transportNbTriggers = 0;
 quint16 MessageManager::transportNbCursors  = 0;
 quint16 MessageManager::transportNbCurves   = 0;
 quint16 MessageManager::transportNbGroups   = 0;
 
 void MessageManager::setInterfaces(MessageDispatcher *_dispatcher, QScriptEngine *_scriptEngine, QLayout *logLayout, QLayout *logMiniLayout) {
+    if(!instance)
+        instance = new MessageManager();
     if(_dispatcher)
         dispatcher   = _dispatcher;
     if(_scriptEngine)
         scriptEngine = _scriptEngine;
+    if(((logLayout) || (logMiniLayout)) && (!logBuffer))
+        logBuffer = new MessageManagerLogBuffer();
     if(logLayout) {
         messageManagerLog = new MessageManagerLog(logLayout);
         logs.append(messageManagerLog);
+        connect(logBuffer, SIGNAL(flushed(QStringList,QStringList,quint32)), messageManagerLog, SLOT(flush(QStringList,QStringList,quint32)));
+    }
+    if(logMiniLayout) {
+        MessageManagerLogMini *messageManagerLogMini = new MessageManagerLogMini(logMiniLayout);
+        logs.append(messageManagerLogMini);
+        connect(logBuffer, SIGNAL(flushed(QStringList,QStringList,quint32)), messageManagerLogMini, SLOT(flush(QStringList,QStringList,quint32)));
     }
-    if(logMiniLayout)
-        logs.append(new MessageManagerLogMini(logMiniLayout));
 }
 
 void MessageManager::addNetworkInterface(MessagesType type, NetworkInterface *networkInterface) {
@@ -62,7 +82,26 @@ void MessageManager::deleteNetworkInterface() {
     interfaces.clear();
 }
 
+//Patterns are parsed again after a scheduler change, the scheduler thread drops its own cache on its next message
+void MessageManager::clearMessagesCache() {
+    messagesCache.clear();
+    messagesCacheSchedulerReset.fetchAndStoreOrdered(1);
+}
+//Called by the scheduler thread when it ends, its engine is deleted in the thread that created it
+void MessageManager::schedulerStopped() {
+    messagesCacheScheduler.clear();
+    messageScheduler = Message();
+    delete scriptEngineScheduler;
+    scriptEngineScheduler = 0;
+}
+
 void MessageManager::networkBundle(bool open) {
+    if(!isGuiThread()) {
+        MessageManagerQueued queued;
+        queued.bundle = open;
+        queueOutgoing(queued);
+        return;
+    }
     foreach(NetworkInterface *networkInterface, interfaces)
         networkInterface->networkBundle(open);
 }
@@ -77,11 +116,16 @@ void MessageManager::networkSynchro(bool start) {
     }
 }
 
+//Logs are only formatted when displayed, then buffered until the next UI flush
 void MessageManager::logSend(const MessageLog &message, QStringList *sentMessage) {
+    if(isLogging())
+        logBuffer->push(false, qPrintable(Transport::timeLocalStr + " : " + message.getVerboseMessage()));
     foreach(MessageManagerLogInterface *log, logs)
         log->logSend(message, sentMessage);
 }
 void MessageManager::logReceive(const MessageLog &message, QStringList *sentMessage) {
+    if(isLogging())
+        logBuffer->push(true, qPrintable(Transport::timeLocalStr + " : " + message.getVerboseMessage()));
     foreach(MessageManagerLogInterface *log, logs)
         log->logReceive(message, sentMessage);
 }
@@ -90,10 +134,10 @@ void MessageManager::logInfo(const QString &message) {
         log->logInfo(message);
 }
 QString MessageManager::incomingMessage(const MessageIncomming &source, bool needOutput, bool needToScript) {
-    if(needToScript) {
-        foreach(MessageManagerLogInterface *log, logs)
-            log->logReceive(source);
-    }
+    if(needToScript)
+        logReceive(source);
+    if(MessageJournal::isRecording())
+        MessageJournal::record(source);
     if(dispatcher)
         return dispatcher->incomingMessage(source, needOutput, needToScript);
     return QString();
@@ -101,22 +145,86 @@ QString MessageManager::incomingMessage(const MessageIncomming &source, bool nee
 
 void MessageManager::outgoingMessage(const MessageManagerDestination &destination) {
     if((destination.object) && (Application::current->hasStarted)) {
+        bool queue = !isGuiThread();
+        if((queue) && (!scriptEngineScheduler)) {
+            scriptEngineScheduler = new QScriptEngine();
+            scriptEngineScheduler->evaluate(NxDocument::loadLibrary());
+        }
+        if((queue) && (messagesCacheSchedulerReset.fetchAndStoreOrdered(0)))
+            messagesCacheScheduler.clear();
+        QHash<QByteArray, Message> &cache = (queue)?(messagesCacheScheduler):(messagesCache);
+        Message &message = (queue)?(messageScheduler):(MessageManager::message);
+        QScriptEngine *engine = (queue)?(scriptEngineScheduler):(scriptEngine);
+        MessageManagerQueued queued;
         QStringList sentMessages;
-        foreach(const QVector<QByteArray> &messagePattern, ((NxObject*)destination.object)->getMessagePatterns()) {
-            if(messagesCache.contains(messagePattern.at(0)))
-                message = messagesCache.value(messagePattern.at(0));
+        const QVector< QVector<QByteArray> > &messagePatterns = ((NxObject*)destination.object)->getMessagePatterns();
+        const QVector< QVector<MessageArgument> > &messageArguments = ((NxObject*)destination.object)->getMessageArguments();
+        for(quint16 messagePatternIndex = 0 ; messagePatternIndex < messagePatterns.count() ; messagePatternIndex++) {
+            const QVector<QByteArray> &messagePattern = messagePatterns.at(messagePatternIndex);
+            if(cache.contains(messagePattern.at(0)))
+                message = cache.value(messagePattern.at(0));
             else {
-                message.setUrl(messagePattern.at(0), scriptEngine, aliases);
-                messagesCache.insert(messagePattern.at(0), message);
+                message.setUrl(messagePattern.at(0), engine, aliases);
+                cache.insert(messagePattern.at(0), message);
             }
-            if(message.parse(messagePattern, destination)) {
-                if(((NxObject*)destination.object)->getSelectedHover())
+            if(message.parse(messageArguments.at(messagePatternIndex), destination)) {
+                if(MessageJournal::isRecording())
+                    MessageJournal::record(message);
+                //Offline render : messages go to a file, timestamped in score time (only direct:// ones are still executed)
+                if(offlineOutput) {
+                    offlineOutput->write(QByteArray::number(Transport::timeLocal, 'f', 3) + "\t" + message.getVerboseMessage() + "\n");
+                    offlineOutputCounter++;
+                    if(message.getType() != MessagesTypeDirect)
+                        continue;
+                }
+                if(queue) {
+                    queued.messages.append(message);
+                    queued.messages.last().detachScript();
+                }
+                else if(((NxObject*)destination.object)->getSelectedHover())
                     interfaces[message.getType()]->send(message, &sentMessages);
                 else
                     interfaces[message.getType()]->send(message);
             }
         }
-        if((((NxObject*)destination.object)->getSelectedHover()) && (sentMessages.count()))
+        if(queue) {
+            if(queued.messages.count()) {
+                if(((NxObject*)destination.object)->getSelectedHover())
+                    queued.hover = (NxObject*)destination.object;
+                queueOutgoing(queued);
+            }
+        }
+        else if((((NxObject*)destination.object)->getSelectedHover()) && (sentMessages.count()))
             ((NxObject*)destination.object)->setMessageLabel(sentMessages);
     }
 }
+
+//Sockets, widgets and direct:// commands are only touched from the GUI thread, one wake-up per batch of ticks
+void MessageManager::queueOutgoing(const MessageManagerQueued &queued) {
+    outgoingQueueLock.lock();
+    outgoingQueue.append(queued);
+    outgoingQueueLock.unlock();
+    if(outgoingQueueFlush.testAndSetOrdered(0, 1))
+        QMetaObject::invokeMethod(instance, "flushOutgoingQueue", Qt::QueuedConnection);
+}
+void MessageManager::flushOutgoingQueue() {
+    outgoingQueueFlush.fetchAndStoreOrdered(0);
+    outgoingQueueLock.lock();
+    QList<MessageManagerQueued> queue = outgoingQueue;
+    outgoingQueue.clear();
+    outgoingQueueLock.unlock();
+
+    foreach(const MessageManagerQueued &queued, queue) {
+        if(queued.bundle >= 0) {
+            networkBundle(queued.bundle);
+            continue;
+        }
+        QStringList sentMessages;
+        foreach(const Message &queuedMessage, queued.messages) {
+            if(queued.hover)    interfaces[queuedMessage.getType()]->send(queuedMessage, &sentMessages);
+            else                interfaces[queuedMessage.getType()]->send(queuedMessage);
+        }
+        if((queued.hover) && (sentMessages.count()))
+            ((NxObject*)queued.hover.data())->setMessageLabel(sentMessages);
+    }
+}
@@ -24,9 +24,26 @@
 #ifndef MESSAGEMANAGER_H
 #define MESSAGEMANAGER_H
 
+#include <QIODevice>
+#include <QMutex>
+#include <QPointer>
+#include <QAtomicInt>
+#include <QThread>
 #include "messages/message.h"
 #include "messagemanagerlog.h"
 #include "messagemanagerlogmini.h"
+#include "messagemanagerlogbuffer.h"
+#include "messagejournal.h"
+
+//Output of the scheduler thread, replayed on the GUI thread which owns sockets and widgets
+class MessageManagerQueued {
+public:
+    MessageManagerQueued() { bundle = -1; }
+public:
+    qint8             bundle;   //Bundle opening (1) or closing (0), -1 for messages
+    QList<Message>    messages;
+    QPointer<QObject> hover;    //Object that displays its sent messages
+};
 
 class MessageManager : public QObject {
     Q_OBJECT
@@ -41,16 +58,38 @@ public:
     static QHash<MessagesType, NetworkInterface*> interfaces;
     static QHash<QString, UiString> aliases;
     static QScriptEngine *scriptEngine;
+    static QIODevice *offlineOutput;
+    static quint32 offlineOutputCounter;
 private:
     static MessageManagerLog* messageManagerLog;
+    static MessageManagerLogBuffer* logBuffer;
+private:
+    static MessageManager *instance;
+    static QMutex outgoingQueueLock;
+    static QList<MessageManagerQueued> outgoingQueue;
+    static QAtomicInt outgoingQueueFlush;
+    //The scheduler thread parses with its own script engine, message and cache (script engines are not thread-safe)
+    static QScriptEngine *scriptEngineScheduler;
+    static QHash<QByteArray, Message> messagesCacheScheduler;
+    static Message messageScheduler;
+    static QAtomicInt messagesCacheSchedulerReset;
+    static inline bool isGuiThread() {
+        return (!instance) || (QThread::currentThread() == instance->thread());
+    }
+    static void queueOutgoing(const MessageManagerQueued &queued);
 
 public:
     static void setInterfaces(MessageDispatcher *_dispatcher = 0, QScriptEngine *_scriptEngine = 0, QLayout *logWidget = 0, QLayout *logMiniWidget = 0);
     static void addNetworkInterface(MessagesType type, NetworkInterface *networkInterface);
     static void deleteNetworkInterface();
+    static void clearMessagesCache();
+    static void schedulerStopped();
     static inline void setLogVisibility(bool logVisible) {
         if(messageManagerLog) messageManagerLog->enable = logVisible;
     }
+    static inline bool isLogging() {
+        return (logBuffer) && (((messageManagerLog) && (messageManagerLog->enable)) || (Application::enableMiniLog));
+    }
 
 public:
     static void networkManualParsing();
@@ -66,8 +105,8 @@ public:
 
 signals:
     
-public slots:
-    
+private slots:
+    void flushOutgoingQueue();
 };
 
 #endif // MESSAGEMANAGER_H
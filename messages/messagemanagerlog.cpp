@@ -30,6 +30,13 @@ MessageManagerLog::MessageManagerLog(QLayout *layout) :
     ui->setupUi(this);
 
     enable = false;
+    droppedTotal = 0;
+    labelSend    = ui->label_3->text();
+    labelReceive = ui->label  ->text();
+    ui->logSend   ->setMaximumBlockCount(LOG_MAX_LINES);
+    ui->logReceive->setMaximumBlockCount(LOG_MAX_LINES);
+    connect(ui->logSendClear,    SIGNAL(released()), SLOT(action()));
+    connect(ui->logReceiveClear, SIGNAL(released()), SLOT(action()));
     if(layout)
         layout->addWidget(this);
 
@@ -40,13 +47,19 @@ MessageManagerLog::~MessageManagerLog() {
     delete ui;
 }
 
-void MessageManagerLog::logSend(const MessageLog &log, QStringList*) {
-    if(enable)
-        ui->logSend->appendPlainText(Transport::timeLocalStr + " : " + log.getVerboseMessage());
-}
-void MessageManagerLog::logReceive(const MessageLog &log, QStringList*) {
-    if(enable)
-        ui->logReceive->appendPlainText(Transport::timeLocalStr + " : " + log.getVerboseMessage());
+//Batches drained from the shared log buffer (oldest lines are trimmed by the widgets)
+void MessageManagerLog::flush(const QStringList &sent, const QStringList &received, quint32 dropped) {
+    if(!enable)
+        return;
+    if(sent.count())
+        ui->logSend->appendPlainText(sent.join("\n"));
+    if(received.count())
+        ui->logReceive->appendPlainText(received.join("\n"));
+    if(dropped) {
+        droppedTotal += dropped;
+        ui->label_3->setText(labelSend    + tr(" - %1 DROPPED").arg(droppedTotal));
+        ui->label  ->setText(labelReceive + tr(" - %1 DROPPED").arg(droppedTotal));
+    }
 }
 
 void MessageManagerLog::action() {
@@ -54,4 +67,9 @@ void MessageManagerLog::action() {
         QApplication::clipboard()->setText(ui->logSend->toPlainText());
     else if(sender() == ui->logReceiveCopy)
         QApplication::clipboard()->setText(ui->logReceive->toPlainText());
+    else if((sender() == ui->logSendClear) || (sender() == ui->logReceiveClear)) {
+        droppedTotal = 0;
+        ui->label_3->setText(labelSend);
+        ui->label  ->setText(labelReceive);
+    }
 }
@@ -25,7 +25,9 @@
 #define MESSAGEMANAGERLOG_H
 
 #include <QWidget>
+#include <QStringList>
 #include "messagemanagerloginterface.h"
+#include "messagemanagerlogbuffer.h"
 
 namespace Ui {
 class MessageManagerLog;
@@ -43,11 +45,13 @@ public:
 
 public:
     bool enable;
-    void logSend   (const MessageLog &log, QStringList *sentMessage = 0);
-    void logReceive(const MessageLog &log, QStringList *sentMessage = 0);
+private:
+    quint32 droppedTotal;
+    QString labelSend, labelReceive;
 
 public slots:
     void action();
+    void flush(const QStringList &sent, const QStringList &received, quint32 dropped);
 
 private:
     Ui::MessageManagerLog *ui;
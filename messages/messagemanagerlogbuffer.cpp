@@ -0,0 +1,83 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "messagemanagerlogbuffer.h"
+
+MessageManagerLogBuffer::MessageManagerLogBuffer(QObject *parent) :
+    QObject(parent) {
+    for(int cellIndex = 0 ; cellIndex < LOGBUFFER_SIZE ; cellIndex++)
+        cells[cellIndex].sequence.fetchAndStoreOrdered(cellIndex);
+    writeIndex.fetchAndStoreOrdered(0);
+    dropped.fetchAndStoreOrdered(0);
+    readIndex = 0;
+    startTimer(LOGBUFFER_FLUSH_PERIOD);
+}
+
+bool MessageManagerLogBuffer::push(bool received, const QByteArray &text) {
+    //Reserve a cell (the sender never waits: when the ring is full, the message is dropped)
+    int position = writeIndex.fetchAndAddOrdered(0);
+    Cell *cell = 0;
+    while(true) {
+        cell = &cells[position & (LOGBUFFER_SIZE-1)];
+        int difference = cell->sequence.fetchAndAddOrdered(0) - position;
+        if(difference == 0) {
+            if(writeIndex.testAndSetOrdered(position, position+1))
+                break;
+        }
+        else if(difference < 0) {
+            dropped.fetchAndAddOrdered(1);
+            return false;
+        }
+        position = writeIndex.fetchAndAddOrdered(0);
+    }
+
+    //Fill and publish
+    cell->entry.received = received;
+    cell->entry.text     = text;
+    cell->sequence.fetchAndStoreOrdered(position+1);
+    return true;
+}
+bool MessageManagerLogBuffer::pop(MessageManagerLogEntry *entry) {
+    Cell *cell = &cells[readIndex & (LOGBUFFER_SIZE-1)];
+    if(cell->sequence.fetchAndAddOrdered(0) != readIndex+1)
+        return false;
+    *entry = cell->entry;
+    cell->entry.text.clear();
+    cell->sequence.fetchAndStoreOrdered(readIndex + LOGBUFFER_SIZE);
+    readIndex++;
+    return true;
+}
+
+void MessageManagerLogBuffer::timerEvent(QTimerEvent *) {
+    //Drains everything in one batch, so widgets are updated once per period
+    QStringList sent, received;
+    MessageManagerLogEntry entry;
+    for(int entryIndex = 0 ; (entryIndex < LOGBUFFER_SIZE) && (pop(&entry)) ; entryIndex++) {
+        if(entry.received)  received.append(entry.text);
+        else                sent    .append(entry.text);
+    }
+    quint32 droppedCount = dropped.fetchAndStoreOrdered(0);
+    if((sent.count()) || (received.count()) || (droppedCount))
+        emit(flushed(sent, received, droppedCount));
+}
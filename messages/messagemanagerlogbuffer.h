@@ -0,0 +1,72 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef MESSAGEMANAGERLOGBUFFER_H
+#define MESSAGEMANAGERLOGBUFFER_H
+
+#include <QObject>
+#include <QAtomicInt>
+#include <QStringList>
+
+#define LOGBUFFER_SIZE          4096    //Must be a power of two
+#define LOGBUFFER_FLUSH_PERIOD  100     //ms
+#define LOG_MAX_LINES           10000
+
+class MessageManagerLogEntry {
+public:
+    bool received;
+    QByteArray text;
+};
+
+class MessageManagerLogBuffer : public QObject {
+    Q_OBJECT
+
+public:
+    explicit MessageManagerLogBuffer(QObject *parent = 0);
+
+private:
+    //Bounded ring written by any thread and drained by the GUI thread only.
+    //Each cell carries a sequence number telling if it is free for a writer or ready for the reader.
+    class Cell {
+    public:
+        QAtomicInt sequence;
+        MessageManagerLogEntry entry;
+    };
+    Cell cells[LOGBUFFER_SIZE];
+    QAtomicInt writeIndex, dropped;
+    int readIndex;
+
+public:
+    bool push(bool received, const QByteArray &text);
+private:
+    bool pop(MessageManagerLogEntry *entry);
+
+protected:
+    void timerEvent(QTimerEvent *);
+
+signals:
+    void flushed(const QStringList &sent, const QStringList &received, quint32 dropped);
+};
+
+#endif // MESSAGEMANAGERLOGBUFFER_H
@@ -32,7 +32,7 @@
 #include "geometry/nxpoint.h"
 #include "iannix_cmd.h"
 
-enum MessagesType     { MessagesTypeDirect, MessagesTypeOsc, MessagesTypeUdp, MessagesTypeTcp, MessagesTypeSyphon, MessagesTypeHttp, MessagesTypeSerial, MessagesTypeMidi };
+enum MessagesType     { MessagesTypeDirect, MessagesTypeOsc, MessagesTypeUdp, MessagesTypeTcp, MessagesTypeSyphon, MessagesTypeHttp, MessagesTypeSerial, MessagesTypeMidi, MessagesTypeArtnet };
 
 class MessageLog {
 private:
@@ -57,6 +57,7 @@ public:
     QVariant port;
     QString command, destination;
     QStringList arguments;
+    QVariantList values;
 
 public:
     explicit MessageIncomming(const QString &_protocol, const QString &_host, const QVariant &_port, const QString &_destination, const QString &_command, const QStringList &_arguments) {
@@ -67,6 +68,38 @@ public:
         destination = _destination;
         arguments   = _arguments;
     }
+    explicit MessageIncomming(const QString &_protocol, const QString &_host, const QVariant &_port, const QString &_destination, const QVariantList &_values) {
+        protocol    = _protocol;
+        host        = _host;
+        port        = _port;
+        destination = _destination;
+        values      = _values;
+    }
+
+    //Text form of typed arguments, only built when needed
+    static inline QString getValueStr(const QVariant &value) {
+        if(value.type() == QVariant::Int)           return QString::number(value.toInt());
+        else if(value.type() == QVariant::Double)   return QString::number(value.toDouble());
+        else                                        return value.toString();
+    }
+    const QString getCommand() const {
+        if((command.isEmpty()) && (values.count())) {
+            QString retour = destination + " ";
+            foreach(const QVariant &value, values)
+                retour += getValueStr(value) + " ";
+            return retour;
+        }
+        return command;
+    }
+    const QStringList getArguments() const {
+        if((arguments.isEmpty()) && (values.count())) {
+            QStringList retour;
+            foreach(const QVariant &value, values)
+                retour << getValueStr(value);
+            return retour;
+        }
+        return arguments;
+    }
 
     const QByteArray getVerboseMessage(bool withDestination = false) const {
         QString portStr = port.toString();
@@ -76,10 +109,13 @@ public:
         if(withDestination) {
             if(!destination.isEmpty())
                 retour += "/" + destination;
-            foreach(const QString &argument, arguments)
+            foreach(const QString &argument, getArguments())
                 retour += "\t" + argument;
         }
-        else if(!command.isEmpty()) retour += "\t" + command;
+        else {
+            QString commandStr = getCommand();
+            if(!commandStr.isEmpty()) retour += "\t" + commandStr;
+        }
         return qPrintable(retour);
     }
 };
@@ -28,8 +28,6 @@ MessageManagerLogMini::MessageManagerLogMini(QLayout *layout) :
     QWidget(0),
     ui(new Ui::MessageManagerLogMini) {
     ui->setupUi(this);
-    canDisplay  = false;
-    startTimer(200);
     if(layout)
         layout->addWidget(this);
 
@@ -42,11 +40,6 @@ MessageManagerLogMini::~MessageManagerLogMini() {
 }
 
 void MessageManagerLogMini::logSend(const MessageLog &log, QStringList *sentMessage) {
-    if((canDisplay) && (Application::enableMiniLog)) {
-        QString logged = Transport::timeLocalStr + " : " + log.getVerboseMessage();
-        ui->log->setText(logged.replace("\t", " "));
-        canDisplay = false;
-    }
     if(sentMessage) {
         QString logged = Transport::timeLocalStr + " : " + log.getVerboseMessage();
         sentMessage->append(logged.replace("\t", " "));
@@ -56,7 +49,14 @@ void MessageManagerLogMini::logReceive(const MessageLog &log, QStringList *sentM
     logSend(log, sentMessage);
 }
 
-void MessageManagerLogMini::timerEvent(QTimerEvent *) {
-    canDisplay = true;
+//Shows the last message of each batch drained from the shared log buffer
+void MessageManagerLogMini::flush(const QStringList &sent, const QStringList &received, quint32 dropped) {
+    if(!Application::enableMiniLog)
+        return;
+    QString logged;
+    if(received.count())    logged = received.last();
+    if(sent.count())        logged = sent.last();
+    if(dropped)             logged += tr(" (%1 dropped)").arg(dropped);
+    ui->log->setText(logged.replace("\t", " "));
 }
 
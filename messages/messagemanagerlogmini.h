@@ -38,14 +38,11 @@ public:
     explicit MessageManagerLogMini(QLayout *layout = 0);
     ~MessageManagerLogMini();
 
-private:
-    bool canDisplay;
-
-protected:
-    void timerEvent(QTimerEvent *);
 public:
     void logSend   (const MessageLog &log, QStringList *sentMessage = 0);
     void logReceive(const MessageLog &log, QStringList *sentMessage = 0);
+public slots:
+    void flush(const QStringList &sent, const QStringList &received, quint32 dropped);
 
 private:
     Ui::MessageManagerLogMini *ui;
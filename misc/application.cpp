@@ -72,6 +72,9 @@ UiBool  Application::mouseSnapX             = false;
 UiBool  Application::mouseSnapY             = false;
 UiBool  Application::mouseSnapZ             = false;
 UiReal  Application::objectsAutosize        = 0;
+UiReal  Application::undoJournalSize        = 64;
+UiBool  Application::saveBinaryScore        = false;
+UiBool  Application::captureUncompressed    = false;
 
 
 
@@ -91,8 +94,12 @@ UiBool  Render::cameraPerspective      = true;
 UiBool  Render::forceLists             = false;
 UiBool  Render::forceTexture           = false;
 UiBool  Render::forceFrustumInInit     = false;
+UiBool  Render::batchTriggers          = true;
+UiBool  Render::cullObjects            = true;
+quint32 Render::triggersRevision       = 0;
 UiReal  Application::followId          = 9999;
 UiBool  Application::enableMiniLog     = true;
+UiBool  Application::schedulerThread   = false;
 qreal   Render::objectSize             = 1;
 qreal   Render::zoomValue              = 1;
 qreal   Render::zoomLinear             = 1;
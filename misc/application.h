@@ -29,6 +29,7 @@
 #include <QVariant>
 #include <QMainWindow>
 #include <QPixmap>
+#include <QScriptValue>
 #ifdef QT5
 #include <QStandardPaths>
 #include <QUrlQuery>
@@ -67,17 +68,23 @@ public:
     virtual void setObjectActivity(void *_object, quint8 activeOld) = 0;
     virtual void setObjectGroupId(void *_object, const QString & groupIdOld) = 0;
     virtual void setObjectId(void *_object, quint16 idOld) = 0;
+    virtual void setObjectPos(void *_object) = 0;
+    virtual void setObjectTrigEnd(void *_object, qreal delay) = 0;
+    virtual void journalObjectProperty(void *_object, const char *_property) = 0;
+    virtual const QVariant executeBatch(const QScriptValue &items, const QString &typeDefault) = 0;
     bool isGroupSoloActive, isObjectSoloActive;
 public slots:
     virtual void openMessageEditor() = 0;
     virtual void pushSnapshot() = 0;
     virtual quint16 getCount(qint8 objectType = -1) = 0;
-    virtual const QString serialize() const = 0;
+    virtual const QString serialize(bool withObjects = true) const = 0;
     virtual void readyToStart() = 0;
     virtual QMainWindow* getMainWindow() = 0;
+    virtual QTreeWidgetItem* getObjectRootItem() = 0;
     virtual UiRenderPreview* getRenderPreview() = 0;
     virtual bool getPerformancePreview() = 0;
     virtual void timerTrig(void *object, bool force = false) = 0;
+    virtual void schedulerTick(qreal delta, qreal interval) = 0;
     virtual QString waitForMessage() = 0;
     virtual void* getObjectById(quint16 id) = 0;
     virtual void executeAsScript(const QString &script) = 0;
@@ -121,6 +128,8 @@ public:
     static UiFileItem      files;
     static UiBool paintThisGroup, cameraPerspective;
     static UiBool forceLists, forceTexture, forceFrustumInInit;
+    static UiBool batchTriggers, cullObjects;
+    static quint32 triggersRevision; //Bumped each time a trigger may be drawn differently (commands, selection, trigs, groups, colors, textures)
     static NxRect axisArea;
     static qreal zoomValue, zoomLinear, zoomLinearDest;
     static UiReal axisGrid;
@@ -150,9 +159,13 @@ public:
     static UiBool allowSelection, allowSelectionCursors, allowSelectionCurves, allowSelectionTriggers, colorTheme, allowLockPos, allowPlaySelected;
     static UiBool paintAxisGrid, paintCurvesOpacity, paintLabel;
     static UiReal objectsAutosize;
+    static UiReal undoJournalSize;
+    static UiBool saveBinaryScore;
+    static UiBool captureUncompressed;
     static UiBool mouseSnapX, mouseSnapY, mouseSnapZ;
     static UiReal followId;
     static UiBool enableMiniLog;
+    static UiBool schedulerThread;
     static const QString colorsPrefix(qint16 i = -1) {
         if(i < 0) {
             if(colorTheme)   return "lighttheme";
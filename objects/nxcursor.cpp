@@ -52,6 +52,10 @@ NxCursor::NxCursor(ApplicationCurrent *parent, QTreeWidgetItem *ccParentItem) :
     cursorPolyOldOld[1] = NxPoint();
     cursorPolyOldOld[2] = NxPoint();
     cursorPolyOldOld[3] = NxPoint();
+    paintTime = paintTimeOld = 0;
+    paintNbLoop = 0;
+    paintPoly = cursorPoly;
+    paintHasActivity = false;
 
     initializeCustom();
 }
@@ -185,23 +189,11 @@ void NxCursor::calculate() {
     //Cursor line
     if((curve) && (curve->getPathLength() > 0)) {
         qreal timeReal = easing.getValue(time), timeOldReal = easing.getValue(timeOld);
-        cursorPos = curve->getPointAt(timeReal) + curve->getPos();
-
-        if(timeReal == 0)
-            cursorAngle = -curve->getAngleAt(timeReal + 0.001);
-        else if(timeReal == 1)
-            cursorAngle = -curve->getAngleAt(timeReal - 0.001);
-        else
-            cursorAngle = -curve->getAngleAt(timeReal);
-
-        cursorPosOld = curve->getPointAt(timeOldReal) + curve->getPos();
-
-        if(timeOldReal == 0)
-            cursorAngleOld = -curve->getAngleAt(timeOldReal + 0.001);
-        else if(timeOldReal == 1)
-            cursorAngleOld = -curve->getAngleAt(timeOldReal - 0.001);
-        else
-            cursorAngleOld = -curve->getAngleAt(timeOldReal);
+        //Position and orientation in one curve evaluation
+        cursorPos    = curve->getPointAndAngleAt(timeReal,    &cursorAngle)    + curve->getPos();
+        cursorAngle  = -cursorAngle;
+        cursorPosOld = curve->getPointAndAngleAt(timeOldReal, &cursorAngleOld) + curve->getPos();
+        cursorAngleOld = -cursorAngleOld;
 
         //Infos en +
         //NxPoint cursorPosDelta = cursorPosOld - cursorPos;
@@ -277,7 +269,17 @@ void NxCursor::calculate() {
 }
 
 
-void NxCursor::paint() {
+//Copied while the GUI thread holds the document, the scheduler keeps moving the cursor during the drawing
+void NxCursor::paintSnapshot() {
+    paintTime         = time;
+    paintTimeOld      = timeOld;
+    paintNbLoop       = nbLoop;
+    paintPos          = cursorPos;
+    paintAngle        = cursorAngle;
+    paintPoly         = cursorPoly;
+    paintBoundingRect = boundingRect;
+    paintHasActivity  = hasActivity;
+
     //Color
     if(active) {
         if(colorActive.isEmpty())                                                                                       color = colorActiveColor;
@@ -295,6 +297,17 @@ void NxCursor::paint() {
                   qBound(qreal(0.), color.green() * colorMultiplyColor.greenF(), qreal(255.)),
                   qBound(qreal(0.), color.blue()  * colorMultiplyColor.blueF(),  qreal(255.)),
                   qBound(qreal(0.), color.alpha() * colorMultiplyColor.alphaF(), qreal(255.)));
+}
+
+void NxCursor::paint() {
+    const qreal      time        = paintTime;
+    const qreal      timeOld     = paintTimeOld;
+    const quint16    nbLoop      = paintNbLoop;
+    const NxPoint   &cursorPos   = paintPos;
+    const NxPoint   &cursorAngle = paintAngle;
+    const NxPolygon &cursorPoly  = paintPoly;
+    const bool       hasActivity = paintHasActivity;
+    QColor color = this->color;
 
     if(color.alpha() > 0) {
         //Mouse hover
@@ -542,6 +555,28 @@ void NxCursor::trig(bool force) {
     }
 }
 
+bool NxCursor::getCollisionArea(NxRect *area) const {
+    //No collision possible yet
+    if(!previousPreviousCursorReliable) {
+        *area = NxRect();
+        return true;
+    }
+
+    //Tilted cursors (3D curves) can hit triggers outside of their XY sweep
+    if(qAbs(cursorAngleCacheSinY) > 0.0001)
+        return false;
+
+    //Triggers hit by contains() lie within width/2 of the segment joining both centres
+    NxPoint centre1((cursorPoly.at(0).x() + cursorPoly.at(1).x() + cursorPoly.at(2).x() + cursorPoly.at(3).x()) / 4.,
+                    (cursorPoly.at(0).y() + cursorPoly.at(1).y() + cursorPoly.at(2).y() + cursorPoly.at(3).y()) / 4.);
+    NxPoint centre2((cursorPolyOldOld.at(0).x() + cursorPolyOldOld.at(1).x() + cursorPolyOldOld.at(2).x() + cursorPolyOldOld.at(3).x()) / 4.,
+                    (cursorPolyOldOld.at(0).y() + cursorPolyOldOld.at(1).y() + cursorPolyOldOld.at(2).y() + cursorPolyOldOld.at(3).y()) / 4.);
+    qreal margin = qAbs(width) / 2. + 0.0001;
+    *area = NxRect(NxPoint(qMin(centre1.x(), centre2.x()) - margin, qMin(centre1.y(), centre2.y()) - margin),
+                   NxPoint(qMax(centre1.x(), centre2.x()) + margin, qMax(centre1.y(), centre2.y()) + margin));
+    return true;
+}
+
 bool NxCursor::contains(NxTrigger *trigger) const {
     qint64 timestamp = Transport::currentMSecsSinceEpoch;
     if((previousPreviousCursorReliable) && (trigger->getActive()) && (!trigger->cursorTrigged)/* && ((timestamp - trigger->lastTrigTime) > 0)*/) {
@@ -91,6 +91,11 @@ private:
     qreal cursorAngleCacheSinZ, cursorAngleCacheCosZ, cursorAngleCacheSinY, cursorAngleCacheCosY;
     GLuint glListCursor;
     quint16 boundsSourceMode;
+    qreal paintTime, paintTimeOld;
+    quint16 paintNbLoop;
+    NxPoint paintPos, paintAngle;
+    NxPolygon paintPoly;
+    bool paintHasActivity;
 public:
     inline quint8 getType() const {
         return ObjectsTypeCursor;
@@ -100,6 +105,8 @@ public:
     }
 
     inline void dragStart(const NxPoint &, bool) {
+        if(!curve)
+            journal(COMMAND_POS);
         posDrag = pos;
         isDrag = true;
     }
@@ -381,6 +388,7 @@ public:
     }
 
     bool contains(NxTrigger *trigger) const;
+    bool getCollisionArea(NxRect *area) const;
     bool trig(NxCurve *collisionCurve);
 
     inline void calcBoundingRect() {
@@ -481,8 +489,19 @@ public:
         return cursorAngleLastSend;
     }
 
+    inline const NxPoint & getPaintPos() const {
+        return paintPos;
+    }
+    inline const NxPoint & getPaintAngle() const {
+        return paintAngle;
+    }
+    inline bool getPaintHasActivity() const {
+        return paintHasActivity;
+    }
+
 
 public:
+    void paintSnapshot();
     void paint();
     void trig(bool force = false);
     bool getForceTrig() { return false;}
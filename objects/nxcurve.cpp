@@ -22,6 +22,7 @@
 */
 
 #include "nxcurve.h"
+#include "nxcursor.h"
 #ifdef Q_OS_WIN
     #define MUSTR(a) QString(a).toStdWString()
 #else
@@ -34,6 +35,7 @@ NxCurve::NxCurve(ApplicationCurrent *parent, QTreeWidgetItem *ccParentItem) :
     NxObject(parent, ccParentItem) {
     QTreeWidgetItem::setText(0, tr("CURVE"));
     glListCurve = glGenLists(1);
+    glListLod = glListLodCompiled = 1;
     selectedPathPointPoint = selectedPathPointControl1 = selectedPathPointControl2 = -1;
     curveType = CurveTypePoints;
     equationIsValid = false;
@@ -148,10 +150,6 @@ void NxCurve::paint() {
 
 #endif
 
-    computeInertie();
-
-    update();
-
     //Color
     if(active) {
         if(colorActive.isEmpty())                                                                                   color = colorActiveColor;
@@ -179,7 +177,7 @@ void NxCurve::paint() {
         if((Application::paintCurvesOpacity) && (cursors.count() > 0)) {
             bool display = false;
             foreach(const NxObject *cursor, cursors)
-                if(cursor->getHasActivity()) {
+                if(((const NxCursor*)cursor)->getPaintHasActivity()) {
                     display = true;
                     break;
                 }
@@ -210,7 +208,7 @@ void NxCurve::paint() {
         }
 
         //Draw
-        if((glListRecreate) || (glListRecreateFromEditor) || (Render::forceLists)) {
+        if((glListRecreate) || (glListRecreateFromEditor) || (Render::forceLists) || (glListLod != glListLodCompiled)) {
             /*
             if(pathPoints.count())
                 setPointAt(0, getPathPointsAt(0), getPathPointsAt(0).c1, getPathPointsAt(0).c2, getPathPointsAt(0).smooth);
@@ -222,14 +220,15 @@ void NxCurve::paint() {
 
             if(curveType == CurveTypeEllipse) {
                 glBegin(GL_LINE_LOOP);
-                for(qreal angle = 0 ; angle <= 2*M_PI ; angle += 0.1)
+                for(qreal angle = 0 ; angle <= 2*M_PI ; angle += 0.1 * glListLod)
                     glVertex3f(shapeSize.width() * qCos(angle), shapeSize.height() * qSin(angle), 0);
                 glEnd();
             }
             else if((equationIsValid) && (!equation.isEmpty()) && ((curveType == CurveTypeEquationCartesian) || (curveType == CurveTypeEquationPolar)))  {
                 glBegin(GL_LINE_STRIP);
                 try {
-                    for(equationVariableT = 0 ; equationVariableT <= 1+equationVariableTSteps ; equationVariableT += equationVariableTSteps) {
+                    qreal equationVariableTStepsLod = equationVariableTSteps * glListLod;
+                    for(equationVariableT = 0 ; equationVariableT <= 1+equationVariableTStepsLod ; equationVariableT += equationVariableTStepsLod) {
                         qreal *ptCoords = equationParser.Eval(equationNbEval);
                         if(curveType == CurveTypeEquationPolar) glVertex3f(ptCoords[0] * sin(ptCoords[1]) * cos(ptCoords[2]), ptCoords[0] * cos(ptCoords[1]), ptCoords[0] * sin(ptCoords[1]) * sin(ptCoords[2]));
                         else                                    glVertex3f(ptCoords[0], ptCoords[1], ptCoords[2]);
@@ -260,8 +259,10 @@ void NxCurve::paint() {
                             glMap1f(GL_MAP1_VERTEX_3, 0.0, 1.0, 3, 4, &ctrlpoints[0][0]);
                             glEnable(GL_MAP1_VERTEX_3);
                             glBegin(GL_LINE_STRIP);
-                            for(GLfloat t = 0.0f ; t <= 1.0f ; t += 0.02f)
+                            GLfloat step = 0.02f * glListLod;
+                            for(GLfloat t = 0.0f ; t < 1.0f ; t += step)
                                 glEvalCoord1f(t);
+                            glEvalCoord1f(1.0f);
                             glEnd();
                             glDisable(GL_MAP1_VERTEX_3);
                         }
@@ -279,6 +280,7 @@ void NxCurve::paint() {
                 pathPoints.update();
             glListRecreate           = false;
             glListRecreateFromEditor = false;
+            glListLodCompiled        = glListLod;
         }
         else
             glCallList(glListCurve);
@@ -706,6 +708,57 @@ inline NxPoint NxCurve::getPointAt(quint16 index, qreal t) {
     }
 }
 
+inline NxPoint NxCurve::getTangentAt(quint16 index, qreal t) {
+    NxPoint p1 = getPathPointsAt(index), p2 = getPathPointsAt(index+1);
+    NxPoint c1 = getPathPointsAt(index+1).c1, c2 = getPathPointsAt(index+1).c2;
+    if((c1 == NxPoint()) && (c2 == NxPoint()))
+        return NxPoint(p2.x() - p1.x(), p2.y() - p1.y(), p2.z() - p1.z());
+    else {
+        //Derivative of the cubic Bézier
+        NxPoint c12 = p2 + c2 - p1 - c1;
+        qreal mt = 1 - t;
+        qreal a = 3*mt*mt, b = 6*mt*t, c = 3*t*t;
+        return NxPoint(a*c1.x() + b*c12.x() - c*c2.x(),
+                       a*c1.y() + b*c12.y() - c*c2.y(),
+                       a*c1.z() + b*c12.z() - c*c2.z());
+    }
+}
+
+void NxCurve::getSegmentAt(qreal val, bool absoluteTime, quint16 *index, qreal *t) const {
+    qreal lengthTarget = (absoluteTime)?(val):(pathLength * val);
+    *index = 0;
+    *t     = 0;
+
+    //Binary search of the first point beyond the target length
+    quint16 indexMin = 1, indexMax = pathPoints.count();
+    while(indexMin < indexMax) {
+        quint16 indexMid = (indexMin + indexMax) / 2;
+        if(pathPoints.at(indexMid).currentLength >= lengthTarget)   indexMax = indexMid;
+        else                                                        indexMin = indexMid + 1;
+    }
+    if(indexMin >= pathPoints.count())
+        return;
+
+    qreal length = pathPoints.at(indexMin).currentLength, lengthOld = (indexMin > 1)?(pathPoints.at(indexMin-1).currentLength):(0);
+    *index = indexMin - 1;
+    if((length - lengthOld) != 0)
+        *t = (lengthTarget - lengthOld) / (length - lengthOld);
+
+    //Arc-length parameter inside Bézier segments
+    qint32 arcIndex = (indexMin < arcLengthsIndex.count())?(arcLengthsIndex.at(indexMin)):(-1);
+    if((arcIndex >= 0) && (arcIndex + CURVE_ARC_SAMPLES <= arcLengths.count()) && (0 < *t) && (*t < 1)) {
+        quint16 sampleMin = 0, sampleMax = CURVE_ARC_SAMPLES - 1;
+        while(sampleMin < sampleMax) {
+            quint16 sampleMid = (sampleMin + sampleMax) / 2;
+            if(arcLengths.at(arcIndex + sampleMid) >= *t)   sampleMax = sampleMid;
+            else                                            sampleMin = sampleMid + 1;
+        }
+        qreal sample = arcLengths.at(arcIndex + sampleMin), sampleOld = (sampleMin > 0)?(arcLengths.at(arcIndex + sampleMin - 1)):(0);
+        if((sample - sampleOld) != 0)
+            *t = (sampleMin + (*t - sampleOld) / (sample - sampleOld)) / CURVE_ARC_SAMPLES;
+    }
+}
+
 NxPoint NxCurve::getPointAt(qreal val, bool absoluteTime) {
     if(curveType == CurveTypeEllipse) {
         qreal angle = 2 * val * M_PI;
@@ -724,60 +777,55 @@ NxPoint NxCurve::getPointAt(qreal val, bool absoluteTime) {
         return NxPoint();
     }
     else if(curveType == CurveTypePoints) {
-        qreal length = 0, lengthOld = 0;
-        qreal lengthTarget = (absoluteTime)?(val):(pathLength * val);
-        quint16 index = 0;
-        for(quint16 indexPoint = 1 ; indexPoint < pathPoints.count() ; indexPoint++) {
-            length = getPathPointsAt(indexPoint).currentLength;
-            if(length >= lengthTarget) {
-                index = indexPoint - 1;
-                break;
-            }
-            lengthOld = length;
-        }
-        if((length - lengthOld) != 0)
-            return getPointAt(index, (lengthTarget - lengthOld) / (length - lengthOld));
-        else
-            return getPointAt(index, 0);
+        quint16 index;
+        qreal t;
+        getSegmentAt(val, absoluteTime, &index, &t);
+        return getPointAt(index, t);
     }
     return NxPoint();
 }
 NxPoint NxCurve::getAngleAt(qreal val, bool absoluteTime) {
-    qreal angleX = 0, angleY = 0, angleZ = 0;
-    if(curveType == CurveTypeEllipse)
-        angleZ = -((2 * val * M_PI) + M_PI_2) * 180.0F / M_PI;
+    NxPoint angle;
+    getPointAndAngleAt(val, &angle, absoluteTime);
+    return angle;
+}
+NxPoint NxCurve::getPointAndAngleAt(qreal val, NxPoint *angle, bool absoluteTime) {
+    NxPoint pt, deltaPos;
+    *angle = NxPoint();
+    if(curveType == CurveTypeEllipse) {
+        *angle = NxPoint(0, 0, -((2 * val * M_PI) + M_PI_2) * 180.0F / M_PI);
+        return getPointAt(val, absoluteTime);
+    }
     else if((equationIsValid) && (!equation.isEmpty()) && ((curveType == CurveTypeEquationCartesian) || (curveType == CurveTypeEquationPolar)))  {
-        try {
-            NxPoint pt1, pt2;
-            qreal *ptCoords;
-
-            equationVariableT = val;
-            ptCoords = equationParser.Eval(equationNbEval);
-            if(curveType == CurveTypeEquationPolar) pt1 = NxPoint(ptCoords[0] * sin(ptCoords[1] * cos(ptCoords[2])), ptCoords[0] * cos(ptCoords[1]), ptCoords[0] * sin(ptCoords[1]) * sin(ptCoords[2]));
-            else                                    pt1 = NxPoint(ptCoords[0], ptCoords[1], ptCoords[2]);
-
-            equationVariableT = val - 0.001;
-            ptCoords = equationParser.Eval(equationNbEval);
-            if(curveType == CurveTypeEquationPolar) pt2 = NxPoint(ptCoords[0] * sin(ptCoords[1] * cos(ptCoords[2])), ptCoords[0] * cos(ptCoords[1]), ptCoords[0] * sin(ptCoords[1]) * sin(ptCoords[2]));
-            else                                    pt2 = NxPoint(ptCoords[0], ptCoords[1], ptCoords[2]);
-
-            NxPoint deltaPos = pt2 - pt1;
-            angleZ = qAtan2(deltaPos.x(), deltaPos.y()) * 180.0F / M_PI + 90;
-            angleY = qAtan2(qSqrt(deltaPos.x()*deltaPos.x() + deltaPos.y()*deltaPos.y()), deltaPos.z()) * 180.0F / M_PI + 90 + 180;
-        }
-        catch (Parser::exception_type &e) {
-            qDebug("[MathParser] AngleAt error");
-        }
+        //One evaluation for the point, one for its neighbour (after it at the start of the curve).
+        //muParser gives no derivative of the equation, so the tangent still needs the second evaluation.
+        pt = getPointAt(val, absoluteTime);
+        if(val > 0) deltaPos = getPointAt(val - 0.001, absoluteTime) - pt;
+        else        deltaPos = pt - getPointAt(val + 0.001, absoluteTime);
     }
     else if(curveType == CurveTypePoints) {
-        NxPoint p2 = getPointAt(val - 0.001, absoluteTime), p1 = getPointAt(val, absoluteTime);
-        NxPoint deltaPos = p2 - p1;
-        angleZ = qAtan2(deltaPos.x(), deltaPos.y()) * 180.0F / M_PI + 90;
-        angleY = qAtan2(qSqrt(deltaPos.x()*deltaPos.x() + deltaPos.y()*deltaPos.y()), deltaPos.z()) * 180.0F / M_PI + 90 + 180;
+        quint16 index;
+        qreal t;
+        getSegmentAt(val, absoluteTime, &index, &t);
+        pt = getPointAt(index, t);
+
+        //Analytic tangent, finite differences if the control points make it vanish
+        NxPoint tangent = getTangentAt(index, t);
+        if((tangent.x()*tangent.x() + tangent.y()*tangent.y() + tangent.z()*tangent.z()) > 0.000000000001)
+            deltaPos = -tangent;
+        else if(val > 0)
+            deltaPos = getPointAt(val - 0.001, absoluteTime) - pt;
+        else
+            deltaPos = pt - getPointAt(val + 0.001, absoluteTime);
     }
-    return NxPoint(angleX, angleY, angleZ);
-}
+    else
+        return NxPoint();
 
+    qreal angleY = qAtan2(qSqrt(deltaPos.x()*deltaPos.x() + deltaPos.y()*deltaPos.y()), deltaPos.z()) * 180.0F / M_PI + 90 + 180;
+    qreal angleZ = qAtan2(deltaPos.x(), deltaPos.y()) * 180.0F / M_PI + 90;
+    *angle = NxPoint(0, angleY, angleZ);
+    return pt;
+}
 
 void NxCurve::calcBoundingRect() {
     bool calculatePathLength = false;
@@ -831,6 +879,10 @@ void NxCurve::calcBoundingRect() {
         boundingRect = NxRect(minGlobal, maxGlobal);
     }
     else if(curveType == CurveTypePoints) {
+        if(calculatePathLength) {
+            arcLengths.clear();
+            arcLengthsIndex.fill(-1, pathPoints.count());
+        }
         for(quint16 indexPoint = 0 ; indexPoint < pathPoints.count()-1 ; indexPoint++) {
             NxPoint minVal(9999,9999,9999,9999), maxVal(-9999,-9999,-9999,-9999);
 
@@ -872,6 +924,27 @@ void NxCurve::calcBoundingRect() {
                     if(pt.z() > maxVal.z())  maxVal.setZ(pt.z());
                     pt = ptNext;
                 }
+
+                //Arc-length table (normalized cumulative length at regular t)
+                if(calculatePathLength) {
+                    qint32 arcIndex = arcLengths.count();
+                    qreal arcLength = 0;
+                    NxPoint arcPt = getPointAt(indexPoint, 0);
+                    for(quint16 sample = 1 ; sample <= CURVE_ARC_SAMPLES ; sample++) {
+                        NxPoint arcPtNext = getPointAt(indexPoint, (qreal)sample / CURVE_ARC_SAMPLES);
+                        NxPoint delta = arcPtNext - arcPt;
+                        arcLength += qSqrt((delta.x()*delta.x()) + (delta.y()*delta.y()) + (delta.z()*delta.z()));
+                        arcLengths.append(arcLength);
+                        arcPt = arcPtNext;
+                    }
+                    if(arcLength > 0) {
+                        for(quint16 sample = 0 ; sample < CURVE_ARC_SAMPLES ; sample++)
+                            arcLengths[arcIndex + sample] /= arcLength;
+                        arcLengthsIndex[indexPoint+1] = arcIndex;
+                    }
+                    else
+                        arcLengths.resize(arcIndex);
+                }
             }
             if(calculatePathLength)
                 pathPoints[indexPoint+1].currentLength = pathLength;
@@ -896,6 +969,9 @@ void NxCurve::calcBoundingRect() {
     if(pathLength == 0)
         pathLength = 1;
 
+    //Picking grid
+    Application::current->setObjectPos(this);
+
     if(!Transport::timerOk)
         calculate();
     //qDebug("%d (%d) (%f %f %f %f) = %f", getId(), calculatePathLength, boundingRect.x(), boundingRect.y(), boundingRect.width(), boundingRect.height(), pathLength);
@@ -51,6 +51,9 @@
 #endif
 
 #define CURVE_PATH_POINTS   300
+#define CURVE_ARC_SAMPLES   20
+#define CURVE_LOD_PIXELS    3.      //Tessellation samples closer than this on screen are merged
+#define CURVE_LOD_MAX       16      //Coarsest tessellation (samples skipped)
 
 using namespace mu;
 
@@ -107,12 +110,15 @@ private:
     qint16 selectedPathPointPoint, selectedPathPointControl1, selectedPathPointControl2;
     NxSize shapeSize;
     GLuint glListCurve;
+    quint8 glListLod, glListLodCompiled;
     QString equation;
     QHash<QString,qreal> equationVariables;
     qreal equationVariableT, equationNbPoints, equationVariableTSteps;
     Parser equationParser;
     bool equationIsValid, curveNeedUpdate;
     int equationNbEval;
+    QVector<qreal>  arcLengths;
+    QVector<qint32> arcLengthsIndex;
 public:
     void setPointXAt(const QList<qreal> &points) {
         quint16 indexPoint = points.at(0);
@@ -229,6 +235,9 @@ public:
     inline QString getEquationParamListStr() const {
         return QString();
     }
+    inline const QHash<QString,qreal> & getEquationVariables() const {
+        return equationVariables;
+    }
     inline qreal getEquationParam(const QString &param) const {
         if(equationVariables.contains(param))   return equationVariables.value(param);
         else                                    return 0;
@@ -275,6 +284,19 @@ public:
     }
 
     void computeInertie();
+    inline void animate() {
+        computeInertie();
+        update();
+    }
+    inline void setLod(qreal pixelSize) {
+        //Level of detail : the tessellation step doubles as long as samples stay closer than CURVE_LOD_PIXELS on screen (full detail for a negative size)
+        qreal samples = 2*M_PI / 0.1;
+        if((curveType == CurveTypeEquationCartesian) || (curveType == CurveTypeEquationPolar))  samples = equationNbPoints;
+        else if(curveType == CurveTypePoints)                                                   samples = qMax(1, pathPoints.count()-1) / 0.02;
+        glListLod = 1;
+        while((pixelSize >= 0) && (glListLod < CURVE_LOD_MAX) && (pixelSize * glListLod * 2 / samples <= CURVE_LOD_PIXELS))
+            glListLod *= 2;
+    }
 
     inline quint16 getPathPointsCount() const { return pathPoints.count(); }
 
@@ -306,9 +328,10 @@ public:
     void setShowPathPointsResample(bool = true);
     inline bool getShowPathPointsEditor() const   { return true; }
     inline bool getShowPathPointsResample() const { return true; }
-    inline void setPathPoints(const UiPathPointsItems &_pathPoints) {
-        pathPoints = _pathPoints;
+    inline void setPathPoints(const QList<NxCurvePoint> &_pathPoints) {
+        static_cast< QList<NxCurvePoint>& >(pathPoints) = _pathPoints;
         glListRecreate = true;
+        curveNeedUpdate = true;
         calcBoundingRect();
         calculate();
     }
@@ -317,6 +340,10 @@ public:
         isDrag = true;
         if(multipleObjects)
             selectedPathPointPoint = selectedPathPointControl1 = selectedPathPointControl2 = -1;
+        if((selectedPathPointPoint >= 0) || (selectedPathPointControl1 >= 0) || (selectedPathPointControl2 >= 0))
+            journal(COMMAND_CURVE_POINT);
+        else
+            journal(COMMAND_POS);
         if(selectedPathPointPoint >= 0)             posDrag = getPathPointsAt(selectedPathPointPoint);
         else if(selectedPathPointControl1 >= 0)     posDrag = getPathPointsAt(selectedPathPointControl1).c1;
         else if(selectedPathPointControl2 >= 0)     posDrag = getPathPointsAt(selectedPathPointControl2).c2;
@@ -418,8 +445,11 @@ public:
     void resize(const NxSize & size);
     void resize(qreal sizeFactorW, qreal sizeFactorH);
     inline NxPoint getPointAt(quint16 index, qreal t);
+    inline NxPoint getTangentAt(quint16 index, qreal t);
+    void getSegmentAt(qreal val, bool absoluteTime, quint16 *index, qreal *t) const;
     NxPoint getPointAt(qreal val, bool absoluteTime = false);
     NxPoint getAngleAt(qreal val, bool absoluteTime = false);
+    NxPoint getPointAndAngleAt(qreal val, NxPoint *angle, bool absoluteTime = false);
     qreal intersects(const NxRect &rect, NxPoint* collisionPoint = 0);
 
     inline void setResize(const NxSize & size) {
@@ -21,7 +21,9 @@
     along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <QElapsedTimer>
 #include "nxdocument.h"
+#include "nxscorebinary.h"
 
 NxDocument::NxDocument(ApplicationCurrent *parent, UiFileItem *_fileItem) :
     QObject(parent) {
@@ -33,16 +35,19 @@ NxDocument::NxDocument(ApplicationCurrent *parent, UiFileItem *_fileItem) :
         connect(fileItem, SIGNAL(askFileSave()),   SLOT(askFileSave()));
     }
     skipClose = false;
+    objectsMaxId = 0;
+    for(quint16 activityIterator = 0 ; activityIterator < ObjectsActivityLenght ; activityIterator++)
+        for(quint16 typeIterator = 0 ; typeIterator < ObjectsTypeLength ; typeIterator++)
+            objectsCount[activityIterator][typeIterator] = 0;
     variable = 0;
     setCurrentObject(0);
     setCurrentGroup(0);
     currentCurve = 0;
-    snapshotsIndex = 0;
     isLoaded = false;
 }
 
 
-const QString NxDocument::serialize() const {
+const QString NxDocument::serialize(bool withObjects) const {
     QString retour;
     QString prefix = "\trun(\"", postfix = "\");\n";
 
@@ -73,41 +78,22 @@ const QString NxDocument::serialize() const {
 
     //Browse groups
     foreach(NxGroup *group, groups)
-        retour += group->serialize();
+        retour += group->serialize(withObjects);
 
     return retour;
 }
 
 void NxDocument::pushSnapshot() {
-    NxObjectDispatchProperty::source = ExecuteSourceCopyPaste;
-    if(snapshotsIndex < snapshots.count())
-        snapshots.replace(snapshotsIndex, Application::current->serialize());
-    else
-        snapshots.append(Application::current->serialize());
-    snapshotsIndex++;
+    //A GUI edit ends when control returns to the event loop : scripts, network and scheduler changes after it are not part of the step
+    undoJournal.push();
+    QMetaObject::invokeMethod(this, "stopSnapshot", Qt::QueuedConnection);
+}
+void NxDocument::stopSnapshot() {
+    undoJournal.stop();
 }
 void NxDocument::popSnapshot(bool revert) {
-    bool canDo = false;
-    if((revert) && (snapshotsIndex < snapshots.count()-1)) {
-        snapshotsIndex++;
-        canDo = true;
-    }
-    else if ((!revert) && (snapshotsIndex > 0) && (snapshotsIndex == snapshots.count())) {
-        pushSnapshot();
-        snapshotsIndex--;
-        snapshotsIndex--;
-        canDo = true;
-    }
-    else if ((!revert) && (snapshotsIndex > 0)) {
-        snapshotsIndex--;
-        canDo = true;
-    }
-    if(canDo) {
-        clear();
-        NxObjectDispatchProperty::source = ExecuteSourceGui;
-        source = NxObjectDispatchProperty::source;
-        Application::current->executeAsScript(snapshots.at(snapshotsIndex));
-    }
+    if(revert)  undoJournal.redo(this);
+    else        undoJournal.undo(this);
 }
 
 
@@ -115,6 +101,7 @@ void NxDocument::open() {
     if(true) {
         clear();
         open(true);
+        undoJournal.clear();
 
         NxObjectDispatchProperty::source = ExecuteSourceGui;
         source = NxObjectDispatchProperty::source;
@@ -147,6 +134,10 @@ void NxDocument::open(bool configure) {
         file = QFileInfo(Application::pathTools.absoluteFilePath() + "/Score template.iannix");
     QFile scriptFileContent(file.absoluteFilePath());
     if(scriptFileContent.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QElapsedTimer loadTimer;
+        loadTimer.start();
+        bool loadBinary = false;
+
         //Read file
         scriptContent = scriptFileContent.readAll();
         scriptFileContent.close();
@@ -202,6 +193,12 @@ void NxDocument::open(bool configure) {
                 source = ExecuteSourceScript;
                 scriptMakeWithScript       .call(QScriptValue(), QScriptValueList());
                 source = ExecuteSourceGui;
+                loadBinary = scriptContent.contains(SCOREBINARY_MARKER);
+                if(loadBinary) {
+                    QFileInfo binaryFile = NxScoreBinary::getFilename(getScriptFile());
+                    if(NxScoreBinary::load(this, Application::current->getObjectRootItem(), binaryFile.absoluteFilePath()) < 0)
+                        qDebug("==> Objects file %s can't be loaded", qPrintable(binaryFile.absoluteFilePath()));
+                }
                 scriptMadeThroughGUI       .call(QScriptValue(), QScriptValueList());
                 source = ExecuteSourceNetwork;
                 scriptMadeThroughInterfaces.call(QScriptValue(), QScriptValueList());
@@ -211,6 +208,7 @@ void NxDocument::open(bool configure) {
                 isLoaded = true;
             }
         }
+        qDebug("==> LOADED in %d ms (%s)", (int)loadTimer.elapsed(), (loadBinary)?("binary objects"):("script"));
     }
 
     if(fileItem)
@@ -228,6 +226,13 @@ void NxDocument::save() {
         scriptFileContent.write(qPrintable(scoreContent));
         scriptFileContent.close();
     }
+
+    //Objects made through the GUI go to the binary companion file when enabled
+    QFileInfo binaryFile = NxScoreBinary::getFilename(getScriptFile());
+    if((Application::saveBinaryScore) && (getScriptFile().suffix().toLower() != "nxscore"))
+        NxScoreBinary::save(this, binaryFile.absoluteFilePath());
+    else if(binaryFile.exists())
+        QFile::remove(binaryFile.absoluteFilePath());
     Application::current->getMainWindow()->setWindowTitle(tr("IanniX") + QString(" / %1").arg(getScriptFile().baseName()));
     if(fileItem)
         fileItem->setIcon(0, UiFileItem::iconFileOpened);
@@ -252,7 +257,10 @@ const QString NxDocument::getContent(bool fromFile) {
 
     //Locate functions
     NxObjectDispatchProperty::source = ExecuteSourceGui;
-    remplaceInFunction(&scoreContent, "//GUI: NEVER EVER REMOVE THIS LINE\n", Application::current->serialize());
+    if((Application::saveBinaryScore) && (getScriptFile().suffix().toLower() != "nxscore"))
+        remplaceInFunction(&scoreContent, "//GUI: NEVER EVER REMOVE THIS LINE\n", Application::current->serialize(false) + QString("\t%1 %2\n").arg(SCOREBINARY_MARKER).arg(NxScoreBinary::getFilename(getScriptFile()).fileName()));
+    else
+        remplaceInFunction(&scoreContent, "//GUI: NEVER EVER REMOVE THIS LINE\n", Application::current->serialize());
     NxObjectDispatchProperty::source = ExecuteSourceNetwork;
     remplaceInFunction(&scoreContent, "//INTERFACES: NEVER EVER REMOVE THIS LINE\n", Application::current->serialize());
     remplaceInFunction(&scoreContent, " *\t//APP VERSION: NEVER EVER REMOVE THIS LINE\n", QString(" *\tMade with IanniX %1").arg(QCoreApplication::applicationVersion()));
@@ -317,6 +325,7 @@ void NxDocument::askFileClose() {
     if(fileItem)
             fileItem->setIcon(0, UiFileItem::iconFile);
     clear();
+    undoJournal.clear();
 }
 void NxDocument::restoreDefaults() {
     Render::defaultColors.insert("background_texture_tint"          , QColor(255, 255, 255, 255));
@@ -33,6 +33,9 @@
 #include <QFileSystemWatcher>
 #include "misc/application.h"
 #include "objects/nxgroup.h"
+#include "objects/nxtriggerindex.h"
+#include "objects/nxpickindex.h"
+#include "objects/nxundojournal.h"
 #include "interfaces/extscriptvariableask.h"
 
 #include "gui/uimessagebox.h"
@@ -54,10 +57,9 @@ public slots:
     void askFileClose();
     void open();
     void save();
+    void stopSnapshot();
 private:
     bool isLoaded;
-    QList<QString> snapshots;
-    quint16 snapshotsIndex;
     QFileInfo hiddenFilename;
 public:
     explicit NxDocument(ApplicationCurrent *parent, UiFileItem *_fileItem = 0);
@@ -72,7 +74,7 @@ public:
 
     void setHiddenFilename(const QFileInfo &_hiddenFilename) { hiddenFilename = _hiddenFilename; }
 
-    const QString serialize() const;
+    const QString serialize(bool withObjects = true) const;
     void pushSnapshot();
     void popSnapshot(bool revert=false);
     void updateCode(bool fromFile, bool raiseWindow);
@@ -83,6 +85,9 @@ public:
 public:
     QMap<QString, NxGroup*> groups;
     QHash<quint16, NxObject*> objects;
+    NxTriggerIndex triggerIndex;
+    NxPickIndex pickIndex;
+    NxUndoJournal undoJournal;
 
 private:
     NxObject *currentObject;
@@ -113,13 +118,43 @@ public:
             return 0;
     }
     inline quint16 nextAvailableId() const {
-        //return objects.count();
-        quint16 nextId = 0;
-        for(quint16 index = 0 ; index < objects.count() ; index++)
-            if(objects.keys().at(index) > nextId)
-                nextId = objects.keys().at(index);
-        return nextId+1;
+        return objectsMaxId+1;
     }
+    inline void insertObject(quint16 id, NxObject *object) {
+        objects.insert(id, object);
+        if(id > objectsMaxId)
+            objectsMaxId = id;
+    }
+    inline void removeObject(quint16 id) {
+        objects.remove(id);
+        while((objectsMaxId > 0) && (!objects.contains(objectsMaxId)))
+            objectsMaxId--;
+    }
+    inline void insertGroupObject(NxGroup *group, quint8 activity, quint8 type, NxObject *object) {
+        //Counters follow the real size of the group tables (an insert may replace an object)
+        QHash<quint16, NxObject*> &groupObjects = group->objects[activity][type];
+        qint32 countOld = groupObjects.count();
+        if(type == ObjectsTypeTrigger)
+            Render::triggersRevision++;
+        groupObjects.insert(object->getId(), object);
+        objectsCount[activity][type] += groupObjects.count() - countOld;
+    }
+    inline void removeGroupObject(NxGroup *group, quint8 activity, quint8 type, quint16 id) {
+        if(type == ObjectsTypeTrigger)
+            Render::triggersRevision++;
+        objectsCount[activity][type] -= group->objects[activity][type].remove(id);
+    }
+    inline quint32 getCount(qint8 objectType = -1, qint8 activity = -1) const {
+        quint32 counter = 0;
+        for(quint16 activityIterator = 0 ; activityIterator < ObjectsActivityLenght ; activityIterator++)
+            for(quint16 typeIterator = 0 ; typeIterator < ObjectsTypeLength ; typeIterator++)
+                if(((objectType < 0) || (typeIterator == objectType)) && ((activity < 0) || (activityIterator == activity)))
+                    counter += objectsCount[activityIterator][typeIterator];
+        return counter;
+    }
+private:
+    quint16 objectsMaxId;
+    quint32 objectsCount[ObjectsActivityLenght][ObjectsTypeLength];
 
 
 
@@ -142,7 +177,7 @@ public:
     inline QString incomingMessage(const MessageIncomming &source, bool needOutput = false, bool = true) {
         if(scriptOnIncomingMessage.isValid()) {
             QString argumentsStr;
-            foreach(const QString &argument, source.arguments)
+            foreach(const QString &argument, source.getArguments())
                 argumentsStr += "\"" + argument + "\",";
             argumentsStr.chop(1);
             if(needOutput)  return scriptOnIncomingMessage.call(QScriptValue(), QScriptValueList() << source.protocol << source.host << source.port.toString() << source.destination << scriptEngine.evaluate(QString("[%5]").arg(argumentsStr))).toString();
@@ -162,6 +197,7 @@ public slots:
     void ask(const QString & group, const QString & prompt, const QString & value, const QString & def)     {   return variable->ask(group, prompt, value, def);                                        }
     void meta(const QString & meta)                                                                         {   return variable->meta(meta);                                                            }
     const QVariant execute(const QString & command) const                                                   {   return Application::current->execute(command, source, createNewObjectIfExists, true);   }
+    const QVariant addBatch(const QScriptValue & items, const QString & type) const                         {   return Application::current->executeBatch(items, type);                                 }
     const QVariant load(QString filename) {
         QString retour;
         if((!QFile().exists(filename)) && (fileItem))
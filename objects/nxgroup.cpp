@@ -22,6 +22,7 @@
 */
 
 #include "nxgroup.h"
+#include "nxscorebinary.h"
 
 NxGroup::NxGroup(ApplicationCurrent *parent, QTreeWidgetItem *ccParentItem) :
     QObject(parent), QTreeWidgetItem(ccParentItem) {
@@ -49,7 +50,7 @@ void NxGroup::widgetClick(int col) {
 }
 
 
-const QString NxGroup::serialize() const {
+const QString NxGroup::serialize(bool withObjects) const {
     QString retour;
 
     foreach(const QString &command, propertiesToSerialize.value(NxObjectDispatchProperty::source))
@@ -63,6 +64,8 @@ const QString NxGroup::serialize() const {
         for(quint16 typeIterator = 0 ; typeIterator < ObjectsTypeLength ; typeIterator++) {
             //Browse objects
             foreach(NxObject *object, objects[activityIterator][typeIterator]) {
+                if((!withObjects) && (NxScoreBinary::isStored(object)))
+                    continue;
                 if(((typeIterator == ObjectsTypeCursor) && (((NxCursor*)object)->getCurve() == 0)) || (typeIterator == ObjectsTypeCurve) || (typeIterator == ObjectsTypeTrigger))
                     retour += object->serialize();
             }
@@ -29,6 +29,7 @@
 #include "nxtrigger.h"
 #include "nxcursor.h"
 #include "nxcurve.h"
+#include "nxtriggerbatch.h"
 
 class NxGroup : public QObject, public NxObjectDispatchProperty, public QTreeWidgetItem {
     Q_OBJECT
@@ -94,6 +95,7 @@ public:
 public:
     //activity + type + objectID = object !
     QHash< quint16, NxObject* > objects[ObjectsActivityLenght][ObjectsTypeLength];
+    NxTriggerBatch triggerBatches[ObjectsActivityLenght];
     NxPoint rotation, rotationDest, translation, translationDest;
     qreal   scale, scaleDest;
 
@@ -131,7 +133,7 @@ public:
     void widgetClick(int col);
 
 public:
-    const QString serialize() const;
+    const QString serialize(bool withObjects = true) const;
     inline void dispatchPropertyToGroup(const char *_property, const QVariant & value) {
         propertyChanged(_property);
         setProperty(_property, value);
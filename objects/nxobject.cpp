@@ -60,6 +60,7 @@ void NxObject::initialize(bool firstTime) {
 
 void NxObject::setMessagePatterns(const QString & messagePatternsStr) {
     messagePatterns.clear();
+    messageArguments.clear();
     messageLabel.clear();
     performCollision = false;
 
@@ -136,6 +137,8 @@ void NxObject::setMessagePatterns(const QString & messagePatternsStr) {
         messagePatterns.append(messagePattern);
 
     foreach(const QVector<QByteArray> &messagePatternItems, messagePatterns) {
+        messageArguments.append(MessageArgument::compile(messagePatternItems));
+
         QString messageLabelStr;
         foreach(const QByteArray &messagePatternItem, messagePatternItems)
             messageLabelStr.append(messagePatternItem + " ");
@@ -203,10 +206,16 @@ QVector< QVector<QByteArray> > NxObject::parseMessagesPattern(const QString & me
 }
 
 void NxObject::dispatchProperty(const char *_property, const QVariant & value) {
-    QStringList asCurvePoints = QStringList() << COMMAND_CURVE_POINT_RMV << COMMAND_CURVE_TXT << COMMAND_CURVE_LINES << COMMAND_CURVE_POINT << COMMAND_CURVE_POINT_TRANSLATE << COMMAND_CURVE_POINT_SHIFT << COMMAND_CURVE_EDITOR << COMMAND_CURVE_RESAMPLE << COMMAND_CURVE_PATH << COMMAND_CURVE_POINT_SMOOTH << COMMAND_CURVE_POINT_X << COMMAND_CURVE_POINT_Y << COMMAND_CURVE_POINT_Z << COMMAND_CURVE_POINT_TRANSLATE2;
-    QStringList forbiddenActions = QStringList() << COMMAND_POS_TRANSLATE;
-    if(asCurvePoints.contains(QString(_property)))              propertyChanged(COMMAND_CURVE_POINT);
-    else if(!forbiddenActions.contains(QString(_property)))     propertyChanged(_property);
+    //Curve point edits are serialized as a whole, translations are never serialized
+    static const char *asCurvePoints[] = { COMMAND_CURVE_POINT_RMV, COMMAND_CURVE_TXT, COMMAND_CURVE_LINES, COMMAND_CURVE_POINT, COMMAND_CURVE_POINT_TRANSLATE, COMMAND_CURVE_POINT_SHIFT, COMMAND_CURVE_EDITOR, COMMAND_CURVE_RESAMPLE, COMMAND_CURVE_PATH, COMMAND_CURVE_POINT_SMOOTH, COMMAND_CURVE_POINT_X, COMMAND_CURVE_POINT_Y, COMMAND_CURVE_POINT_Z, COMMAND_CURVE_POINT_TRANSLATE2, 0 };
+    bool isCurvePoint = false;
+    for(const char **asCurvePoint = asCurvePoints ; (*asCurvePoint) && (!isCurvePoint) ; asCurvePoint++)
+        isCurvePoint = (qstrcmp(_property, *asCurvePoint) == 0);
+    Application::current->journalObjectProperty(this, _property);
+    if(getType() == ObjectsTypeTrigger)
+        Render::triggersRevision++;
+    if(isCurvePoint)                                        propertyChanged(COMMAND_CURVE_POINT);
+    else if(qstrcmp(_property, COMMAND_POS_TRANSLATE) != 0) propertyChanged(_property);
     setProperty(_property, value);
 }
 
@@ -38,6 +38,7 @@
 #include "iannix_cmd.h"
 #include "misc/application.h"
 #include "transport/transport.h"
+#include "messages/messageargument.h"
 
 #define ObjectsTypeLength       3
 #define ObjectsActivityLenght   2
@@ -101,12 +102,12 @@ protected:
     QColor  color, colorActiveColor, colorInactiveColor, colorMultiplyColor;
     QString colorActive, colorInactive, colorMultiply;
     bool colorGlobal;
-    NxRect boundingRect;
+    NxRect boundingRect, paintBoundingRect;
     QString label;
     QStringList messageLabel;
     bool selectedHover, selected, hasActivity, hasActivityOld;
     QVector< QVector<QByteArray> > messagePatterns;
-    QDateTime messageTime;
+    QVector< QVector<MessageArgument> > messageArguments;
     qint64 messageTimeNowOld;
     quint16 messageTimeInterval;
     NxObject *parentObject;
@@ -129,12 +130,16 @@ public slots:
     }
 
     inline void setSelectedHover(bool _selectedHover) {
+        if((selectedHover != _selectedHover) && (getType() == ObjectsTypeTrigger))
+            Render::triggersRevision++;
         selectedHover = _selectedHover;
     }
     inline bool getSelectedHover() const {
         return selectedHover;
     }
     inline void setSelected(bool _selected) {
+        if((selected != _selected) && (getType() == ObjectsTypeTrigger))
+            Render::triggersRevision++;
         selected = _selected;
     }
     inline bool getSelected() const {
@@ -264,9 +269,13 @@ public slots:
     }
 
     inline virtual void dragStart(const NxPoint &, bool) {
+        journal(COMMAND_POS);
         posDrag = pos;
         isDrag = true;
     }
+    inline void journal(const char *_property) {
+        Application::current->journalObjectProperty(this, _property);
+    }
     inline virtual void drag(const NxPoint &translation, const NxPoint &, bool) {
         dragParent(translation);
     }
@@ -284,6 +293,13 @@ public slots:
     inline const NxRect & getBoundingRect() const {
         return boundingRect;
     }
+    //Copied while the GUI thread holds the document, the drawing culls against it
+    inline void paintSnapshotBoundingRect() {
+        paintBoundingRect = boundingRect;
+    }
+    inline const NxRect & getPaintBoundingRect() const {
+        return paintBoundingRect;
+    }
 
     inline void setActive(quint16 _active) {
         quint16 activeOld = active;
@@ -398,6 +414,9 @@ public slots:
     inline const QVector< QVector<QByteArray> > & getMessagePatterns() const {
         return messagePatterns;
     }
+    inline const QVector< QVector<MessageArgument> > & getMessageArguments() const {
+        return messageArguments;
+    }
     inline const QString getMessagePatternsStr() const {
         QString messagePatternsStr;
         foreach(const QVector<QByteArray> & messagePattern, messagePatterns) {
@@ -409,7 +428,7 @@ public slots:
         return messagePatternsStr.trimmed();
     }
     inline bool canSendOsc() {
-        qint64 messageTimeNow = messageTime.currentMSecsSinceEpoch();
+        qint64 messageTimeNow = Transport::currentMSecsSinceEpoch;
         if((messageTimeInterval > 0) && ((messageTimeNow - messageTimeNowOld) >= messageTimeInterval)) {
             messageTimeNowOld = messageTimeNow;
             return true;
@@ -0,0 +1,136 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <QtAlgorithms>
+#include <algorithm>
+#include "nxpickindex.h"
+
+static bool objectIdLessThan(const NxObject *object1, const NxObject *object2) {
+    return object1->getId() < object2->getId();
+}
+
+bool NxPickIndex::addCells(const NxRect &_rect, QVector<quint64> *keys) {
+    NxRect rect = _rect.normalized();
+    qint32 xMin = getCellCoord(rect.left()), xMax = getCellCoord(rect.right());
+    qint32 yMin = getCellCoord(rect.top()),  yMax = getCellCoord(rect.bottom());
+    if(((qint64)(xMax - xMin + 1) * (qint64)(yMax - yMin + 1) + keys->count()) > PICKINDEX_CELLS_MAX)
+        return false;
+    for(qint32 x = xMin ; x <= xMax ; x++)
+        for(qint32 y = yMin ; y <= yMax ; y++)
+            keys->append(getCellKey(x, y));
+    return true;
+}
+
+void NxPickIndex::update(NxObject *object) {
+    //One box per segment for curves made of points (long curves only fill the cells they cross), the global box otherwise
+    QVector<quint64> keys;
+    bool fits = true;
+    NxCurve *curve = (NxCurve*)object;
+    if((object->getType() == ObjectsTypeCurve) && (curve->getCurveType() == CurveTypePoints) && (curve->getPathPointsCount() > 1)) {
+        for(quint16 indexPoint = 1 ; (indexPoint < curve->getPathPointsCount()) && (fits) ; indexPoint++)
+            fits = addCells(curve->getPathPointsAt(indexPoint).boundingRect, &keys);
+    }
+    else
+        fits = addCells(object->getBoundingRect(), &keys);
+    if(fits) {
+        qSort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    }
+    else
+        keys.clear();
+
+    //Nothing to do if the object stays in the same cells
+    QHash<NxObject*, QVector<quint64> >::const_iterator objectIterator = objects.constFind(object);
+    if((objectIterator != objects.constEnd()) && (objectIterator.value() == keys))
+        return;
+
+    remove(object);
+    if(keys.isEmpty())
+        objectsLarge.append(object);
+    else
+        foreach(quint64 key, keys)
+            cells[key].append(object);
+    objects.insert(object, keys);
+}
+void NxPickIndex::remove(NxObject *object) {
+    QHash<NxObject*, QVector<quint64> >::iterator objectIterator = objects.find(object);
+    if(objectIterator == objects.end())
+        return;
+
+    //Swap with the last object of each cell
+    if(objectIterator.value().isEmpty()) {
+        qint32 index = objectsLarge.indexOf(object);
+        if(index >= 0) {
+            objectsLarge[index] = objectsLarge.last();
+            objectsLarge.remove(objectsLarge.count()-1);
+        }
+    }
+    foreach(quint64 key, objectIterator.value()) {
+        QHash<quint64, QVector<NxObject*> >::iterator cellIterator = cells.find(key);
+        if(cellIterator == cells.end())
+            continue;
+        QVector<NxObject*> &cell = cellIterator.value();
+        qint32 index = cell.indexOf(object);
+        if(index >= 0) {
+            cell[index] = cell.last();
+            cell.remove(cell.count()-1);
+        }
+        if(cell.isEmpty())
+            cells.erase(cellIterator);
+    }
+    objects.erase(objectIterator);
+}
+
+void NxPickIndex::query(const NxRect &_area, QVector<NxObject*> *result) const {
+    //Candidates only : the caller refines them with the exact test of each object
+    NxRect area = _area.normalized();
+    qint32 xMin = getCellCoord(area.left()), xMax = getCellCoord(area.right());
+    qint32 yMin = getCellCoord(area.top()),  yMax = getCellCoord(area.bottom());
+
+    //Large areas (zoomed out scores): browsing filled cells is cheaper
+    if(((qint64)(xMax - xMin + 1) * (qint64)(yMax - yMin + 1)) > cells.count()) {
+        QHashIterator<quint64, QVector<NxObject*> > cellIterator(cells);
+        while(cellIterator.hasNext()) {
+            cellIterator.next();
+            qint32 x = (qint32)(cellIterator.key() >> 32), y = (qint32)(cellIterator.key() & 0xFFFFFFFF);
+            if((x >= xMin) && (x <= xMax) && (y >= yMin) && (y <= yMax))
+                *result += cellIterator.value();
+        }
+    }
+    else {
+        for(qint32 x = xMin ; x <= xMax ; x++) {
+            for(qint32 y = yMin ; y <= yMax ; y++) {
+                QHash<quint64, QVector<NxObject*> >::const_iterator cellIterator = cells.constFind(getCellKey(x, y));
+                if(cellIterator != cells.constEnd())
+                    *result += cellIterator.value();
+            }
+        }
+    }
+    *result += objectsLarge;
+
+    //Objects spread on several cells are returned once, in the same order whatever the layout of the grid
+    qSort(result->begin(), result->end());
+    result->erase(std::unique(result->begin(), result->end()), result->end());
+    qSort(result->begin(), result->end(), objectIdLessThan);
+}
@@ -0,0 +1,68 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+
+#ifndef NXPICKINDEX_H
+#define NXPICKINDEX_H
+
+#include <QHash>
+#include <QVector>
+#include "nxcurve.h"
+
+#define PICKINDEX_CELL_SIZE     1.
+#define PICKINDEX_CELLS_MAX     1024    //Objects spreading on more cells are always returned
+
+class NxPickIndex {
+public:
+    explicit NxPickIndex() {}
+
+private:
+    //Uniform grid of curves (one box per segment) and triggers, used by mouse hover and rubber-band selection
+    QHash<quint64, QVector<NxObject*> > cells;
+    QHash<NxObject*, QVector<quint64> > objects;
+    QVector<NxObject*> objectsLarge;
+
+private:
+    static inline qint32 getCellCoord(qreal val) {
+        return qFloor(val / PICKINDEX_CELL_SIZE);
+    }
+    static inline quint64 getCellKey(qint32 x, qint32 y) {
+        return (((quint64)(quint32)x) << 32) | (quint32)y;
+    }
+    static bool addCells(const NxRect &rect, QVector<quint64> *keys);
+
+public:
+    void update(NxObject *object);
+    void remove(NxObject *object);
+    void query(const NxRect &area, QVector<NxObject*> *result) const;
+    inline bool contains(NxObject *object) const {
+        return objects.contains(object);
+    }
+    inline quint32 getCount() const {
+        return objects.count();
+    }
+};
+
+#endif // NXPICKINDEX_H
@@ -0,0 +1,281 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <string.h>
+#include "nxscorebinary.h"
+#include "nxdocument.h"
+
+//Plain values are copied byte by byte, so the mapped file never has to be aligned
+template<typename T> static inline void scoreBinaryWrite(QByteArray *buffer, T value) {
+    buffer->append((const char*)&value, sizeof(T));
+}
+class NxScoreBinaryReader {
+public:
+    explicit NxScoreBinaryReader(const uchar *_data, qint64 size) {
+        data = _data;
+        end  = _data + size;
+        ok   = true;
+    }
+    template<typename T> inline T read() {
+        T value = 0;
+        if((ok) && (data + sizeof(T) <= end)) {
+            memcpy(&value, data, sizeof(T));
+            data += sizeof(T);
+        }
+        else
+            ok = false;
+        return value;
+    }
+    inline const char* readBytes(quint32 length) {
+        if((ok) && (data + length <= end)) {
+            const char *bytes = (const char*)data;
+            data += length;
+            return bytes;
+        }
+        ok = false;
+        return 0;
+    }
+public:
+    const uchar *data, *end;
+    bool ok;
+};
+
+
+bool NxScoreBinary::save(const NxDocument *document, const QString &filename) {
+    //Same order as the script serialization: each curve is followed by its cursors
+    QList<const NxObject*> objects;
+    foreach(const NxGroup *group, document->groups) {
+        for(quint16 activityIterator = 0 ; activityIterator < ObjectsActivityLenght ; activityIterator++) {
+            for(quint16 typeIterator = 0 ; typeIterator < ObjectsTypeLength ; typeIterator++) {
+                foreach(const NxObject *object, group->objects[activityIterator][typeIterator]) {
+                    if(!isStored(object))
+                        continue;
+                    if(((typeIterator == ObjectsTypeCursor) && (((const NxCursor*)object)->getCurve() == 0)) || (typeIterator == ObjectsTypeTrigger))
+                        objects.append(object);
+                    else if(typeIterator == ObjectsTypeCurve) {
+                        objects.append(object);
+                        foreach(const NxObject *cursor, ((const NxCurve*)object)->getCursors())
+                            if(isStored(cursor))
+                                objects.append(cursor);
+                    }
+                }
+            }
+        }
+    }
+
+    //Objects
+    QHash<QString, quint16> names;
+    QStringList namesList;
+    QByteArray body;
+    foreach(const NxObject *object, objects) {
+        const NxCurve *curve = (object->getType() == ObjectsTypeCurve)?((const NxCurve*)object):(0);
+        quint16 curveId = 0;
+        if((object->getType() == ObjectsTypeCursor) && (((const NxCursor*)object)->getCurve()))
+            curveId = ((const NxCursor*)object)->getCurve()->getId();
+
+        //Properties in the order they were set, as in NxObject::serialize()
+        QList< QPair<QString, QString> > values;
+        quint32 pointsCount = 0;
+        foreach(const QString &command, object->getPropertiesToSerialize(ExecuteSourceGui)) {
+            if((command == COMMAND_ID) || (command == COMMAND_CURSOR_CURVE))
+                continue;
+            else if((curve) && (command == COMMAND_CURVE_EQUATION_PARAM)) {
+                QHashIterator<QString, qreal> equationVariablesIterator(curve->getEquationVariables());
+                while(equationVariablesIterator.hasNext()) {
+                    equationVariablesIterator.next();
+                    values.append(qMakePair(command, QString("%1 %2").arg(equationVariablesIterator.key()).arg(equationVariablesIterator.value())));
+                }
+            }
+            else if((curve) && (command == COMMAND_CURVE_POINT)) {
+                pointsCount = curve->getPathPointsCount();
+                values.append(qMakePair(command, QString()));
+            }
+            else if((curve) && (curve->getCurveType() == CurveTypePoints) && ((command == COMMAND_RESIZE) || (command == COMMAND_RESIZEF)))
+                continue;
+            else
+                values.append(qMakePair(command, object->getProperty(qPrintable(command)).toString()));
+        }
+
+        scoreBinaryWrite<quint8> (&body, object->getType());
+        scoreBinaryWrite<quint16>(&body, object->getId());
+        scoreBinaryWrite<quint16>(&body, curveId);
+        scoreBinaryWrite<quint16>(&body, values.count());
+        scoreBinaryWrite<quint32>(&body, pointsCount);
+        for(quint32 pointIndex = 0 ; pointIndex < pointsCount ; pointIndex++) {
+            const NxCurvePoint &point = curve->getPathPointsAt(pointIndex);
+            double coords[19] = { point.x(),    point.y(),    point.z(),    point.sx(),    point.sy(),    point.sz(),
+                                  point.c1.x(), point.c1.y(), point.c1.z(), point.c1.sx(), point.c1.sy(), point.c1.sz(),
+                                  point.c2.x(), point.c2.y(), point.c2.z(), point.c2.sx(), point.c2.sy(), point.c2.sz(),
+                                  (double)point.smooth };
+            body.append((const char*)coords, sizeof(coords));
+        }
+        for(quint16 valueIndex = 0 ; valueIndex < values.count() ; valueIndex++) {
+            const QString &name = values.at(valueIndex).first;
+            if(!names.contains(name)) {
+                names.insert(name, namesList.count());
+                namesList.append(name);
+            }
+            QByteArray value = values.at(valueIndex).second.toUtf8();
+            scoreBinaryWrite<quint16>(&body, names.value(name));
+            scoreBinaryWrite<quint32>(&body, value.length());
+            body.append(value);
+        }
+    }
+
+    //Header and property names
+    QByteArray header(SCOREBINARY_MAGIC);
+    scoreBinaryWrite<quint32>(&header, SCOREBINARY_VERSION);
+    scoreBinaryWrite<quint32>(&header, namesList.count());
+    scoreBinaryWrite<quint32>(&header, objects.count());
+    foreach(const QString &name, namesList) {
+        QByteArray nameBytes = name.toUtf8();
+        scoreBinaryWrite<quint16>(&header, nameBytes.length());
+        header.append(nameBytes);
+    }
+
+    QFile file(filename);
+    if(!file.open(QIODevice::WriteOnly))
+        return false;
+    file.write(header);
+    file.write(body);
+    file.close();
+    return true;
+}
+
+qint32 NxScoreBinary::load(NxDocument *document, QTreeWidgetItem *treeRoot, const QString &filename) {
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    //Memory-mapped when possible, read in one go otherwise
+    QByteArray fileContent;
+    const uchar *data = file.map(0, file.size());
+    if(!data) {
+        fileContent = file.readAll();
+        data = (const uchar*)fileContent.constData();
+    }
+    NxScoreBinaryReader reader(data, file.size());
+
+    //Header
+    const char *magic = reader.readBytes(4);
+    if((!magic) || (memcmp(magic, SCOREBINARY_MAGIC, 4)) || (reader.read<quint32>() != SCOREBINARY_VERSION)) {
+        qDebug("Binary score %s has an unknown format", qPrintable(filename));
+        return -1;
+    }
+    quint32 namesCount   = reader.read<quint32>();
+    quint32 objectsCount = reader.read<quint32>();
+    QList<QByteArray> names;
+    for(quint32 nameIndex = 0 ; (reader.ok) && (nameIndex < namesCount) ; nameIndex++) {
+        quint16 length = reader.read<quint16>();
+        const char *name = reader.readBytes(length);
+        names.append(QByteArray(name, (name)?(length):(0)));
+    }
+
+    //Objects, bulk-inserted and attached to the inspector tree at the end
+    NxObjectDispatchProperty::source = ExecuteSourceGui;
+    QList<QTreeWidgetItem*> treeItems;
+    QHash<quint16, quint16> idsRemapped;
+    NxObject *object = 0;
+    quint32 objectIndex = 0;
+    for(objectIndex = 0 ; (reader.ok) && (objectIndex < objectsCount) ; objectIndex++) {
+        quint8  type        = reader.read<quint8> ();
+        quint16 id          = reader.read<quint16>();
+        quint16 curveId     = reader.read<quint16>();
+        quint16 valuesCount = reader.read<quint16>();
+        quint32 pointsCount = reader.read<quint32>();
+        if(!reader.ok)
+            break;
+
+        //Ids already used by the script are moved to the next free one, cursors follow their curve
+        if((id == 0) || (document->objects.contains(id))) {
+            quint16 idFile = id;
+            id = document->nextAvailableId();
+            idsRemapped.insert(idFile, id);
+            qDebug("Binary score %s : object #%d already exists, loaded as #%d", qPrintable(filename), idFile, id);
+        }
+        if((curveId) && (idsRemapped.contains(curveId)))
+            curveId = idsRemapped.value(curveId);
+
+        QList<NxCurvePoint> points;
+        points.reserve(pointsCount);
+        for(quint32 pointIndex = 0 ; (reader.ok) && (pointIndex < pointsCount) ; pointIndex++) {
+            double coords[19];
+            const char *bytes = reader.readBytes(sizeof(coords));
+            if(!bytes)
+                break;
+            memcpy(coords, bytes, sizeof(coords));
+            NxCurvePoint point;
+            point.setX (coords[0]); point.setY (coords[1]); point.setZ (coords[2]);
+            point.setSx(coords[3]); point.setSy(coords[4]); point.setSz(coords[5]);
+            point.c1 = NxPoint(coords[6],  coords[7],  coords[8],  coords[9],  coords[10], coords[11]);
+            point.c2 = NxPoint(coords[12], coords[13], coords[14], coords[15], coords[16], coords[17]);
+            point.smooth = (coords[18] != 0);
+            points.append(point);
+        }
+
+        if(type == ObjectsTypeCurve)        object = new NxCurve  (Application::current, 0);
+        else if(type == ObjectsTypeCursor)  object = new NxCursor (Application::current, 0);
+        else                                object = new NxTrigger(Application::current, 0);
+        object->setInitialId(id);
+        object->setText(3, QString::number(id));
+        object->propertyChanged(COMMAND_ID);
+        object->setGroupId("");
+        if((type == ObjectsTypeCursor) && (curveId)) {
+            NxObject *curve = document->getObject(curveId);
+            if((curve) && (curve->getType() == ObjectsTypeCurve)) {
+                ((NxCursor*)object)->setCurve((NxCurve*)curve);
+                ((NxCursor*)object)->calculate();
+                object->propertyChanged(COMMAND_CURSOR_CURVE);
+            }
+        }
+
+        for(quint16 valueIndex = 0 ; (reader.ok) && (valueIndex < valuesCount) ; valueIndex++) {
+            quint16 nameIndex = reader.read<quint16>();
+            quint32 length    = reader.read<quint32>();
+            const char *value = reader.readBytes(length);
+            if((!reader.ok) || (nameIndex >= names.count()))
+                break;
+
+            const QByteArray &name = names.at(nameIndex);
+            if((type == ObjectsTypeCurve) && (name == COMMAND_CURVE_POINT)) {
+                object->propertyChanged(COMMAND_CURVE_POINT);
+                ((NxCurve*)object)->setPathPoints(points);
+            }
+            else
+                object->dispatchProperty(name.constData(), QString::fromUtf8(value, length));
+        }
+
+        //Registered in its group table like the "add" command (setGroupId("") alone leaves ungrouped objects out)
+        Application::current->setObjectActivity(object, ObjectsActivityInactive);
+        document->insertObject(id, object);
+        treeItems.append(object);
+    }
+    treeRoot->addChildren(treeItems);
+    if(object)
+        document->setCurrentObject(object);
+
+    if(!reader.ok)
+        qDebug("Binary score %s is truncated (%d objects of %u loaded)", qPrintable(filename), treeItems.count(), objectsCount);
+    return treeItems.count();
+}
@@ -0,0 +1,60 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef NXSCOREBINARY_H
+#define NXSCOREBINARY_H
+
+#include <QFile>
+#include <QFileInfo>
+#include <QByteArray>
+#include <QTreeWidgetItem>
+#include "nxobject.h"
+
+#define SCOREBINARY_MAGIC       "NXB1"
+#define SCOREBINARY_VERSION     1
+#define SCOREBINARY_MARKER      "//BINARY OBJECTS:"
+
+class NxDocument;
+
+//Companion file (.nxbin) holding the objects of a score, next to its script.
+//Layout (native byte order):
+//  header   magic, quint32 version, quint32 names count, quint32 objects count
+//  names    quint16 length + property name, for every property used in the file
+//  objects  quint8 type, quint16 id, quint16 curve id (cursors), quint16 values count, quint32 points count,
+//           points as 19 doubles (x y z sx sy sz, c1, c2, smooth),
+//           values as quint16 name index + quint32 length + UTF-8 value
+class NxScoreBinary {
+public:
+    static inline const QFileInfo getFilename(const QFileInfo &scoreFile) {
+        return QFileInfo(scoreFile.absolutePath() + "/" + scoreFile.completeBaseName() + ".nxbin");
+    }
+    //Only objects made through the GUI are stored, script-made objects are rebuilt by the script
+    static inline bool isStored(const NxObject *object) {
+        return object->getPropertiesToSerialize(ExecuteSourceGui).contains(COMMAND_ID);
+    }
+    static bool save(const NxDocument *document, const QString &filename);
+    static qint32 load(NxDocument *document, QTreeWidgetItem *treeRoot, const QString &filename);
+};
+
+#endif // NXSCOREBINARY_H
@@ -22,13 +22,16 @@
 */
 
 #include "nxtrigger.h"
+#include "nxtriggerbatch.h"
 
 GLuint NxTrigger::glListTrigger = 0;
+QList< QPointer<NxTrigger> > NxTrigger::paintPendings;
 
 NxTrigger::NxTrigger(ApplicationCurrent *parent, QTreeWidgetItem *ccParentItem) :
     NxObject(parent, ccParentItem) {
     cacheSize = 0;
     cursorTrigged = 0;
+    paintTrigged = paintPending = false;
     lastTrigTime = 0;
     setText(0, tr("TRIGGER"));
 
@@ -46,9 +49,12 @@ void NxTrigger::initializeCustom() {
 }
 
 void NxTrigger::paint() {
+    paint(0);
+}
+bool NxTrigger::paint(NxTriggerBatch *batch) {
     //Color
-    if(cursorTrigged)
-        color = colorTrigged;
+    if(paintTrigged)
+        color = paintColorTrigged;
     else if(active) {
         if(colorActive.isEmpty())                                                                                   color = colorActiveColor;
         else if((colorActive.startsWith("_")) && (Render::colors->contains(Application::colorsPrefix() + colorActive)))  color = Render::colors->value(Application::colorsPrefix() + colorActive);
@@ -66,12 +72,6 @@ void NxTrigger::paint() {
                   qBound(qreal(0.), color.blue()  * colorMultiplyColor.blueF(),  qreal(255.)),
                   qBound(qreal(0.), color.alpha() * colorMultiplyColor.alphaF(), qreal(255.)));
 
-    //Size of trigger
-    if(cacheSize != Render::objectSize*size) {
-        cacheSize = Render::objectSize*size;
-        calcBoundingRect();
-    }
-
     if((color.alpha() > 0) && (cacheSize > 0)) {
         if(selectedHover)   color = Render::colors->value(Application::colorsPrefix() + "_gui_object_hover");
         if(selected)        color = Render::colors->value(Application::colorsPrefix() + "_gui_object_selection");
@@ -80,6 +80,15 @@ void NxTrigger::paint() {
         if(!Application::allowSelectionTriggers)
             color.setAlphaF(color.alphaF()/3);
 
+        //Batched drawing (plain shape only, labels and textures are drawn afterwards one by one)
+        if(batch) {
+            UiRenderTexture *texture = Render::textures->value((active)?(textureActive):(textureInactive), 0);
+            if((selectedHover) || ((Render::paintThisGroup) && (Application::paintLabel) && (!label.isEmpty())) || ((texture) && (texture->loaded) && (texture->mapping.width() != 0) && (texture->mapping.height() != 0)))
+                return false;
+            batch->append(pos, cacheSize, QColor::fromRgbF(color.redF(), color.greenF(), color.blueF(), (Render::paintThisGroup)?(color.alphaF()):(0.1)));
+            return true;
+        }
+
         if(Render::paintThisGroup)
             glColor4f(color.redF(), color.greenF(), color.blueF(), color.alphaF());
         else
@@ -163,6 +172,7 @@ void NxTrigger::paint() {
         //End
         glPopMatrix();
     }
+    return true;
 }
 
 void NxTrigger::trig(NxObject *cursor) {
@@ -171,13 +181,15 @@ void NxTrigger::trig(NxObject *cursor) {
         colorTrigged.setAlpha(255);
     }
     cursorTrigged = cursor;
+    paintChanged();
     MessageManager::outgoingMessage(MessageManagerDestination(this, this, cursorTrigged));
-    if(triggerOff > 0)  QTimer::singleShot(triggerOff*1000, this, SLOT(trigEnd()));
+    if(triggerOff > 0)  Application::current->setObjectTrigEnd(this, triggerOff);
     else                trigEnd();
 }
 void NxTrigger::trigEnd() {
     NxObject *cursorTriggedTmp = cursorTrigged;
     cursorTrigged = 0;
+    paintChanged();
     if(triggerOff > 0) {
         bool sendMessage = false;
         foreach(const QVector<QByteArray> & messagePattern, this->getMessagePatterns()) {
@@ -190,3 +202,17 @@ void NxTrigger::trigEnd() {
             MessageManager::outgoingMessage(MessageManagerDestination(this, this, cursorTriggedTmp));
     }
 }
+
+//Trigged states changed by the scheduler, copied while the GUI thread holds the document
+void NxTrigger::paintSnapshot() {
+    if(!paintPendings.isEmpty())
+        Render::triggersRevision++;
+    foreach(const QPointer<NxTrigger> &trigger, paintPendings) {
+        if(trigger) {
+            trigger->paintTrigged      = (trigger->cursorTrigged != 0);
+            trigger->paintColorTrigged = trigger->colorTrigged;
+            trigger->paintPending      = false;
+        }
+    }
+    paintPendings.clear();
+}
@@ -24,10 +24,13 @@
 #ifndef NXTRIGGER_H
 #define NXTRIGGER_H
 
+#include <QPointer>
 #include "nxobject.h"
 #include "messages/messagemanager.h"
 #include "../abstractionsgl.h"
 
+class NxTriggerBatch;
+
 class NxTrigger : public NxObject {
     Q_OBJECT
 
@@ -46,6 +49,15 @@ private:
     QColor colorTrigged;
     qreal triggerOff;
     static GLuint glListTrigger;
+    bool paintTrigged, paintPending;
+    QColor paintColorTrigged;
+    static QList< QPointer<NxTrigger> > paintPendings;
+    inline void paintChanged() {
+        if(!paintPending) {
+            paintPending = true;
+            paintPendings.append(this);
+        }
+    }
 public:
     NxObject *cursorTrigged;
     qint64 lastTrigTime;
@@ -83,10 +95,16 @@ public:
 
 public:
     inline void calcBoundingRect() {
+        //Size of trigger
+        cacheSize = Render::objectSize*size;
+
         //Bounding rect
         boundingRect = NxRect(-cacheSize, -cacheSize, cacheSize*2, cacheSize*2);
         boundingRect.translate(pos);
         boundingRect = boundingRect.normalized();
+
+        //Collision grid
+        Application::current->setObjectPos(this);
     }
     inline bool isMouseHover(const NxPoint & mouse) {
         if(boundingRect.contains(mouse))
@@ -113,16 +131,16 @@ public:
 
 public:
     void trig(NxObject *cursor);
+    void trigEnd();
     bool getForceTrig() { return false;}
     void setForceTrig(bool) {
         trig(0);
     }
 
-private slots:
-    void trigEnd();
-
 public:
+    static void paintSnapshot();
     void paint();
+    bool paint(NxTriggerBatch *batch);
 };
 
 #endif // NXTRIGGER_H
@@ -0,0 +1,183 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <string.h>
+#include "nxtriggerbatch.h"
+
+QVector<GLuint> NxTriggerBatch::trianglesIndexes;
+QVector<GLuint> NxTriggerBatch::linesIndexes;
+
+NxTriggerBatch::NxTriggerBatch() :
+    vertexBuffer(QGLBuffer::VertexBuffer) {
+    count = 0;
+    dirtyFirst = dirtyLast = -1;
+    shapeChanged = true;
+    vertexBufferFailed = false;
+    walkDone = false;
+    walkRevision = 0;
+    walkFlags = 0;
+    walkObjectSize = 0;
+    walkCulled = walkDrawn = 0;
+}
+
+bool NxTriggerBatch::needsWalk(quint32 revision, const GLdouble *frustumMatrix) {
+    //Everything the color, the shape or the culling of a trigger reads besides the trigger itself
+    quint8 flags = 0;
+    if(Render::paintThisGroup)                          flags |= 0x01;
+    if(Application::paintLabel)                         flags |= 0x02;
+    if(Application::allowSelectionTriggers)             flags |= 0x04;
+    if(Application::colorTheme)                         flags |= 0x08;
+    if(Application::current->isObjectSoloActive)        flags |= 0x10;
+    if(Render::cullObjects)                             flags |= 0x20;
+
+    //Triggers only change through commands, selection, scheduler snapshots, groups, colors and textures (Render::triggersRevision, copied with the paint snapshot)
+    if((walkDone) && (walkRevision == revision) && (walkFlags == flags) && (walkObjectSize == Render::objectSize) && (shapeRotation == Render::rotation) && ((!Render::cullObjects) || (memcmp(walkFrustum, frustumMatrix, sizeof(walkFrustum)) == 0)))
+        return false;
+
+    walkDone       = true;
+    walkRevision   = revision;
+    walkFlags      = flags;
+    walkObjectSize = Render::objectSize;
+    memcpy(walkFrustum, frustumMatrix, sizeof(walkFrustum));
+    return true;
+}
+
+void NxTriggerBatch::begin() {
+    count = 0;
+
+    //Triggers always face the camera, so the shape follows the view rotation
+    if((shapeChanged) || (shapeRotation != Render::rotation)) {
+        shapeRotation = Render::rotation;
+        QMatrix4x4 rotation;
+        rotation.rotate(shapeRotation.z(), 0, 0, -1);
+        rotation.rotate(shapeRotation.x(), 0, -1, 0);
+        rotation.rotate(shapeRotation.y(), -1, 0, 0);
+
+        shape.resize(TRIGGERBATCH_VERTICES);
+        shape[0] = QVector3D(0, 0, 0);
+        for(quint16 segment = 0 ; segment < TRIGGERBATCH_SEGMENTS ; segment++) {
+            qreal drawAngle = 2 * M_PI * segment / TRIGGERBATCH_SEGMENTS;
+            shape[1 + segment]                          = rotation.map(QVector3D(0.5 * qCos(drawAngle), 0.5 * qSin(drawAngle), 0));
+            shape[1 + segment + TRIGGERBATCH_SEGMENTS]  = rotation.map(QVector3D(1.2 * qCos(drawAngle), 1.2 * qSin(drawAngle), 0));
+        }
+        shapeChanged = true;
+    }
+}
+
+void NxTriggerBatch::append(const NxPoint &pos, qreal size, const QColor &color) {
+    QRgb rgba = color.rgba();
+
+    //New slot
+    if(count >= (quint32)instances.count()) {
+        Instance instance;
+        instances.append(instance);
+        vertices.resize(instances.count() * TRIGGERBATCH_VERTICES);
+    }
+    //Unchanged trigger, vertices are already up to date
+    else if((!shapeChanged) && (instances.at(count).pos == pos) && (instances.at(count).size == size) && (instances.at(count).color == rgba)) {
+        count++;
+        return;
+    }
+
+    Instance &instance = instances[count];
+    instance.pos   = pos;
+    instance.size  = size;
+    instance.color = rgba;
+
+    Vertex *vertex = vertices.data() + count * TRIGGERBATCH_VERTICES;
+    for(quint16 index = 0 ; index < TRIGGERBATCH_VERTICES ; index++, vertex++) {
+        vertex->x = pos.x() + size * shape.at(index).x();
+        vertex->y = pos.y() + size * shape.at(index).y();
+        vertex->z = pos.z() + size * shape.at(index).z();
+        vertex->r = qRed(rgba);
+        vertex->g = qGreen(rgba);
+        vertex->b = qBlue(rgba);
+        vertex->a = qAlpha(rgba);
+    }
+
+    if((dirtyFirst < 0) || ((qint32)count < dirtyFirst))
+        dirtyFirst = count;
+    if((qint32)count > dirtyLast)
+        dirtyLast = count;
+    count++;
+}
+
+void NxTriggerBatch::paint() {
+    shapeChanged = false;
+    if(count == 0)
+        return;
+
+    //Same index pattern for every trigger, shared by all batches
+    if((quint32)trianglesIndexes.count() < count * TRIGGERBATCH_SEGMENTS * 3) {
+        for(quint32 instance = trianglesIndexes.count() / (TRIGGERBATCH_SEGMENTS * 3) ; instance < count ; instance++) {
+            GLuint base = instance * TRIGGERBATCH_VERTICES;
+            for(quint16 segment = 0 ; segment < TRIGGERBATCH_SEGMENTS ; segment++) {
+                quint16 segmentNext = (segment + 1) % TRIGGERBATCH_SEGMENTS;
+                trianglesIndexes << base << base + 1 + segment << base + 1 + segmentNext;
+                linesIndexes     << base + 1 + TRIGGERBATCH_SEGMENTS + segment << base + 1 + TRIGGERBATCH_SEGMENTS + segmentNext;
+            }
+        }
+    }
+
+    //Vertex buffer object if available, client arrays otherwise
+    if((!vertexBufferFailed) && (!vertexBuffer.isCreated())) {
+        if(vertexBuffer.create())
+            vertexBuffer.setUsagePattern(QGLBuffer::DynamicDraw);
+        else {
+            vertexBufferFailed = true;
+            qDebug("[OPENGL] Vertex buffers unavailable, triggers are drawn from client memory");
+        }
+    }
+
+    //Offscreen captures may use another context than the buffer
+    bool useVertexBuffer = (vertexBuffer.isCreated()) && (!Render::forceLists);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    if(useVertexBuffer) {
+        vertexBuffer.bind();
+        if(vertexBuffer.size() < (int)(vertices.count() * sizeof(Vertex)))
+            vertexBuffer.allocate(vertices.constData(), vertices.count() * sizeof(Vertex));
+        else if(dirtyFirst >= 0)
+            vertexBuffer.write(dirtyFirst * TRIGGERBATCH_VERTICES * sizeof(Vertex), vertices.constData() + dirtyFirst * TRIGGERBATCH_VERTICES, (dirtyLast - dirtyFirst + 1) * TRIGGERBATCH_VERTICES * sizeof(Vertex));
+        glVertexPointer(3, GL_FLOAT,         sizeof(Vertex), 0);
+        glColorPointer (4, GL_UNSIGNED_BYTE, sizeof(Vertex), (const GLvoid*)(3 * sizeof(GLfloat)));
+    }
+    else {
+        glVertexPointer(3, GL_FLOAT,         sizeof(Vertex), &vertices.constData()->x);
+        glColorPointer (4, GL_UNSIGNED_BYTE, sizeof(Vertex), &vertices.constData()->r);
+    }
+    if((useVertexBuffer) || (!vertexBuffer.isCreated()))
+        dirtyFirst = dirtyLast = -1;
+
+    glDrawElements(GL_TRIANGLES, count * TRIGGERBATCH_SEGMENTS * 3, GL_UNSIGNED_INT, trianglesIndexes.constData());
+    glLineWidth(OpenGlDrawing::dpi * 1.5);
+    glDrawElements(GL_LINES,     count * TRIGGERBATCH_SEGMENTS * 2, GL_UNSIGNED_INT, linesIndexes.constData());
+    glLineWidth(OpenGlDrawing::dpi);
+
+    if(useVertexBuffer)
+        vertexBuffer.release();
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
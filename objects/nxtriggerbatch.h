@@ -0,0 +1,85 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef NXTRIGGERBATCH_H
+#define NXTRIGGERBATCH_H
+
+#include <QVector>
+#include <QGLBuffer>
+#include <QMatrix4x4>
+#include "nxobject.h"
+
+#define TRIGGERBATCH_SEGMENTS   32
+#define TRIGGERBATCH_VERTICES   (1 + 2 * TRIGGERBATCH_SEGMENTS)
+
+class NxTriggerBatch {
+public:
+    explicit NxTriggerBatch();
+
+private:
+    //Interleaved vertex, uploaded as is
+    struct Vertex {
+        GLfloat x, y, z;
+        GLubyte r, g, b, a;
+    };
+    //State of a trigger when its vertices were written
+    struct Instance {
+        NxPoint pos;
+        qreal   size;
+        QRgb    color;
+    };
+
+private:
+    QVector<Instance> instances;
+    QVector<Vertex>   vertices;
+    quint32 count;
+    qint32  dirtyFirst, dirtyLast;
+    bool    shapeChanged;
+    NxPoint shapeRotation;
+    QVector<QVector3D> shape;
+    QGLBuffer vertexBuffer;
+    bool vertexBufferFailed;
+    static QVector<GLuint> trianglesIndexes, linesIndexes;
+
+private:
+    //Frame state of the last walk over the triggers (skipped while it still holds)
+    bool     walkDone;
+    quint32  walkRevision;
+    quint8   walkFlags;
+    qreal    walkObjectSize;
+    GLdouble walkFrustum[16];
+public:
+    //Triggers drawn one by one after the batch (labels, hover, textures) and culling counters of the last walk
+    QList<NxObject*> unbatched;
+    qreal walkCulled, walkDrawn;
+
+public:
+    bool needsWalk(quint32 revision, const GLdouble *frustumMatrix);
+    void begin();
+    void append(const NxPoint &pos, qreal size, const QColor &color);
+    void paint();
+    inline quint32 getCount() const { return count; }
+};
+
+#endif // NXTRIGGERBATCH_H
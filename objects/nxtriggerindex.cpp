@@ -0,0 +1,110 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <QtAlgorithms>
+#include "nxtriggerindex.h"
+
+static bool triggerIdLessThan(const NxTrigger *trigger1, const NxTrigger *trigger2) {
+    return trigger1->getId() < trigger2->getId();
+}
+
+void NxTriggerIndex::update(NxTrigger *trigger) {
+    //Only active triggers can be hit by a cursor
+    if(!trigger->getActive()) {
+        remove(trigger);
+        return;
+    }
+
+    //Nothing to do if the trigger stays in the same cell
+    quint64 key = getCellKey(getCellCoord(trigger->getPos().x()), getCellCoord(trigger->getPos().y()));
+    QHash<NxTrigger*, quint64>::const_iterator triggerIterator = triggers.constFind(trigger);
+    if((triggerIterator != triggers.constEnd()) && (triggerIterator.value() == key))
+        return;
+
+    remove(trigger);
+    cells[key].append(trigger);
+    triggers.insert(trigger, key);
+}
+void NxTriggerIndex::remove(NxTrigger *trigger) {
+    QHash<NxTrigger*, quint64>::iterator triggerIterator = triggers.find(trigger);
+    if(triggerIterator == triggers.end())
+        return;
+
+    //Swap with the last trigger of the cell
+    QHash<quint64, QVector<NxTrigger*> >::iterator cellIterator = cells.find(triggerIterator.value());
+    if(cellIterator != cells.end()) {
+        QVector<NxTrigger*> &cell = cellIterator.value();
+        qint32 index = cell.indexOf(trigger);
+        if(index >= 0) {
+            cell[index] = cell.last();
+            cell.remove(cell.count()-1);
+        }
+        if(cell.isEmpty())
+            cells.erase(cellIterator);
+    }
+    triggers.erase(triggerIterator);
+}
+
+void NxTriggerIndex::query(const NxRect &_area, QVector<NxTrigger*> *result) const {
+    NxRect area = _area.normalized();
+    if(area.isNull())
+        return;
+
+    qint32 xMin = getCellCoord(area.left()), xMax = getCellCoord(area.right());
+    qint32 yMin = getCellCoord(area.top()),  yMax = getCellCoord(area.bottom());
+
+    //Large areas (fast cursors, zoomed out scores): browsing filled cells is cheaper
+    if(((qint64)(xMax - xMin + 1) * (qint64)(yMax - yMin + 1)) > cells.count()) {
+        QHashIterator<quint64, QVector<NxTrigger*> > cellIterator(cells);
+        while(cellIterator.hasNext()) {
+            cellIterator.next();
+            foreach(NxTrigger *trigger, cellIterator.value())
+                if((trigger->getPos().x() >= area.left()) && (trigger->getPos().x() <= area.right()) && (trigger->getPos().y() >= area.top()) && (trigger->getPos().y() <= area.bottom()))
+                    result->append(trigger);
+        }
+    }
+    else {
+        for(qint32 x = xMin ; x <= xMax ; x++) {
+            for(qint32 y = yMin ; y <= yMax ; y++) {
+                QHash<quint64, QVector<NxTrigger*> >::const_iterator cellIterator = cells.constFind(getCellKey(x, y));
+                if(cellIterator == cells.constEnd())
+                    continue;
+                foreach(NxTrigger *trigger, cellIterator.value())
+                    if((trigger->getPos().x() >= area.left()) && (trigger->getPos().x() <= area.right()) && (trigger->getPos().y() >= area.top()) && (trigger->getPos().y() <= area.bottom()))
+                        result->append(trigger);
+            }
+        }
+    }
+
+    //Same trig order whatever the layout of the grid
+    qSort(result->begin(), result->end(), triggerIdLessThan);
+}
+void NxTriggerIndex::queryAll(QVector<NxTrigger*> *result) const {
+    QHashIterator<NxTrigger*, quint64> triggerIterator(triggers);
+    while(triggerIterator.hasNext()) {
+        triggerIterator.next();
+        result->append(triggerIterator.key());
+    }
+    qSort(result->begin(), result->end(), triggerIdLessThan);
+}
@@ -0,0 +1,64 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef NXTRIGGERINDEX_H
+#define NXTRIGGERINDEX_H
+
+#include <QHash>
+#include <QVector>
+#include "nxtrigger.h"
+
+#define TRIGGERINDEX_CELL_SIZE  1.
+
+class NxTriggerIndex {
+public:
+    explicit NxTriggerIndex() {}
+
+private:
+    //Uniform grid of active triggers, keyed by the cell holding their position
+    QHash<quint64, QVector<NxTrigger*> > cells;
+    QHash<NxTrigger*, quint64> triggers;
+
+private:
+    static inline qint32 getCellCoord(qreal val) {
+        return qFloor(val / TRIGGERINDEX_CELL_SIZE);
+    }
+    static inline quint64 getCellKey(qint32 x, qint32 y) {
+        return (((quint64)(quint32)x) << 32) | (quint32)y;
+    }
+
+public:
+    void update(NxTrigger *trigger);
+    void remove(NxTrigger *trigger);
+    void query(const NxRect &area, QVector<NxTrigger*> *result) const;
+    void queryAll(QVector<NxTrigger*> *result) const;
+    inline bool contains(NxTrigger *trigger) const {
+        return triggers.contains(trigger);
+    }
+    inline quint32 getCount() const {
+        return triggers.count();
+    }
+};
+
+#endif // NXTRIGGERINDEX_H
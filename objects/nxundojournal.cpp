@@ -0,0 +1,211 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "nxundojournal.h"
+#include "nxdocument.h"
+
+NxUndoJournal::NxUndoJournal() {
+    stepsIndex = 0;
+    bytes = 0;
+    recording = false;
+    replaying = false;
+}
+
+void NxUndoJournal::push() {
+    //Redo history is lost on a new edit
+    while(steps.count() > stepsIndex) {
+        foreach(const NxUndoEntry &entry, steps.last())
+            bytes -= entry.cost;
+        steps.removeLast();
+    }
+    //Pushing twice without any change keeps a single step
+    if((steps.isEmpty()) || (!steps.last().isEmpty()))
+        steps.append(QList<NxUndoEntry>());
+    stepsIndex = steps.count();
+    stepEntries.clear();
+    recording = true;
+}
+void NxUndoJournal::stop() {
+    recording = false;
+}
+void NxUndoJournal::clear() {
+    steps.clear();
+    stepEntries.clear();
+    stepsIndex = 0;
+    bytes = 0;
+    recording = false;
+}
+
+void NxUndoJournal::append(const NxUndoEntry &entry) {
+    steps.last().append(entry);
+    bytes += entry.cost;
+
+    //Oldest steps are dropped to keep the journal under its size
+    quint32 bytesMax = Application::undoJournalSize * 1024 * 1024;
+    while((bytes > bytesMax) && (steps.count() > 1)) {
+        foreach(const NxUndoEntry &entryOld, steps.first())
+            bytes -= entryOld.cost;
+        steps.removeFirst();
+        stepsIndex--;
+    }
+    if(bytes > bytesMax) {
+        qDebug("[UNDO] Step larger than the journal (%u bytes), it can't be undone", bytes);
+        clear();
+    }
+}
+
+void NxUndoJournal::record(NxObject *object, const char *_property) {
+    if((!recording) || (replaying) || (!object) || (NxObjectDispatchProperty::source == ExecuteSourceNetwork) || (NxObjectDispatchProperty::source == ExecuteSourceScript))
+        return;
+
+    //Actions and commands without a state to restore
+    QByteArray property = _property;
+    if((property == COMMAND_TRIG) || (property == COMMAND_CURVE_EDITOR) || (property == COMMAND_CURVE_RESAMPLE) || (property == COMMAND_ID))
+        return;
+    if(property == COMMAND_POS_TRANSLATE)
+        property = COMMAND_POS;
+
+    //Commands that rewrite the points of a curve
+    NxUndoEntry entry;
+    entry.type = NxUndoEntryProperty;
+    if(object->getType() == ObjectsTypeCurve) {
+        bool isResize = (property == COMMAND_RESIZE) || (property == COMMAND_RESIZEF);
+        if(((isResize) && (((NxCurve*)object)->getCurveType() == CurveTypePoints)) || ((!isResize) && ((property == COMMAND_CURVE_POINT) || (property == COMMAND_CURVE_POINT_SMOOTH) || (property == COMMAND_CURVE_POINT_RMV) || (property == COMMAND_CURVE_POINT_X) || (property == COMMAND_CURVE_POINT_Y) || (property == COMMAND_CURVE_POINT_Z) || (property == COMMAND_CURVE_POINT_SHIFT) || (property == COMMAND_CURVE_POINT_TRANSLATE) || (property == COMMAND_CURVE_POINT_TRANSLATE2) || (property == COMMAND_CURVE_TXT) || (property == COMMAND_CURVE_PATH) || (property == COMMAND_CURVE_LINES) || (property == COMMAND_CURVE_ELL)))) {
+            entry.type = NxUndoEntryPoints;
+            property = COMMAND_CURVE_POINT;
+        }
+    }
+
+    //Only the first value of a step is kept
+    QPair<quint16, QByteArray> key(object->getId(), property);
+    if(stepEntries.contains(key))
+        return;
+    stepEntries.insert(key, steps.last().count());
+
+    entry.id = object->getId();
+    entry.property = property;
+    if(entry.type == NxUndoEntryPoints) {
+        entry.pointsOld = ((NxCurve*)object)->getPathPoints();
+        entry.cost = sizeof(NxUndoEntry) + entry.pointsOld.count() * sizeof(NxCurvePoint);
+    }
+    else {
+        entry.valueOld = object->getProperty(property);
+        entry.cost = sizeof(NxUndoEntry) + property.size() + getCost(entry.valueOld);
+    }
+    append(entry);
+}
+void NxUndoJournal::recordAdd(NxObject *object) {
+    if((!recording) || (replaying) || (!object) || (NxObjectDispatchProperty::source == ExecuteSourceNetwork) || (NxObjectDispatchProperty::source == ExecuteSourceScript))
+        return;
+    NxUndoEntry entry;
+    entry.type = NxUndoEntryAdd;
+    entry.id = object->getId();
+    entry.cost = sizeof(NxUndoEntry);
+    append(entry);
+}
+void NxUndoJournal::recordRemove(NxObject *object) {
+    if((!recording) || (replaying) || (!object) || (NxObjectDispatchProperty::source == ExecuteSourceNetwork) || (NxObjectDispatchProperty::source == ExecuteSourceScript))
+        return;
+    NxUndoEntry entry;
+    entry.type = NxUndoEntryRemove;
+    entry.id = object->getId();
+    entry.valueOld = getSerialization(object);
+    entry.cost = sizeof(NxUndoEntry) + getCost(entry.valueOld);
+    append(entry);
+}
+
+bool NxUndoJournal::undo(NxDocument *document) {
+    while((stepsIndex > 0) && (steps.at(stepsIndex-1).isEmpty()))
+        stepsIndex--;
+    if(stepsIndex == 0)
+        return false;
+
+    replaying = true;
+    recording = false;
+    NxObjectDispatchProperty::source = ExecuteSourceGui;
+    document->source = NxObjectDispatchProperty::source;
+    QList<NxUndoEntry> &step = steps[stepsIndex-1];
+    for(qint32 entryIndex = step.count()-1 ; entryIndex >= 0 ; entryIndex--) {
+        NxUndoEntry &entry = step[entryIndex];
+        NxObject *object = document->getObject(entry.id);
+        if(entry.type == NxUndoEntryRemove)
+            Application::current->executeAsScript(entry.valueOld.toString());
+        else if(!object)
+            continue;
+        else if(entry.type == NxUndoEntryAdd) {
+            entry.valueNew = getSerialization(object);
+            Application::current->execute(QString("%1 %2").arg(COMMAND_REMOVE).arg(entry.id), ExecuteSourceGui);
+        }
+        else if(entry.type == NxUndoEntryPoints) {
+            entry.pointsNew = ((NxCurve*)object)->getPathPoints();
+            ((NxCurve*)object)->setPathPoints(entry.pointsOld);
+        }
+        else {
+            entry.valueNew = object->getProperty(entry.property);
+            object->dispatchProperty(entry.property, entry.valueOld);
+        }
+    }
+    stepsIndex--;
+    replaying = false;
+    return true;
+}
+bool NxUndoJournal::redo(NxDocument *document) {
+    if(stepsIndex >= steps.count())
+        return false;
+
+    replaying = true;
+    recording = false;
+    NxObjectDispatchProperty::source = ExecuteSourceGui;
+    document->source = NxObjectDispatchProperty::source;
+    foreach(const NxUndoEntry &entry, steps.at(stepsIndex)) {
+        NxObject *object = document->getObject(entry.id);
+        if(entry.type == NxUndoEntryAdd)
+            Application::current->executeAsScript(entry.valueNew.toString());
+        else if(!object)
+            continue;
+        else if(entry.type == NxUndoEntryRemove)
+            Application::current->execute(QString("%1 %2").arg(COMMAND_REMOVE).arg(entry.id), ExecuteSourceGui);
+        else if(entry.type == NxUndoEntryPoints)
+            ((NxCurve*)object)->setPathPoints(entry.pointsNew);
+        else
+            object->dispatchProperty(entry.property, entry.valueNew);
+    }
+    stepsIndex++;
+    replaying = false;
+    return true;
+}
+
+quint32 NxUndoJournal::getCost(const QVariant &value) {
+    if(value.type() == QVariant::String)            return value.toString().size() * sizeof(QChar);
+    else if(value.type() == QVariant::ByteArray)    return value.toByteArray().size();
+    else if(value.canConvert(QVariant::List))       return value.toList().count() * sizeof(QVariant);
+    return sizeof(QVariant);
+}
+const QString NxUndoJournal::getSerialization(const NxObject *object) {
+    ExecuteSource sourceOld = NxObjectDispatchProperty::source;
+    NxObjectDispatchProperty::source = ExecuteSourceCopyPaste;
+    QString serialization = object->serialize();
+    NxObjectDispatchProperty::source = sourceOld;
+    return serialization;
+}
@@ -0,0 +1,77 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef NXUNDOJOURNAL_H
+#define NXUNDOJOURNAL_H
+
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QVariant>
+#include "nxcurve.h"
+
+class NxDocument;
+
+enum NxUndoEntryType { NxUndoEntryProperty, NxUndoEntryPoints, NxUndoEntryAdd, NxUndoEntryRemove };
+
+class NxUndoEntry {
+public:
+    NxUndoEntryType type;
+    quint16 id;
+    QByteArray property;
+    QVariant valueOld, valueNew;
+    QList<NxCurvePoint> pointsOld, pointsNew;
+    quint32 cost;
+};
+
+class NxUndoJournal {
+public:
+    explicit NxUndoJournal();
+
+private:
+    //Each step holds the changes of the GUI edit that pushed it, undone in reverse order
+    QList< QList<NxUndoEntry> > steps;
+    quint16 stepsIndex;
+    QHash<QPair<quint16, QByteArray>, int> stepEntries;
+    quint32 bytes;
+    bool recording, replaying;
+
+private:
+    void append(const NxUndoEntry &entry);
+    static quint32 getCost(const QVariant &value);
+    static const QString getSerialization(const NxObject *object);
+
+public:
+    void push();
+    void stop();
+    void clear();
+    bool undo(NxDocument *document);
+    bool redo(NxDocument *document);
+    void record(NxObject *object, const char *_property);
+    void recordAdd(NxObject *object);
+    void recordRemove(NxObject *object);
+    inline quint32 getBytes() const { return bytes; }
+};
+
+#endif // NXUNDOJOURNAL_H
@@ -23,11 +23,12 @@
 
 #include "uirender.h"
 #include "ui_uirender.h"
+#include "transport/schedulerthread.h"
 
 UiRender::UiRender(QWidget *parent, void *share) :
     Render(parent, share),
     ui(new Ui::UiRender) {
-    capturedFramesStart = false;
+    frameCapture = new UiRenderCapture(this);
 
     setFocusPolicy(Qt::StrongFocus);
 #ifdef USE_OPENGLWIDGET
@@ -54,6 +55,9 @@ UiRender::UiRender(QWidget *parent, void *share) :
 
     //Initialisations
     documentToRender = 0;
+    triggersDocument = 0;
+    triggersObjectSize = 0;
+    triggersRevision = 0;
     setDocument(0);
     setMouseTracking(true);
     isRemoving = false;
@@ -144,31 +148,29 @@ void UiRender::capture(qreal scaleFactor) {
 
         if(videoEncoder.isOk()) {
             timer->stop();
+            frameCapture->stop();
             qDebug("Fermeture de la video : %d", videoEncoder.close());
             timer->start(1000./50.);
         }
         else {
             setInterval(1000./25.);
             qDebug("Creation de la video : %d", videoEncoder.createFile("_test.avi", renderSize.width(), renderSize.height(), 5000000, 20, 25));
+            if(videoEncoder.isOk())
+                frameCapture->start(&videoEncoder);
         }
 #else
-        if(capturedFramesStart) {
-            capturedFramesStart = false;
-            //Sauvegarde
+        //Frames are written while recording, by worker threads
+        if(frameCapture->isRecording()) {
+            frameCapture->stop();
+            MessageManager::logInfo(tr("Capture: %1").arg(frameCapture->report()));
+        }
+        else {
 #ifdef QT4
             QString basePath = QDesktopServices::storageLocation(QDesktopServices::DesktopLocation) + "/IanniX_Capture_" + QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss") + "/";
 #else
             QString basePath = QStandardPaths::standardLocations(QStandardPaths::DesktopLocation).first() + "/IanniX_Capture_" + QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss") + "/";
 #endif
-            QDir().mkpath(basePath);
-            quint16 index = 0;
-            foreach(const QImage &capturedFrame, capturedFrames)
-                capturedFrame.save(basePath + tr("Image_%1.png").arg(index++, 5, 10, QChar('0')));
-            capturedFrames.clear();
-        }
-        else {
-            capturedFrames.clear();
-            capturedFramesStart = true;
+            frameCapture->start(basePath, Application::captureUncompressed);
         }
 #endif
     }
@@ -336,6 +338,36 @@ void UiRender::setFrustum() {
     glMatrixMode(GL_MODELVIEW);
 }
 
+//State changed by the scheduler or by the inertia of curves, read by the drawing only
+void UiRender::paintSnapshot() {
+    bool triggersResize = (triggersObjectSize != Render::objectSize) || (triggersDocument != documentToRender);
+    triggersObjectSize = Render::objectSize;
+    triggersDocument   = documentToRender;
+    if(triggersResize)
+        foreach(NxGroup *group, documentToRender->groups)
+            for(quint16 activityIterator = 0 ; activityIterator < ObjectsActivityLenght ; activityIterator++)
+                foreach(NxObject *object, group->objects[activityIterator][ObjectsTypeTrigger])
+                    object->calcBoundingRect();
+    NxTrigger::paintSnapshot();
+
+    //Triggers only move through commands (they bump the revision), curves and cursors are copied every frame
+    bool triggersMoved = (triggersRevision != Render::triggersRevision);
+    triggersRevision = Render::triggersRevision;
+    foreach(NxGroup *group, documentToRender->groups) {
+        for(quint16 activityIterator = 0 ; activityIterator < ObjectsActivityLenght ; activityIterator++) {
+            foreach(NxObject *object, group->objects[activityIterator][ObjectsTypeCurve]) {
+                ((NxCurve*)object)->animate();
+                object->paintSnapshotBoundingRect();
+            }
+            foreach(NxObject *object, group->objects[activityIterator][ObjectsTypeCursor])
+                ((NxCursor*)object)->paintSnapshot();
+            if(triggersMoved)
+                foreach(NxObject *object, group->objects[activityIterator][ObjectsTypeTrigger])
+                    object->paintSnapshotBoundingRect();
+        }
+    }
+}
+
 //Paint event
 void UiRender::paintGL() {
     if(!isRemoving) {
@@ -374,6 +406,17 @@ void UiRender::paintGL() {
         //Start drawing
         glPushMatrix();
 
+        //Start measure
+        Transport::perfOpenGLRefreshTime += renderMeasure.elapsed() / 1000.0F;
+        Transport::perfOpenGLCounterTime++;
+        renderMeasure.start();
+        QElapsedTimer frameTimer;
+        frameTimer.start();
+
+        //Copy what the scheduler moves (culling and camera follow read the copies)
+        if(documentToRender)
+            paintSnapshot();
+
         //First operations
         if(cameraPerspective)
             glTranslatef(0, 0, -150);
@@ -382,12 +425,15 @@ void UiRender::paintGL() {
             NxCursor *object = (NxCursor*)documentToRender->objects.value(Application::followId);
             //rotationDest.setX(-object->getCurrentAngleRoll());
             //rotationDest.setY(-82 - object->getCurrentAnglePitch());
-            Render::rotationDest.setZ(-object->getCurrentAngle().z() + 90);
+            Render::rotationDest.setZ(-object->getPaintAngle().z() + 90);
             Render::rotation.setZ(Render::rotationDest.z());
-            translationDest = -object->getCurrentPos();
+            translationDest = -object->getPaintPos();
             //scaleDest = 1 * 5;
         }
 
+        //Lend the document to the scheduler while drawing
+        SchedulerThread::guiRelease();
+
         glScalef(scale, scale, scale);
 
         glTranslatef(Render::rotationCenter.x(), Render::rotationCenter.y(), Render::rotationCenter.z());
@@ -404,11 +450,6 @@ void UiRender::paintGL() {
             Application::allowSelection = false;
 
 
-        //Start measure
-        Transport::perfOpenGLRefreshTime += renderMeasure.elapsed() / 1000.0F;
-        Transport::perfOpenGLCounterTime++;
-        renderMeasure.start();
-
         if(documentToRender) {
             //Background
             paintBackground();
@@ -434,6 +475,10 @@ void UiRender::paintGL() {
                 glRotatef(group->rotation.z(), 0, 0, 1);
                 glScalef (group->scale, group->scale, group->scale);
 
+                //Culling with the matrices of this group (camera, group rotation and scale included)
+                if(Render::cullObjects)
+                    frustum.update(renderSize.width(), renderSize.height());
+
                 if(((!Application::current->isGroupSoloActive) && (group->isNotMuted())) || ((Application::current->isGroupSoloActive) && (group->isSolo())))
                     Render::paintThisGroup = true;
                 else
@@ -443,19 +488,65 @@ void UiRender::paintGL() {
                 for(quint16 activityIterator = 0 ; activityIterator < ObjectsActivityLenght ; activityIterator++) {
                     //Browse all types of objects
                     for(quint16 typeIterator = 0 ; typeIterator < ObjectsTypeLength ; typeIterator++) {
+                        //Triggers in one draw call, then the ones that need their own drawing
+                        //(the vertices are only rebuilt when a trigger or the frame state changed)
+                        if((typeIterator == ObjectsTypeTrigger) && (Render::batchTriggers)) {
+                            NxTriggerBatch &triggerBatch = group->triggerBatches[activityIterator];
+                            if(triggerBatch.needsWalk(triggersRevision, frustum.getMatrix())) {
+                                qreal culledCounter = Transport::perfOpenGLCulledCounter, drawnCounter = Transport::perfOpenGLDrawnCounter;
+                                triggerBatch.unbatched.clear();
+                                triggerBatch.begin();
+                                foreach(NxObject *object, group->objects[activityIterator][typeIterator]) {
+                                    if(isCulled(object))
+                                        continue;
+                                    bool oldPaintThisGroup = Render::paintThisGroup;
+                                    if(!(((!Application::current->isObjectSoloActive) && (object->isNotMuted())) || ((Application::current->isObjectSoloActive) && (object->isSolo()))))
+                                        Render::paintThisGroup = false;
+                                    if(!((NxTrigger*)object)->paint(&triggerBatch))
+                                        triggerBatch.unbatched.append(object);
+                                    Render::paintThisGroup = oldPaintThisGroup;
+                                }
+                                triggerBatch.walkCulled = Transport::perfOpenGLCulledCounter - culledCounter;
+                                triggerBatch.walkDrawn  = Transport::perfOpenGLDrawnCounter  - drawnCounter;
+                            }
+                            else {
+                                Transport::perfOpenGLCulledCounter += triggerBatch.walkCulled;
+                                Transport::perfOpenGLDrawnCounter  += triggerBatch.walkDrawn;
+                            }
+                            triggerBatch.paint();
+                            Transport::perfOpenGLBatchedCounter += triggerBatch.getCount();
+                            foreach(NxObject *object, triggerBatch.unbatched) {
+                                bool oldPaintThisGroup = Render::paintThisGroup;
+                                if(!(((!Application::current->isObjectSoloActive) && (object->isNotMuted())) || ((Application::current->isObjectSoloActive) && (object->isSolo()))))
+                                    Render::paintThisGroup = false;
+                                object->paint();
+                                Render::paintThisGroup = oldPaintThisGroup;
+                            }
+                            continue;
+                        }
+
                         //Browse objects
                         foreach(NxObject *object, group->objects[activityIterator][typeIterator]) {
+                            //Skip the objects out of the view
+                            if(typeIterator == ObjectsTypeCurve) {
+                                NxCurve *curve = (NxCurve*)object;
+                                if(isCulled(object))
+                                    continue;
+                                curve->setLod((Render::cullObjects)?(frustum.getPixelSize(curve->getPaintBoundingRect())):(-1));
+                            }
+                            else if(typeIterator == ObjectsTypeCursor) {
+                                const NxPoint &cursorPos = ((NxCursor*)object)->getPaintPos();
+                                if(isCulled(object, ((NxCursor*)object)->getPaintBoundingRect(), qMax(qAbs(cursorPos.sx()), qMax(qAbs(cursorPos.sy()), qAbs(cursorPos.sz())))))
+                                    continue;
+                            }
+                            else if(isCulled(object))
+                                continue;
+
                             //Draw the object
                             bool oldPaintThisGroup = Render::paintThisGroup;
                             if(!(((!Application::current->isObjectSoloActive) && (object->isNotMuted())) || ((Application::current->isObjectSoloActive) && (object->isSolo()))))
                                 Render::paintThisGroup = false;
-                            if(typeIterator == ObjectsTypeTrigger) {
-                                object->paint();
-                                //if(axisArea.contains(object->getPos()))
-                                //    object->paint();
-                            }
-                            else
-                                object->paint();
+                            object->paint();
                             Render::paintThisGroup = oldPaintThisGroup;
                         }
                     }
@@ -468,12 +559,9 @@ void UiRender::paintGL() {
                 Application::current->kinect->paint();
 #endif
         }
+        SchedulerThread::guiAcquire();
         glPopMatrix();
-
-#ifdef FFMPEG_INSTALLED
-        if(videoEncoder.isOk())
-            qDebug("%d encode", videoEncoder.encodeImage(grabFrameBuffer()));
-#endif
+        Transport::perfOpenGLFrameTime += frameTimer.nsecsElapsed() / 1000000.;
 
 #ifdef SYPHON_INSTALLED
         //Export Syphon
@@ -520,6 +608,7 @@ void UiRender::paintGL() {
             makeCurrent();
             interfaceSyphon->createSyphonClient();
             Render::textures->insert("syphon", new UiRenderTexture("syphon", QFileInfo(), NxRect(-4, 4, 8, -8)));
+            Render::triggersRevision++;
         }
         if(interfaceSyphon->clientEnable) {
             Render::textures->value("syphon")->texture = interfaceSyphon->getTexture(&Render::textures->value("syphon")->originalSize);
@@ -618,12 +707,8 @@ void UiRender::paintGL() {
                 qDebug() << "Performance preview widget is null";
             }
         }
-        if(capturedFramesStart)
-#ifdef USE_GLWIDGET
-            capturedFrames << grabFrameBuffer();
-#else
-            capturedFrames << grabFramebuffer();
-#endif
+        if(frameCapture->isRecording())
+            frameCapture->grab(this);
     }
 }
 
@@ -989,49 +1074,52 @@ void UiRender::mouseMoveEvent(QMouseEvent *event) {
         if((documentToRender) && (cursor().shape() != Qt::BlankCursor) && (Application::allowSelection) && (!Application::allowLockPos)) {
             UiRenderSelection eligibleSelection;
 
-            //Browse documents
-            foreach(NxGroup *group, documentToRender->groups) {
-                //Is groups visible ?
-                if((((!Application::current->isGroupSoloActive) && (group->isNotMuted())) || ((Application::current->isGroupSoloActive) && (group->isSolo())))) {
-                    //Browse active/inactive objects
-                    for(quint16 activityIterator = 0 ; activityIterator < ObjectsActivityLenght ; activityIterator++) {
-                        //Browse all types of objects
-                        for(quint16 typeIterator = 0 ; typeIterator < ObjectsTypeLength ; typeIterator++) {
-                            //Are objects visible ?
-                            if(((typeIterator == ObjectsTypeCursor) && (Application::allowSelectionCursors)) || ((typeIterator == ObjectsTypeCurve) && (Application::allowSelectionCurves)) || ((typeIterator == ObjectsTypeTrigger) && (Application::allowSelectionTriggers))) {
-                                //Browse objects
-                                foreach(NxObject *object, group->objects[activityIterator][typeIterator]) {
-                                    //Is Z visible ?
-                                    if(((!Application::current->isObjectSoloActive) && (object->isNotMuted())) || ((Application::current->isObjectSoloActive) && (object->isSolo()))) {
-                                        //Check selection
-                                        if(object->isMouseHover(mousePos)) {
-                                            if(object->getType() == ObjectsTypeCurve)
-                                                eligibleSelection.prepend(object);
-                                            else
-                                                eligibleSelection.append(object);
-                                        }
-
-                                        //Add the object to selection if click+shift
-                                        if((mouseShift) || (mouseControl)) {
-                                            NxRect objectBoundingRect = object->getBoundingRect();
-                                            if(objectBoundingRect.width() == 0)  objectBoundingRect.setWidth(0.001);
-                                            if(objectBoundingRect.height() == 0) objectBoundingRect.setHeight(0.001);
-                                            if(Render::selectionArea.intersects(objectBoundingRect)) {
-                                                selectionRect.append(object);
-                                                object->setSelected(true);
-                                            }
-                                            else {
-                                                selectionRect.removeOne(object);
-                                                if(!selection.contains(object))
-                                                    object->setSelected(false);
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
+            //Candidates : curves and triggers from the picking grid, then cursors (few and always moving) and selected curves (their handles may lie out of the grid boxes)
+            qreal snapSize = Render::objectSize/2;
+            QVector<NxObject*> candidates;
+            documentToRender->pickIndex.query(NxRect(mousePos - NxPoint(snapSize, snapSize), mousePos + NxPoint(snapSize, snapSize)), &candidates);
+            QVector<NxObject*> cursors;
+            if(Application::allowSelectionCursors)
+                foreach(NxGroup *group, documentToRender->groups)
+                    for(quint16 activityIterator = 0 ; activityIterator < ObjectsActivityLenght ; activityIterator++)
+                        foreach(NxObject *object, group->objects[activityIterator][ObjectsTypeCursor])
+                            cursors.append(object);
+            candidates += cursors;
+            foreach(NxObject *object, selection)
+                if((object->getType() == ObjectsTypeCurve) && (!candidates.contains(object)))
+                    candidates.append(object);
+
+            //Check hover
+            foreach(NxObject *object, candidates) {
+                if((isPickable(object)) && (object->isMouseHover(mousePos))) {
+                    if(object->getType() == ObjectsTypeCurve)
+                        eligibleSelection.prepend(object);
+                    else
+                        eligibleSelection.append(object);
+                }
+            }
+
+            //Add the objects to selection if click+shift
+            if((mouseShift) || (mouseControl)) {
+                QVector<NxObject*> candidatesArea;
+                documentToRender->pickIndex.query(Render::selectionArea, &candidatesArea);
+                candidatesArea += cursors;
+                UiRenderSelection selectionRectOld = selectionRect;
+                selectionRect.clear();
+                foreach(NxObject *object, candidatesArea) {
+                    if(!isPickable(object))
+                        continue;
+                    NxRect objectBoundingRect = object->getBoundingRect();
+                    if(objectBoundingRect.width() == 0)  objectBoundingRect.setWidth(0.001);
+                    if(objectBoundingRect.height() == 0) objectBoundingRect.setHeight(0.001);
+                    if(Render::selectionArea.intersects(objectBoundingRect)) {
+                        selectionRect.append(object);
+                        object->setSelected(true);
                     }
                 }
+                foreach(NxObject *object, selectionRectOld)
+                    if((!selectionRect.contains(object)) && (!selection.contains(object)))
+                        object->setSelected(false);
             }
             foreach(NxObject *object, eligibleSelection) {
                 bool selected = false;
@@ -1074,6 +1162,19 @@ void UiRender::mouseMoveEvent(QMouseEvent *event) {
     else
         changeStatus(defaultStatusTip);
 }
+bool UiRender::isPickable(NxObject *object) const {
+    //Is group visible ?
+    NxGroup *group = documentToRender->getGroup(object->getGroupId());
+    if((!group) || !(((!Application::current->isGroupSoloActive) && (group->isNotMuted())) || ((Application::current->isGroupSoloActive) && (group->isSolo()))))
+        return false;
+
+    //Are objects visible ?
+    if(!(((object->getType() == ObjectsTypeCursor) && (Application::allowSelectionCursors)) || ((object->getType() == ObjectsTypeCurve) && (Application::allowSelectionCurves)) || ((object->getType() == ObjectsTypeTrigger) && (Application::allowSelectionTriggers))))
+        return false;
+
+    //Is Z visible ?
+    return ((!Application::current->isObjectSoloActive) && (object->isNotMuted())) || ((Application::current->isObjectSoloActive) && (object->isSolo()));
+}
 void UiRender::changeStatus(const QString &_statusTip) {
     if(_statusTip != statusTip()) {
         setStatusTip(_statusTip);
@@ -29,6 +29,7 @@
 #include <QFile>
 #include <QMimeData>
 #include <QTime>
+#include <QElapsedTimer>
 #include <QWheelEvent>
 #include <QGesture>
 #include <QtCore/qmath.h>
@@ -40,6 +41,8 @@
 #include "abstractionsgl.h"
 
 #include "render/uirenderpreview.h"
+#include "render/uirendercapture.h"
+#include "render/uirenderfrustum.h"
 #ifdef FFMPEG_INSTALLED
 #include "interfaces/qffmpeg/QVideoEncoder.h"
 #endif
@@ -84,8 +87,12 @@ private:
     UiRenderSelection selection;
     NxPoint translation, translationDest, rotationDrag, translationDrag;
     qreal scale, scaleDest;
-    QList<QImage> capturedFrames;
-    bool capturedFramesStart;
+    UiRenderCapture *frameCapture;
+    UiRenderFrustum frustum;
+    qreal triggersObjectSize;
+    NxDocument *triggersDocument;
+    quint32 triggersRevision;
+    void paintSnapshot();
 public:
     QString legend;
     QColor legendColor;
@@ -104,6 +111,19 @@ public:
     inline bool isSelection() const {
         return (selection.count() > 0);
     }
+    bool isPickable(NxObject *object) const;
+    inline bool isCulled(NxObject *object, qreal margin = 0) {
+        return isCulled(object, object->getPaintBoundingRect(), margin);
+    }
+    inline bool isCulled(NxObject *object, const NxRect &boundingRect, qreal margin) {
+        //Selected and hovered objects draw their handles and mapping areas out of their bounding boxes
+        if((Render::cullObjects) && (!object->getSelected()) && (!object->getSelectedHover()) && (!frustum.isVisible(boundingRect, Render::objectSize + margin))) {
+            Transport::perfOpenGLCulledCounter++;
+            return true;
+        }
+        Transport::perfOpenGLDrawnCounter++;
+        return false;
+    }
 
     inline qreal getAutoScale(qreal factor) {
         return 0.15 * ((1. - factor) + (Render::zoomLinear/1.3) * factor);
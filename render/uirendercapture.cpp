@@ -0,0 +1,197 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "uirendercapture.h"
+#ifdef FFMPEG_INSTALLED
+#include "interfaces/qffmpeg/QVideoEncoder.h"
+#endif
+
+void UiRenderCaptureJob::run() {
+    //Pixel buffers are read bottom-up
+    const QImage &image = (flip)?(frame.mirrored()):(frame);
+    bool ok = false;
+#ifdef FFMPEG_INSTALLED
+    if(videoEncoder)
+        ok = (videoEncoder->encodeImage(image) >= 0);
+    else
+#endif
+        ok = image.save(filename);
+    if(ok)
+        written->fetchAndAddOrdered(1);
+    queued->fetchAndAddOrdered(-1);
+}
+
+
+UiRenderCapture::UiRenderCapture(QObject *parent) :
+    QObject(parent) {
+    //Image files are written in parallel, video frames in order
+    writerPool .setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+    encoderPool.setMaxThreadCount(1);
+    queued .fetchAndStoreOrdered(0);
+    written.fetchAndStoreOrdered(0);
+    frameIndex = dropped = 0;
+    recording = false;
+#ifdef FFMPEG_INSTALLED
+    videoEncoder = 0;
+#endif
+    for(quint8 bufferIndex = 0 ; bufferIndex < CAPTURE_PIXEL_BUFFERS ; bufferIndex++)
+        pixelBuffers[bufferIndex] = QGLBuffer(QGLBuffer::PixelPackBuffer);
+    pixelBufferIndex = 0;
+    pixelBuffersFailed = false;
+}
+UiRenderCapture::~UiRenderCapture() {
+    stop();
+}
+
+bool UiRenderCapture::start(const QString &_basePath, bool uncompressed) {
+    stop();
+    basePath  = _basePath;
+    extension = (uncompressed)?("bmp"):("png");
+    if(!QDir().mkpath(basePath)) {
+        qDebug("[CAPTURE] Can't create %s", qPrintable(basePath));
+        return false;
+    }
+#ifdef FFMPEG_INSTALLED
+    videoEncoder = 0;
+#endif
+    queued .fetchAndStoreOrdered(0);
+    written.fetchAndStoreOrdered(0);
+    frameIndex = dropped = 0;
+    for(quint8 bufferIndex = 0 ; bufferIndex < CAPTURE_PIXEL_BUFFERS ; bufferIndex++)
+        pixelBufferSizes[bufferIndex] = QSize();
+    recording = true;
+    return true;
+}
+#ifdef FFMPEG_INSTALLED
+bool UiRenderCapture::start(QVideoEncoder *_videoEncoder) {
+    stop();
+    queued .fetchAndStoreOrdered(0);
+    written.fetchAndStoreOrdered(0);
+    frameIndex = dropped = 0;
+    for(quint8 bufferIndex = 0 ; bufferIndex < CAPTURE_PIXEL_BUFFERS ; bufferIndex++)
+        pixelBufferSizes[bufferIndex] = QSize();
+    videoEncoder = _videoEncoder;
+    recording = true;
+    return true;
+}
+#endif
+void UiRenderCapture::stop() {
+    if(!recording)
+        return;
+    recording = false;
+
+    //Frames still in pixel buffers are lost (reading them needs the OpenGL context)
+    writerPool .waitForDone();
+    encoderPool.waitForDone();
+    qDebug("[CAPTURE] %s", qPrintable(report()));
+#ifdef FFMPEG_INSTALLED
+    videoEncoder = 0;
+#endif
+}
+
+//Called at the end of a paint, with the OpenGL context current
+void UiRenderCapture::grab(Render *render) {
+    if(!recording)
+        return;
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    if(grabAsync(QSize(viewport[2], viewport[3])))
+        return;
+
+    //Synchronous readback
+#ifdef USE_GLWIDGET
+    enqueue(render->grabFrameBuffer(), false);
+#else
+    enqueue(render->grabFramebuffer(), false);
+#endif
+}
+bool UiRenderCapture::grabAsync(const QSize &size) {
+    if(pixelBuffersFailed)
+        return false;
+
+    QGLBuffer &pixelBuffer = pixelBuffers[pixelBufferIndex];
+    if(!pixelBuffer.isCreated()) {
+        if(!pixelBuffer.create()) {
+            pixelBuffersFailed = true;
+            qDebug("[CAPTURE] Pixel buffers unavailable, frames are read synchronously");
+            return false;
+        }
+        pixelBuffer.setUsagePattern(QGLBuffer::StreamRead);
+    }
+
+    //The frame read in this buffer a few paints ago is ready : copy it before reusing the buffer
+    pixelBuffer.bind();
+    const QSize &pendingSize = pixelBufferSizes[pixelBufferIndex];
+    if(pendingSize.isValid()) {
+        const uchar *pixels = (const uchar*)pixelBuffer.map(QGLBuffer::ReadOnly);
+        if(!pixels) {
+            pixelBuffer.release();
+            pixelBuffersFailed = true;
+            qDebug("[CAPTURE] Pixel buffers can't be mapped, frames are read synchronously");
+            return false;
+        }
+        QImage frame(pendingSize, QImage::Format_RGB32);
+        memcpy(frame.bits(), pixels, pendingSize.width() * pendingSize.height() * 4);
+        pixelBuffer.unmap();
+        enqueue(frame, true);
+    }
+
+    //Start reading the current frame (returns immediately, the copy happens on the graphic card)
+    qint32 bufferSize = size.width() * size.height() * 4;
+    if(pixelBuffer.size() != bufferSize)
+        pixelBuffer.allocate(bufferSize);
+    glReadPixels(0, 0, size.width(), size.height(), GL_BGRA, GL_UNSIGNED_BYTE, 0);
+    pixelBuffer.release();
+    pixelBufferSizes[pixelBufferIndex] = size;
+    pixelBufferIndex = (pixelBufferIndex + 1) % CAPTURE_PIXEL_BUFFERS;
+    return true;
+}
+
+void UiRenderCapture::enqueue(const QImage &frame, bool flip) {
+    //Writers too slow : the frame is dropped rather than kept in memory
+    if(queued.fetchAndAddOrdered(0) >= CAPTURE_QUEUE_MAX) {
+        dropped++;
+        return;
+    }
+    queued.fetchAndAddOrdered(1);
+
+    UiRenderCaptureJob *job = new UiRenderCaptureJob();
+    job->frame    = frame;
+    job->flip     = flip;
+    job->filename = basePath + QString("Image_%1.%2").arg(frameIndex++, 5, 10, QChar('0')).arg(extension);
+    job->queued   = &queued;
+    job->written  = &written;
+#ifdef FFMPEG_INSTALLED
+    job->videoEncoder = videoEncoder;
+    if(videoEncoder) {
+        encoderPool.start(job);
+        return;
+    }
+#endif
+    writerPool.start(job);
+}
+
+const QString UiRenderCapture::report() {
+    return tr("%1 frames captured, %2 written, %3 dropped, %4 waiting").arg(frameIndex).arg(written.fetchAndAddOrdered(0)).arg(dropped).arg(queued.fetchAndAddOrdered(0));
+}
@@ -0,0 +1,101 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#ifndef UIRENDERCAPTURE_H
+#define UIRENDERCAPTURE_H
+
+#include <QObject>
+#include <QImage>
+#include <QThread>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QGLBuffer>
+#include <QDir>
+#include "misc/application.h"
+
+#define CAPTURE_QUEUE_MAX       16      //Frames waiting for a writer before new ones are dropped
+#define CAPTURE_PIXEL_BUFFERS   2       //Readbacks in flight (a frame is read one paint later)
+
+#ifndef GL_BGRA
+#define GL_BGRA 0x80E1
+#endif
+
+#ifdef FFMPEG_INSTALLED
+class QVideoEncoder;
+#endif
+
+//Writes a frame (image file or video encoder) on a worker thread
+class UiRenderCaptureJob : public QRunnable {
+public:
+    QImage frame;
+    QString filename;
+    bool flip;
+    QAtomicInt *queued, *written;
+#ifdef FFMPEG_INSTALLED
+    QVideoEncoder *videoEncoder;
+#endif
+public:
+    void run();
+};
+
+//Streams frames from the render to disk while recording, with a bounded number of frames in memory
+class UiRenderCapture : public QObject {
+    Q_OBJECT
+
+public:
+    explicit UiRenderCapture(QObject *parent = 0);
+    ~UiRenderCapture();
+
+private:
+    QString basePath, extension;
+    QThreadPool writerPool, encoderPool;
+    QAtomicInt queued, written;
+    quint32 frameIndex, dropped;
+    bool recording;
+#ifdef FFMPEG_INSTALLED
+    QVideoEncoder *videoEncoder;
+#endif
+    //Asynchronous readback in pixel buffers
+    QGLBuffer pixelBuffers[CAPTURE_PIXEL_BUFFERS];
+    QSize pixelBufferSizes[CAPTURE_PIXEL_BUFFERS];
+    quint8 pixelBufferIndex;
+    bool pixelBuffersFailed;
+
+public:
+    bool start(const QString &_basePath, bool uncompressed);
+#ifdef FFMPEG_INSTALLED
+    bool start(QVideoEncoder *_videoEncoder);
+#endif
+    void stop();
+    inline bool isRecording() const { return recording; }
+    void grab(Render *render);
+    const QString report();
+private:
+    bool grabAsync(const QSize &size);
+    void enqueue(const QImage &frame, bool flip);
+};
+
+#endif // UIRENDERCAPTURE_H
@@ -0,0 +1,88 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "uirenderfrustum.h"
+
+UiRenderFrustum::UiRenderFrustum() {
+    for(quint8 index = 0 ; index < 16 ; index++)
+        matrix[index] = (index % 5 == 0)?(1):(0);
+    viewportWidth = viewportHeight = 1;
+}
+
+void UiRenderFrustum::update(qreal _viewportWidth, qreal _viewportHeight) {
+    //Matrices as set by the camera and the group transforms, read once per group
+    GLdouble modelview[16], projection[16];
+    glGetDoublev(GL_MODELVIEW_MATRIX,  modelview);
+    glGetDoublev(GL_PROJECTION_MATRIX, projection);
+    for(quint8 column = 0 ; column < 4 ; column++)
+        for(quint8 row = 0 ; row < 4 ; row++)
+            matrix[column*4 + row] = projection[row] * modelview[column*4] + projection[4 + row] * modelview[column*4 + 1] + projection[8 + row] * modelview[column*4 + 2] + projection[12 + row] * modelview[column*4 + 3];
+    viewportWidth  = _viewportWidth;
+    viewportHeight = _viewportHeight;
+}
+
+bool UiRenderFrustum::isVisible(const NxRect &_rect, qreal margin) const {
+    //A box is out of the view if its 8 corners are beyond the same clipping plane
+    NxRect rect = _rect.normalized();
+    qreal xs[2] = { rect.left() - margin,  rect.right()   + margin };
+    qreal ys[2] = { rect.top() - margin,   rect.bottom()  + margin };
+    qreal zs[2] = { rect.zTop() - margin,  rect.zBottom() + margin };
+    quint8 outside = 0x3F;
+    GLdouble clip[4];
+    for(quint8 corner = 0 ; corner < 8 ; corner++) {
+        project(xs[corner & 1], ys[(corner >> 1) & 1], zs[(corner >> 2) & 1], clip);
+        quint8 planes = 0;
+        if(clip[0] < -clip[3])  planes |= 0x01;
+        if(clip[0] >  clip[3])  planes |= 0x02;
+        if(clip[1] < -clip[3])  planes |= 0x04;
+        if(clip[1] >  clip[3])  planes |= 0x08;
+        if(clip[2] < -clip[3])  planes |= 0x10;
+        if(clip[2] >  clip[3])  planes |= 0x20;
+        outside &= planes;
+        if(!outside)
+            return true;
+    }
+    return false;
+}
+
+qreal UiRenderFrustum::getPixelSize(const NxRect &_rect) const {
+    //Largest on-screen side of the box, or -1 if it crosses the camera plane
+    NxRect rect = _rect.normalized();
+    qreal xs[2] = { rect.left(),  rect.right()   };
+    qreal ys[2] = { rect.top(),   rect.bottom()  };
+    qreal zs[2] = { rect.zTop(),  rect.zBottom() };
+    qreal xMin = 0, xMax = 0, yMin = 0, yMax = 0;
+    GLdouble clip[4];
+    for(quint8 corner = 0 ; corner < 8 ; corner++) {
+        project(xs[corner & 1], ys[(corner >> 1) & 1], zs[(corner >> 2) & 1], clip);
+        if(clip[3] <= 0)
+            return -1;
+        qreal x = clip[0] / clip[3] * viewportWidth / 2, y = clip[1] / clip[3] * viewportHeight / 2;
+        if((corner == 0) || (x < xMin))  xMin = x;
+        if((corner == 0) || (x > xMax))  xMax = x;
+        if((corner == 0) || (y < yMin))  yMin = y;
+        if((corner == 0) || (y > yMax))  yMax = y;
+    }
+    return qMax(xMax - xMin, yMax - yMin);
+}
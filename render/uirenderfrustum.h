@@ -0,0 +1,55 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+
+#ifndef UIRENDERFRUSTUM_H
+#define UIRENDERFRUSTUM_H
+
+#include "geometry/nxrect.h"
+#include "abstractionsgl.h"
+
+class UiRenderFrustum {
+public:
+    explicit UiRenderFrustum();
+
+private:
+    //Projection x modelview of the current group (column-major, as OpenGL)
+    GLdouble matrix[16];
+    qreal viewportWidth, viewportHeight;
+
+private:
+    inline void project(qreal x, qreal y, qreal z, GLdouble *clip) const {
+        for(quint8 row = 0 ; row < 4 ; row++)
+            clip[row] = matrix[row] * x + matrix[4 + row] * y + matrix[8 + row] * z + matrix[12 + row];
+    }
+
+public:
+    void update(qreal _viewportWidth, qreal _viewportHeight);
+    bool isVisible(const NxRect &rect, qreal margin) const;
+    qreal getPixelSize(const NxRect &rect) const;
+    inline const GLdouble *getMatrix() const { return matrix; }
+};
+
+#endif // UIRENDERFRUSTUM_H
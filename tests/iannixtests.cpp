@@ -0,0 +1,54 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "iannixtests.h"
+#include "testcurves.h"
+#include "testscorebinary.h"
+#include "testmessageparser.h"
+#include "testbenchmarks.h"
+
+//Runs every test class on an offline IanniX (IanniX -test), returns the number of failed classes
+int IanniXTests::run(IanniX *iannix) {
+    QStringList arguments = QStringList() << QCoreApplication::applicationFilePath();
+    int failures = 0;
+
+    TestCurves testCurves(iannix);
+    if(QTest::qExec(&testCurves, arguments))
+        failures++;
+    TestScoreBinary testScoreBinary(iannix);
+    if(QTest::qExec(&testScoreBinary, arguments))
+        failures++;
+    TestMessageParser testMessageParser(iannix);
+    if(QTest::qExec(&testMessageParser, arguments))
+        failures++;
+
+    qDebug("[TESTS] %d test classes failed", failures);
+    return failures;
+}
+
+//Runs the benchmarks on an offline IanniX (IanniX -benchmark), numbers are printed as [BENCHMARK] lines
+int IanniXTests::benchmark(IanniX *iannix) {
+    QStringList arguments = QStringList() << QCoreApplication::applicationFilePath();
+    TestBenchmarks testBenchmarks(iannix);
+    return QTest::qExec(&testBenchmarks, arguments);
+}
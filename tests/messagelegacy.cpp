@@ -0,0 +1,529 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "messages/message.h"
+#include "objects/nxtrigger.h"
+#include "objects/nxcursor.h"
+#include "objects/nxcurve.h"
+#include "misc/help.h"
+
+#ifdef IANNIX_TESTS
+
+//String-matching parser as it was before the arguments were compiled into opcodes.
+//It is only built with the tests (qmake CONFIG+=iannix_tests), as the reference of
+//TestMessageParser : each message is parsed a second time here and compared byte for byte.
+
+bool Message::parseLegacy(const QVector<QByteArray> & patternItems, const MessageManagerDestination &destination) {
+    QScriptValue messageScriptGlobal = (messageScriptEngine)?(messageScriptEngine->globalObject()):(QScriptValue());
+    bool suppressSend = false;
+    midiValues   .clear();
+    asciiMessage .clear();
+    verboseValues.clear();
+    verboseValues.reserve(patternItems.count());
+    buffer       .clear();
+    hasAdd = false;
+
+    if(patternItems.count() >= 2) {
+        //Messages
+        for(quint16 patternIndex = 1 ; patternIndex < patternItems.count() ; patternIndex++) {
+            QByteArray patternArgument = patternItems.at(patternIndex);
+            bool found = false;
+
+            if((patternArgument.at(0) == '{') && (messageScriptEngine)) {
+                patternArgument = patternArgument.trimmed().remove(0, 1);
+                patternArgument.chop(1);
+
+                if(((NxTrigger*)destination.trigger)) {
+                    if(patternArgument.contains("trigger_id"))
+                        messageScriptGlobal.setProperty("trigger_id", ((NxTrigger*)destination.trigger)->getId());
+                    if(patternArgument.contains("trigger_group_id"))
+                        messageScriptGlobal.setProperty("trigger_group_id", ((NxTrigger*)destination.trigger)->getGroupId());
+                    if(patternArgument.contains("trigger_label"))
+                        messageScriptGlobal.setProperty("trigger_label", ((NxTrigger*)destination.trigger)->getLabel());
+                    if(patternArgument.contains("trigger_xPos"))
+                        messageScriptGlobal.setProperty("trigger_xPos", ((NxTrigger*)destination.trigger)->getPos().x());
+                    if(patternArgument.contains("trigger_yPos"))
+                        messageScriptGlobal.setProperty("trigger_yPos", ((NxTrigger*)destination.trigger)->getPos().y());
+                    if(patternArgument.contains("trigger_zPos"))
+                        messageScriptGlobal.setProperty("trigger_zPos", ((NxTrigger*)destination.trigger)->getPos().z());
+                    if((patternArgument.contains("trigger_value_x")) && (((NxCursor*)destination.cursor)))
+                        messageScriptGlobal.setProperty("trigger_value_x", ((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).x());
+                    if((patternArgument.contains("trigger_value_y")) && (((NxCursor*)destination.cursor)))
+                        messageScriptGlobal.setProperty("trigger_value_y", ((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).y());
+                    if((patternArgument.contains("trigger_value_z")) && (((NxCursor*)destination.cursor)))
+                        messageScriptGlobal.setProperty("trigger_value_z", ((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).z());
+                    if(patternArgument.contains("trigger_value"))
+                        messageScriptGlobal.setProperty("trigger_value", ((NxTrigger*)destination.trigger)->getTrigged());
+                    if(patternArgument.contains("trigger_duration"))
+                        messageScriptGlobal.setProperty("trigger_duration", ((NxTrigger*)destination.trigger)->getTriggerOff());
+                    if((patternArgument.contains("trigger_distance")) && (((NxCursor*)destination.cursor))) {
+                        NxPoint cursorPosDelta = ((NxTrigger*)destination.trigger)->getPos() - ((NxCursor*)destination.cursor)->getCurrentPos();
+                        messageScriptGlobal.setProperty("trigger_distance", qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()));
+                    }
+                    if((patternArgument.contains("trigger_side")) && (((NxCursor*)destination.cursor))) {
+                        qreal cursorAngle = fmod(((NxCursor*)destination.cursor)->getCurrentAngle().z(), 360);
+                        float side = 0;
+                        if(cursorAngle == 90) //cursor going straight up
+                            side = (((NxTrigger*)destination.trigger)->getPos().x() > ((NxCursor*)destination.cursor)->getCurrentPos().x()) ? 1:0;
+                        else if (cursorAngle == 270) //cursor going straight down
+                            side = (((NxTrigger*)destination.trigger)->getPos().x() > ((NxCursor*)destination.cursor)->getCurrentPos().x()) ? 0:1;
+                        else if(((0<cursorAngle) && (cursorAngle<90)) || ((270<cursorAngle) && (cursorAngle<360)) ) //cursor going to left
+                            side = (((NxTrigger*)destination.trigger)->getPos().y() > ((NxCursor*)destination.cursor)->getCurrentPos().y()) ? 1:0;
+                        else //cursor going to right
+                            side = (((NxTrigger*)destination.trigger)->getPos().y() > ((NxCursor*)destination.cursor)->getCurrentPos().y()) ? 0:1;
+                        messageScriptGlobal.setProperty("trigger_side", side);
+                    }
+                    if(patternArgument.contains("trigger_message_id"))
+                        messageScriptGlobal.setProperty("trigger_message_id", (quint32)((NxTrigger*)destination.trigger)->getMessageId());
+                }
+                if(((NxCursor*)destination.cursor)) {
+                    if(patternArgument.contains("cursor_id"))
+                        messageScriptGlobal.setProperty("cursor_id", ((NxCursor*)destination.cursor)->getId());
+                    if(patternArgument.contains("cursor_group_id"))
+                        messageScriptGlobal.setProperty("cursor_group_id", ((NxCursor*)destination.cursor)->getGroupId());
+                    if(patternArgument.contains("cursor_label"))
+                        messageScriptGlobal.setProperty("cursor_label", ((NxCursor*)destination.cursor)->getLabel());
+
+                    if(patternArgument.contains("cursor_xPos"))
+                        messageScriptGlobal.setProperty("cursor_xPos", ((NxCursor*)destination.cursor)->getCurrentPos().x());
+                    if(patternArgument.contains("cursor_yPos"))
+                        messageScriptGlobal.setProperty("cursor_yPos", ((NxCursor*)destination.cursor)->getCurrentPos().y());
+                    if(patternArgument.contains("cursor_zPos"))
+                        messageScriptGlobal.setProperty("cursor_zPos", ((NxCursor*)destination.cursor)->getCurrentPos().z());
+                    if(patternArgument.contains("cursor_value_x"))
+                        messageScriptGlobal.setProperty("cursor_value_x", ((NxCursor*)destination.cursor)->getCurrentValue().x());
+                    if(patternArgument.contains("cursor_value_y"))
+                        messageScriptGlobal.setProperty("cursor_value_y", ((NxCursor*)destination.cursor)->getCurrentValue().y());
+                    if(patternArgument.contains("cursor_value_z"))
+                        messageScriptGlobal.setProperty("cursor_value_z", ((NxCursor*)destination.cursor)->getCurrentValue().z());
+
+                    if(patternArgument.contains("cursor_aPos"))
+                        messageScriptGlobal.setProperty("cursor_aPos", ((NxCursor*)destination.cursor)->getCurrentAed().x());
+                    if(patternArgument.contains("cursor_ePos"))
+                        messageScriptGlobal.setProperty("cursor_ePos", ((NxCursor*)destination.cursor)->getCurrentAed().y());
+                    if(patternArgument.contains("cursor_dPos"))
+                        messageScriptGlobal.setProperty("cursor_dPos", ((NxCursor*)destination.cursor)->getCurrentAed().z());
+                    if(patternArgument.contains("cursor_value_a"))
+                        messageScriptGlobal.setProperty("cursor_value_a", ((NxCursor*)destination.cursor)->getCurrentValueAed().x());
+                    if(patternArgument.contains("cursor_value_e"))
+                        messageScriptGlobal.setProperty("cursor_value_e", ((NxCursor*)destination.cursor)->getCurrentValueAed().y());
+                    if(patternArgument.contains("cursor_value_d"))
+                        messageScriptGlobal.setProperty("cursor_value_d", ((NxCursor*)destination.cursor)->getCurrentValueAed().z());
+
+                    if(patternArgument.contains("cursor_sxPos"))
+                        messageScriptGlobal.setProperty("cursor_sxPos", ((NxCursor*)destination.cursor)->getCurrentPos().sx());
+                    if(patternArgument.contains("cursor_syPos"))
+                        messageScriptGlobal.setProperty("cursor_syPos", ((NxCursor*)destination.cursor)->getCurrentPos().sy());
+                    if(patternArgument.contains("cursor_szPos"))
+                        messageScriptGlobal.setProperty("cursor_szPos", ((NxCursor*)destination.cursor)->getCurrentPos().sz());
+                    if(patternArgument.contains("cursor_value_sx"))
+                        messageScriptGlobal.setProperty("cursor_value_sx", ((NxCursor*)destination.cursor)->getCurrentValue().sx());
+                    if(patternArgument.contains("cursor_value_sy"))
+                        messageScriptGlobal.setProperty("cursor_value_sy", ((NxCursor*)destination.cursor)->getCurrentValue().sy());
+                    if(patternArgument.contains("cursor_value_sz"))
+                        messageScriptGlobal.setProperty("cursor_value_sz", ((NxCursor*)destination.cursor)->getCurrentValue().sz());
+                    if(patternArgument.contains("cursor_time"))
+                        messageScriptGlobal.setProperty("cursor_time", ((NxCursor*)destination.cursor)->getTimeLocal());
+                    if(patternArgument.contains("cursor_time_percent"))
+                        messageScriptGlobal.setProperty("cursor_time_percent", ((NxCursor*)destination.cursor)->getTimeLocalPercent());
+                    if(patternArgument.contains("cursor_angle"))
+                        messageScriptGlobal.setProperty("cursor_angle", fmod(((NxCursor*)destination.cursor)->getCurrentAngle().z(), 360));
+
+                    if(patternArgument.contains("cursor_xPos_delta"))
+                        messageScriptGlobal.setProperty("cursor_xPos_delta",     ((NxCursor*)destination.cursor)->getCurrentPos().x()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().x());
+                    if(patternArgument.contains("cursor_yPos_delta"))
+                        messageScriptGlobal.setProperty("cursor_yPos_delta",     ((NxCursor*)destination.cursor)->getCurrentPos().y()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().y());
+                    if(patternArgument.contains("cursor_zPos_delta"))
+                        messageScriptGlobal.setProperty("cursor_zPos_delta",     ((NxCursor*)destination.cursor)->getCurrentPos().z()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().z());
+                    if(patternArgument.contains("cursor_value_x_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_x_delta",  ((NxCursor*)destination.cursor)->getCurrentValue().x()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().x());
+                    if(patternArgument.contains("cursor_value_y_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_y_delta",  ((NxCursor*)destination.cursor)->getCurrentValue().y()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().y());
+                    if(patternArgument.contains("cursor_value_z_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_z_delta",  ((NxCursor*)destination.cursor)->getCurrentValue().z()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().z());
+
+                    if(patternArgument.contains("cursor_aPos_delta"))
+                        messageScriptGlobal.setProperty("cursor_aPos_delta",     ((NxCursor*)destination.cursor)->getCurrentAed().x()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().x());
+                    if(patternArgument.contains("cursor_ePos_delta"))
+                        messageScriptGlobal.setProperty("cursor_ePos_delta",     ((NxCursor*)destination.cursor)->getCurrentAed().y()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().y());
+                    if(patternArgument.contains("cursor_dPos_delta"))
+                        messageScriptGlobal.setProperty("cursor_dPos_delta",     ((NxCursor*)destination.cursor)->getCurrentAed().z()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().z());
+                    if(patternArgument.contains("cursor_value_a_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_a_delta",  ((NxCursor*)destination.cursor)->getCurrentValueAed().x()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().x());
+                    if(patternArgument.contains("cursor_value_e_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_e_delta",  ((NxCursor*)destination.cursor)->getCurrentValueAed().y()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().y());
+                    if(patternArgument.contains("cursor_value_d_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_d_delta",  ((NxCursor*)destination.cursor)->getCurrentValueAed().z()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().z());
+
+                    if(patternArgument.contains("cursor_sxPos_delta"))
+                        messageScriptGlobal.setProperty("cursor_sxPos_delta",    ((NxCursor*)destination.cursor)->getCurrentPos().sx()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sx());
+                    if(patternArgument.contains("cursor_syPos_delta"))
+                        messageScriptGlobal.setProperty("cursor_syPos_delta",    ((NxCursor*)destination.cursor)->getCurrentPos().sy()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sy());
+                    if(patternArgument.contains("cursor_szPos_delta"))
+                        messageScriptGlobal.setProperty("cursor_szPos_delta",    ((NxCursor*)destination.cursor)->getCurrentPos().sz()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sz());
+                    if(patternArgument.contains("cursor_value_sx_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_sx_delta", ((NxCursor*)destination.cursor)->getCurrentValue().sx() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sx());
+                    if(patternArgument.contains("cursor_value_sy_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_sy_delta", ((NxCursor*)destination.cursor)->getCurrentValue().sy() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sy());
+                    if(patternArgument.contains("cursor_value_sz_delta"))
+                        messageScriptGlobal.setProperty("cursor_value_sz_delta", ((NxCursor*)destination.cursor)->getCurrentValue().sz() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sz());
+                    if(patternArgument.contains("cursor_time_delta"))
+                        messageScriptGlobal.setProperty("cursor_time_delta",         ((NxCursor*)destination.cursor)->getTimeLocal()        - ((NxCursor*)destination.cursor)->getTimeLocalLastSend());
+                    if(patternArgument.contains("cursor_time_percent_delta"))
+                        messageScriptGlobal.setProperty("cursor_time_percent_delta", ((NxCursor*)destination.cursor)->getTimeLocalPercent() - ((NxCursor*)destination.cursor)->getTimeLocalPercentLastSend());
+                    if(patternArgument.contains("cursor_angle_delta"))
+                        messageScriptGlobal.setProperty("cursor_angle_delta",        ((NxCursor*)destination.cursor)->getCurrentAngle().z() - ((NxCursor*)destination.cursor)->getCurrentAngleLastSend().z());
+
+                    if(patternArgument.contains("cursor_nb_loop"))
+                        messageScriptGlobal.setProperty("cursor_nb_loop", ((NxCursor*)destination.cursor)->getNbLoop());
+                    if(patternArgument.contains("cursor_message_id"))
+                        messageScriptGlobal.setProperty("cursor_message_id", (quint32)((NxCursor*)destination.cursor)->getMessageId());
+                }
+                if(((NxCurve*)destination.curve)) {
+                    if(patternArgument.contains("curve_id"))
+                        messageScriptGlobal.setProperty("curve_id", ((NxCurve*)destination.curve)->getId());
+                    if(patternArgument.contains("curve_group_id"))
+                        messageScriptGlobal.setProperty("curve_group_id", ((NxCurve*)destination.curve)->getGroupId());
+                    if(patternArgument.contains("curve_label"))
+                        messageScriptGlobal.setProperty("curve_label", ((NxCurve*)destination.curve)->getLabel());
+                    if(patternArgument.contains("curve_xPos"))
+                        messageScriptGlobal.setProperty("curve_xPos", ((NxCurve*)destination.curve)->getPos().x());
+                    if(patternArgument.contains("curve_yPos"))
+                        messageScriptGlobal.setProperty("curve_yPos", ((NxCurve*)destination.curve)->getPos().y());
+                    if(patternArgument.contains("curve_zPos"))
+                        messageScriptGlobal.setProperty("curve_zPos", ((NxCurve*)destination.curve)->getPos().z());
+                }
+                if(((NxCurve*)destination.collisionCurve)) {
+                    if(patternArgument.contains("collision_curve_id"))
+                        messageScriptGlobal.setProperty("collision_curve_id", ((NxCurve*)destination.collisionCurve)->getId());
+                    if(patternArgument.contains("collision_curve_group_id"))
+                        messageScriptGlobal.setProperty("collision_curve_group_id", ((NxCurve*)destination.collisionCurve)->getGroupId());
+                    if(patternArgument.contains("collision_curve_label"))
+                        messageScriptGlobal.setProperty("collision_curve_label", ((NxCurve*)destination.collisionCurve)->getLabel());
+                    if(patternArgument.contains("collision_curve_xPos"))
+                        messageScriptGlobal.setProperty("collision_curve_xPos", ((NxCurve*)destination.collisionCurve)->getPos().x());
+                    if(patternArgument.contains("collision_curve_yPos"))
+                        messageScriptGlobal.setProperty("collision_curve_yPos", ((NxCurve*)destination.collisionCurve)->getPos().y());
+                    if(patternArgument.contains("collision_curve_zPos"))
+                        messageScriptGlobal.setProperty("collision_curve_zPos", ((NxCurve*)destination.collisionCurve)->getPos().z());
+                    if(patternArgument.contains("collision_xPos"))
+                        messageScriptGlobal.setProperty("collision_xPos", destination.collisionPoint.x());
+                    if(patternArgument.contains("collision_yPos"))
+                        messageScriptGlobal.setProperty("collision_yPos", destination.collisionPoint.y());
+                    if(patternArgument.contains("collision_zPos"))
+                        messageScriptGlobal.setProperty("collision_zPos", destination.collisionPoint.z());
+                    if(patternArgument.contains("collision_value_x"))
+                        messageScriptGlobal.setProperty("collision_value_x", destination.collisionValue.x());
+                    if(patternArgument.contains("collision_value_y"))
+                        messageScriptGlobal.setProperty("collision_value_y", destination.collisionValue.y());
+                    if(patternArgument.contains("collision_value_z"))
+                        messageScriptGlobal.setProperty("collision_value_z", destination.collisionValue.z());
+                    if((patternArgument.contains("collision_distance")) && (((NxCursor*)destination.cursor))) {
+                        NxPoint cursorPosDelta = (((NxCursor*)destination.cursor))?(destination.collisionPoint - ((NxCursor*)destination.cursor)->getCurrentPos()):(NxPoint());
+                        messageScriptGlobal.setProperty("collision_distance", qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()));
+                    }
+                }
+                {
+                    if(patternArgument.contains("status")) {
+                        messageScriptGlobal.setProperty("status", destination.status.status);
+                        isTransportMessage = true;
+                    }
+                    if(patternArgument.contains("nb_triggers"))
+                        messageScriptGlobal.setProperty("nb_triggers", destination.status.nbTriggers);
+                    if(patternArgument.contains("nb_cursors"))
+                        messageScriptGlobal.setProperty("nb_cursors", destination.status.nbCursors);
+                    if(patternArgument.contains("nb_curves"))
+                        messageScriptGlobal.setProperty("nb_curves", destination.status.nbCurves);
+                    if(patternArgument.contains("global_time"))
+                        messageScriptGlobal.setProperty("global_time", Transport::timeLocal);
+                    if(patternArgument.contains("global_time_verbose"))
+                        messageScriptGlobal.setProperty("global_time_verbose", Transport::getTimeLocalStr());
+                }
+
+                messageScriptResult = messageScriptEngine->evaluate(patternArgument);
+                if(messageScriptResult.isError())
+                    addString("**error**", patternArgument, patternIndex);
+                else if(messageScriptResult.isString()) {
+                    if(messageScriptResult.toString() == "suppress")
+                        suppressSend = true;
+                    else
+                        found = addString(messageScriptResult.toString(), QString("script %1").arg(patternIndex), patternIndex);
+                }
+                else
+                    found = addFloat(messageScriptResult.toNumber(), QString("script %1").arg(patternIndex), patternIndex);
+
+
+            }
+            else {
+                if(((NxTrigger*)destination.trigger)) {
+                    if(patternArgument == "trigger_id")
+                        found = addFloat(((NxTrigger*)destination.trigger)->getId(), patternArgument, patternIndex);
+                    else if(patternArgument == "trigger_group_id")
+                        found = addString(((NxTrigger*)destination.trigger)->getGroupId(), patternArgument, patternIndex);
+                    else if(patternArgument == "trigger_label")
+                        found = addString(((NxTrigger*)destination.trigger)->getLabel(), patternArgument, patternIndex);
+                    else if(patternArgument == "trigger_xPos")
+                        found = addFloat(((NxTrigger*)destination.trigger)->getPos().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "trigger_yPos")
+                        found = addFloat(((NxTrigger*)destination.trigger)->getPos().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "trigger_zPos")
+                        found = addFloat(((NxTrigger*)destination.trigger)->getPos().z(), patternArgument, patternIndex);
+                    else if((patternArgument == "trigger_value_x") && (((NxCursor*)destination.cursor)))
+                        found = addFloat(((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).x(), patternArgument, patternIndex);
+                    else if((patternArgument == "trigger_value_y") && (((NxCursor*)destination.cursor)))
+                        found = addFloat(((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).y(), patternArgument, patternIndex);
+                    else if((patternArgument == "trigger_value_z") && (((NxCursor*)destination.cursor)))
+                        found = addFloat(((NxCursor*)destination.cursor)->getCursorValue(((NxTrigger*)destination.trigger)->getPos()).z(), patternArgument, patternIndex);
+                    else if(patternArgument == "trigger_value")
+                        found = addFloat(((NxTrigger*)destination.trigger)->getTrigged(), patternArgument, patternIndex);
+                    else if(patternArgument == "trigger_duration")
+                        found = addFloat(((NxTrigger*)destination.trigger)->getTriggerOff(), patternArgument, patternIndex);
+                    else if((patternArgument == "trigger_distance") && (((NxCursor*)destination.cursor))) {
+                        NxPoint cursorPosDelta = ((NxTrigger*)destination.trigger)->getPos() - ((NxCursor*)destination.cursor)->getCurrentPos();
+                        found = addFloat(qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()), patternArgument, patternIndex);
+                    }
+                    else if(patternArgument == "trigger_message_id")
+                        found = addFloat(((NxTrigger*)destination.trigger)->getMessageId(), patternArgument, patternIndex);
+                    else if((patternArgument == "trigger_side") && (((NxCursor*)destination.cursor))) {
+                        qreal cursorAngle = fmod(((NxCursor*)destination.cursor)->getCurrentAngle().z(), 360);
+                        float side = 0;
+                        if(cursorAngle == 90 ) //cursor going straight up
+                            side = (((NxTrigger*)destination.trigger)->getPos().x() > ((NxCursor*)destination.cursor)->getCurrentPos().x()) ? 1:0;
+                        else if (cursorAngle == 270) //cursor going straight down
+                            side = (((NxTrigger*)destination.trigger)->getPos().x() > ((NxCursor*)destination.cursor)->getCurrentPos().x()) ? 0:1;
+                        else if(((0<cursorAngle) && (cursorAngle<90)) || ((270<cursorAngle) && (cursorAngle<360)) ) //cursor going to left
+                            side = (((NxTrigger*)destination.trigger)->getPos().y() > ((NxCursor*)destination.cursor)->getCurrentPos().y()) ? 1:0;
+                        else //cursor going to right
+                            side = (((NxTrigger*)destination.trigger)->getPos().y() > ((NxCursor*)destination.cursor)->getCurrentPos().y()) ? 0:1;
+                        found = addFloat(side, patternArgument, patternIndex);
+                    }
+                }
+                if(((NxCursor*)destination.cursor)) {
+                    if(patternArgument == "cursor_id")
+                        found = addFloat(((NxCursor*)destination.cursor)->getId(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_group_id")
+                        found = addString(((NxCursor*)destination.cursor)->getGroupId(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_label")
+                        found = addString(((NxCursor*)destination.cursor)->getLabel(), patternArgument, patternIndex);
+
+                    else if(patternArgument == "cursor_sxPos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sx(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_syPos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sy(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_szPos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sz(), patternArgument, patternIndex);
+
+                    else if(patternArgument == "cursor_value_sx")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sx(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_sy")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sy(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_sz")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sz(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_time")
+                        found = addFloat(((NxCursor*)destination.cursor)->getTimeLocal(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_time_percent")
+                        found = addFloat(((NxCursor*)destination.cursor)->getTimeLocalPercent(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_angle")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAngle().z(), patternArgument, patternIndex);
+
+                    else if(patternArgument == "cursor_xPos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_yPos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_zPos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().z(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_x")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_y")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_z")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().z(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_xPos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().x()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_yPos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().y()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_zPos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().z()    - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().z(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_x_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().x()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_y_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().y()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_z_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().z()  - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().z(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_sx_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sx() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sx(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_sy_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sy() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sy(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_sz_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sz() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sz(), patternArgument, patternIndex);
+
+                    else if(patternArgument == "cursor_aPos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_ePos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_dPos")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().z(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_a")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_e")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_d")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().z(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_aPos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().x()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_ePos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().y()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_dPos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAed().z()    - ((NxCursor*)destination.cursor)->getCurrentAedLastSend().z(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_a_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().x()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_e_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().y()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_d_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValueAed().z()  - ((NxCursor*)destination.cursor)->getCurrentValueAedLastSend().z(), patternArgument, patternIndex);
+
+                    else if(patternArgument == "cursor_value_sx_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sx() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sx(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_sy_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sy() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sy(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_value_sz_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentValue().sz() - ((NxCursor*)destination.cursor)->getCurrentValueLastSend().sz(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_sxPos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sx()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sx(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_syPos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sy()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sy(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_szPos_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentPos().sz()   - ((NxCursor*)destination.cursor)->getCurrentPosLastSend().sz(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_time_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getTimeLocal()         - ((NxCursor*)destination.cursor)->getTimeLocalLastSend(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_time_percent_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getTimeLocalPercent()  - ((NxCursor*)destination.cursor)->getTimeLocalPercentLastSend(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_angle_delta")
+                        found = addFloat(((NxCursor*)destination.cursor)->getCurrentAngle().z()  - ((NxCursor*)destination.cursor)->getCurrentAngleLastSend().z(), patternArgument, patternIndex);
+
+                    else if(patternArgument == "cursor_nb_loop")
+                        found = addFloat(((NxCursor*)destination.cursor)->getNbLoop(), patternArgument, patternIndex);
+                    else if(patternArgument == "cursor_message_id")
+                        found = addFloat(((NxCursor*)destination.cursor)->getMessageId(), patternArgument, patternIndex);
+                }
+                if(((NxCurve*)destination.curve)) {
+                    if(patternArgument == "curve_id")
+                        found = addFloat(((NxCurve*)destination.curve)->getId(), patternArgument, patternIndex);
+                    else if(patternArgument == "curve_group_id")
+                        found = addString(((NxCurve*)destination.curve)->getGroupId(), patternArgument, patternIndex);
+                    else if(patternArgument == "curve_label")
+                        found = addString(((NxCurve*)destination.curve)->getLabel(), patternArgument, patternIndex);
+                    else if(patternArgument == "curve_xPos")
+                        found = addFloat(((NxCurve*)destination.curve)->getPos().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "curve_yPos")
+                        found = addFloat(((NxCurve*)destination.curve)->getPos().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "curve_zPos")
+                        found = addFloat(((NxCurve*)destination.curve)->getPos().z(), patternArgument, patternIndex);
+                }
+                if(((NxCurve*)destination.collisionCurve)) {
+                    if(patternArgument == "collision_curve_id")
+                        found = addFloat(((NxCurve*)destination.collisionCurve)->getId(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_curve_group_id")
+                        found = addString(((NxCurve*)destination.collisionCurve)->getGroupId(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_curve_label")
+                        found = addString(((NxCurve*)destination.collisionCurve)->getLabel(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_curve_xPos")
+                        found = addFloat(((NxCurve*)destination.collisionCurve)->getPos().x(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_curve_yPos")
+                        found = addFloat(((NxCurve*)destination.collisionCurve)->getPos().y(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_curve_zPos")
+                        found = addFloat(((NxCurve*)destination.collisionCurve)->getPos().z(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_xPos")
+                        found = addFloat(destination.collisionPoint.x(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_yPos")
+                        found = addFloat(destination.collisionPoint.y(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_zPos")
+                        found = addFloat(destination.collisionPoint.z(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_value_x")
+                        found = addFloat(destination.collisionValue.x(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_value_y")
+                        found = addFloat(destination.collisionValue.y(), patternArgument, patternIndex);
+                    else if(patternArgument == "collision_value_z")
+                        found = addFloat(destination.collisionValue.z(), patternArgument, patternIndex);
+                    else if((patternArgument == "collision_distance") && (((NxCursor*)destination.cursor))) {
+                        NxPoint cursorPosDelta = destination.collisionPoint - ((NxCursor*)destination.cursor)->getCurrentPos();
+                        found = addFloat(qSqrt(cursorPosDelta.x()*cursorPosDelta.x() + cursorPosDelta.y()*cursorPosDelta.y() + cursorPosDelta.z()*cursorPosDelta.z()), patternArgument, patternIndex);
+                    }
+                }
+                {
+                    if(patternArgument == "timetag")
+                        found = addTimeTag(generateTimeTag(), patternArgument, patternIndex);
+                    else if(patternArgument == "status") {
+                        found = addString(destination.status.status, patternArgument, patternIndex);
+                        isTransportMessage = true;
+                    }
+                    else if(patternArgument == "nb_triggers")
+                        found = addFloat(destination.status.nbTriggers, patternArgument, patternIndex);
+                    else if(patternArgument == "nb_cursors")
+                        found = addFloat(destination.status.nbCursors, patternArgument, patternIndex);
+                    else if(patternArgument == "nb_curves")
+                        found = addFloat(destination.status.nbCurves, patternArgument, patternIndex);
+                    else if(patternArgument == "global_time")
+                        found = addFloat(Transport::timeLocal, patternArgument, patternIndex);
+                    else if(patternArgument == "global_time_verbose")
+                        found = addString(Transport::getTimeLocalStr(), patternArgument, patternIndex);
+                }
+            }
+
+            if(!found) {
+                if(patternArgument.startsWith("collision_"))
+                    suppressSend = true;
+                else if(Help::keywords.contains(patternArgument))
+                    addFloat(-1, patternArgument, patternIndex);
+                else {
+                    //If value is not a keyword, add raw value
+                    bool ok = false;
+                    qreal val = patternArgument.toDouble(&ok);
+                    if(ok)
+                        found = addFloat(val, QString("custom %1").arg(patternIndex), patternIndex);
+                    else
+                        found = addString(patternArgument, QString("custom %1").arg(patternIndex), patternIndex);
+                }
+            }
+        }
+
+
+        encode();
+    }
+
+    return (hasAdd && !suppressSend);
+}
+
+//Parts of the message that differ from the reference (empty when both parsers agree)
+QStringList Message::parseDifferences(const Message &reference) const {
+    QStringList differences;
+    if(buffer != reference.buffer)                                  differences << "buffer";
+    if(asciiMessage != reference.asciiMessage)                      differences << "ascii";
+    if(asciiMessageXml != reference.asciiMessageXml)                differences << "xml";
+    if(urlMessage.toEncoded() != reference.urlMessage.toEncoded())  differences << "url";
+    if(midiValues != reference.midiValues)                          differences << "values";
+    if(verboseValues != reference.verboseValues)                    differences << "verbose";
+    return differences;
+}
+
+#endif
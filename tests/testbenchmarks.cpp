@@ -0,0 +1,332 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "testbenchmarks.h"
+
+TestBenchmarks::TestBenchmarks(IanniX *_iannix, QObject *parent) :
+    QObject(parent) {
+    iannix = _iannix;
+}
+
+NxDocument* TestBenchmarks::getDocument() const {
+    return (NxDocument*)iannix->getObject("all", false);
+}
+qreal TestBenchmarks::random(qreal min, qreal max) const {
+    return min + (max - min) * qrand() / RAND_MAX;
+}
+void TestBenchmarks::addTriggers(quint32 count, quint16 firstId, const QString &group) {
+    for(quint32 triggerIndex = 0 ; triggerIndex < count ; triggerIndex++) {
+        iannix->execute(QString("add trigger %1").arg(firstId + triggerIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setGroup %1 %2").arg(firstId + triggerIndex).arg(group), ExecuteSourceSystem);
+        iannix->execute(QString("setPos %1 %2 %3 0").arg(firstId + triggerIndex).arg(random(-TEST_BENCHMARK_AREA / 2., TEST_BENCHMARK_AREA / 2.)).arg(random(-TEST_BENCHMARK_AREA / 2., TEST_BENCHMARK_AREA / 2.)), ExecuteSourceSystem);
+        iannix->execute(QString("setSize %1 0.2").arg(firstId + triggerIndex), ExecuteSourceSystem);
+    }
+}
+
+//Scheduler steps as the offline render does them (timerTick and schedulerClockTick are private slots)
+void TestBenchmarks::tick(quint32 ticks) {
+    iannix->forceGoto(0);
+    for(quint32 tickIndex = 0 ; tickIndex < ticks ; tickIndex++) {
+        QMetaObject::invokeMethod(iannix, "schedulerClockTick", Qt::DirectConnection, Q_ARG(qreal, TEST_BENCHMARK_STEP));
+        QMetaObject::invokeMethod(iannix, "timerTick",          Qt::DirectConnection, Q_ARG(qreal, TEST_BENCHMARK_STEP));
+    }
+}
+
+//OSC datagram /iannix/setPointAt curveId index x y
+QByteArray TestBenchmarks::oscSetPointAt(qint32 curveId, qint32 index, float x, float y) {
+    QByteArray datagram;
+    QDataStream stream(&datagram, QIODevice::WriteOnly);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream.writeRawData("/iannix/setPointAt\0\0", 20);
+    stream.writeRawData(",iiff\0\0\0", 8);
+    stream << curveId << index << x << y;
+    return datagram;
+}
+
+
+void TestBenchmarks::initTestCase() {
+    qsrand(1);
+}
+void TestBenchmarks::cleanup() {
+    getDocument()->clear();
+}
+
+//Smooth sine curves of 10, 1k and 60k points (path and arc-length table build, then cursor position and angle)
+//Point indexes are 16 bits, so 60k stands for the 100k-point case
+void TestBenchmarks::curves() {
+    QList<quint32> pointsCounts = QList<quint32>() << 10 << 1000 << 60000;
+    foreach(quint32 pointsCount, pointsCounts) {
+        iannix->execute("add curve 1", ExecuteSourceSystem);
+        iannix->execute("add cursor 2", ExecuteSourceSystem);
+        iannix->execute("setCurve 2 1", ExecuteSourceSystem);
+        NxCurve *curve = (NxCurve*)iannix->getObjectById(1);
+        QVERIFY(curve);
+
+        QElapsedTimer benchmarkTimer;
+        benchmarkTimer.start();
+        for(quint32 pointIndex = 0 ; pointIndex < pointsCount ; pointIndex++) {
+            qreal angle = 20 * M_PI * pointIndex / pointsCount;
+            curve->setPointAt(pointIndex, NxPoint(20. * pointIndex / pointsCount - 10, qSin(angle)), true, (pointIndex == pointsCount - 1));
+        }
+        curve->getPathLength();
+        qreal buildTime = benchmarkTimer.nsecsElapsed() / 1000000.;
+
+        qreal checksum = 0;
+        benchmarkTimer.restart();
+        for(quint32 evaluation = 0 ; evaluation < TEST_BENCHMARK_EVALUATIONS ; evaluation++) {
+            NxPoint angle, pt = curve->getPointAndAngleAt((evaluation + 0.5) / TEST_BENCHMARK_EVALUATIONS, &angle);
+            checksum += pt.x() + angle.z();
+        }
+        qreal evaluationTime = benchmarkTimer.nsecsElapsed() / 1000. / TEST_BENCHMARK_EVALUATIONS;
+        QVERIFY(checksum == checksum);
+
+        qDebug("[BENCHMARK] Curve of %5d points : built in %9.3f ms, %7.3f us per cursor position and angle", pointsCount, buildTime, evaluationTime);
+        getDocument()->clear();
+    }
+}
+
+//Tick cost of 200 cursors on horizontal lines sweeping 1k, 5k and 20k triggers
+void TestBenchmarks::triggers() {
+    QList<quint32> triggersCounts = QList<quint32>() << 1000 << 5000 << 20000;
+    foreach(quint32 triggersCount, triggersCounts) {
+        for(quint16 cursorIndex = 0 ; cursorIndex < TEST_BENCHMARK_CURSORS ; cursorIndex++) {
+            qreal y = TEST_BENCHMARK_AREA * ((qreal)cursorIndex / TEST_BENCHMARK_CURSORS - 0.5);
+            quint16 curveId = 1000 + cursorIndex, cursorId = 1 + cursorIndex;
+            iannix->execute(QString("add curve %1").arg(curveId), ExecuteSourceSystem);
+            iannix->execute(QString("setGroup %1 lines").arg(curveId), ExecuteSourceSystem);
+            iannix->execute(QString("setPointAt %1 0 %2 %3").arg(curveId).arg(-TEST_BENCHMARK_AREA / 2.).arg(y), ExecuteSourceSystem);
+            iannix->execute(QString("setPointAt %1 1 %2 %3").arg(curveId).arg( TEST_BENCHMARK_AREA / 2.).arg(y), ExecuteSourceSystem);
+            iannix->execute(QString("add cursor %1").arg(cursorId), ExecuteSourceSystem);
+            iannix->execute(QString("setGroup %1 cursors").arg(cursorId), ExecuteSourceSystem);
+            iannix->execute(QString("setCurve %1 %2").arg(cursorId).arg(curveId), ExecuteSourceSystem);
+            iannix->execute(QString("setWidth %1 %2").arg(cursorId).arg((qreal)TEST_BENCHMARK_AREA / TEST_BENCHMARK_CURSORS), ExecuteSourceSystem);
+            iannix->execute(QString("setSpeed %1 %2").arg(cursorId).arg(1 + random(0, 1)), ExecuteSourceSystem);
+            iannix->execute(QString("setPattern %1 0 0 1").arg(cursorId), ExecuteSourceSystem);
+        }
+        addTriggers(triggersCount, 10000);
+
+        qreal tickTime = Transport::perfSchedulerTickTime, collisionCounter = Transport::perfSchedulerCollisionCounter;
+        tick(TEST_BENCHMARK_TICKS);
+        tickTime         = (Transport::perfSchedulerTickTime         - tickTime)         / TEST_BENCHMARK_TICKS;
+        collisionCounter = (Transport::perfSchedulerCollisionCounter - collisionCounter) / TEST_BENCHMARK_TICKS;
+
+        qDebug("[BENCHMARK] %d cursors, %5d triggers : %7.3f ms per tick, %8.0f collision tests per tick", TEST_BENCHMARK_CURSORS, triggersCount, tickTime, collisionCounter);
+        getDocument()->clear();
+    }
+}
+
+//OSC input throughput : setPointAt datagrams from a local UDP sender, then the same datagrams decoded and dispatched without the socket
+void TestBenchmarks::oscInput() {
+    iannix->execute("add curve 2000", ExecuteSourceSystem);
+    for(quint16 pointIndex = 0 ; pointIndex < TEST_BENCHMARK_OSC_POINTS ; pointIndex++)
+        iannix->execute(QString("setPointAt 2000 %1 %2 0").arg(pointIndex).arg(10. * pointIndex / TEST_BENCHMARK_OSC_POINTS - 5), ExecuteSourceSystem);
+    QList<QByteArray> datagrams;
+    for(quint32 messageIndex = 0 ; messageIndex < TEST_BENCHMARK_OSC_MESSAGES ; messageIndex++) {
+        quint16 pointIndex = messageIndex % TEST_BENCHMARK_OSC_POINTS;
+        datagrams << oscSetPointAt(2000, pointIndex, 10. * pointIndex / TEST_BENCHMARK_OSC_POINTS - 5, qSin(messageIndex / 100.));
+    }
+    quint16 port = UiHelp::oscPort;
+
+    //Through the socket, read back after each burst as the scheduler timer does
+    QUdpSocket sender;
+    qreal received = Transport::perfOscReceiveCounter;
+    QElapsedTimer benchmarkTimer;
+    benchmarkTimer.start();
+    for(quint32 messageIndex = 0 ; messageIndex < (quint32)datagrams.count() ; messageIndex++) {
+        sender.writeDatagram(datagrams.at(messageIndex), QHostAddress::LocalHost, port);
+        if(((messageIndex + 1) % TEST_BENCHMARK_OSC_BURST) == 0)
+            iannix->interfaceOsc->parseOSC();
+    }
+    QElapsedTimer drainTimer;
+    drainTimer.start();
+    while((Transport::perfOscReceiveCounter - received < datagrams.count()) && (drainTimer.elapsed() < 1000))
+        iannix->interfaceOsc->parseOSC();
+    qreal elapsed = benchmarkTimer.nsecsElapsed() / 1000000000.;
+    received = Transport::perfOscReceiveCounter - received;
+    qDebug("[BENCHMARK] OSC input through UDP port %d : %.0f of %d messages in %.3f s : %.0f messages/s", port, received, datagrams.count(), elapsed, received / elapsed);
+
+    //Decoding and dispatch only
+    benchmarkTimer.restart();
+    foreach(const QByteArray &datagram, datagrams)
+        iannix->interfaceOsc->parseOSC(datagram.constData(), datagram.size(), QHostAddress::LocalHost, port);
+    elapsed = benchmarkTimer.nsecsElapsed() / 1000000000.;
+    qDebug("[BENCHMARK] OSC input decoding and dispatch : %d messages in %.3f s : %.0f messages/s", datagrams.count(), elapsed, datagrams.count() / elapsed);
+}
+
+//Creation rate of 50k triggers with automatic ids from a script, with run() commands then with a single addBatch()
+void TestBenchmarks::objectCreation() {
+    NxDocument *document = getDocument();
+    QStringList scripts;
+    scripts << QString("for(var triggerIndex = 0 ; triggerIndex < %1 ; triggerIndex++) {"
+                       "    run('add trigger auto');"
+                       "    run('setGroup current triggers');"
+                       "    run('setPos current ' + random(-%2, %2) + ' ' + random(-%2, %2) + ' 0');"
+                       "    run('setSize current 0.2');"
+                       "}").arg(TEST_BENCHMARK_OBJECTS).arg(TEST_BENCHMARK_AREA / 2.);
+    scripts << QString("var triggers = new Array();"
+                       "for(var triggerIndex = 0 ; triggerIndex < %1 ; triggerIndex++)"
+                       "    triggers.push({group: 'triggers', pos: [random(-%2, %2), random(-%2, %2), 0], size: 0.2});"
+                       "addBatch(triggers, 'trigger');").arg(TEST_BENCHMARK_OBJECTS).arg(TEST_BENCHMARK_AREA / 2.);
+    QStringList modes = QStringList() << "run() commands" << "addBatch()";
+
+    for(quint16 scriptIndex = 0 ; scriptIndex < scripts.count() ; scriptIndex++) {
+        QElapsedTimer benchmarkTimer;
+        benchmarkTimer.start();
+        document->source = ExecuteSourceGui;
+        document->scriptEvaluate(scripts.at(scriptIndex), false);
+        qreal elapsed = benchmarkTimer.nsecsElapsed() / 1000000000.;
+        QCOMPARE(document->objects.count(), TEST_BENCHMARK_OBJECTS);
+        qDebug("[BENCHMARK] %d triggers created with %s in %.3f s : %.0f objects/s", TEST_BENCHMARK_OBJECTS, qPrintable(modes.at(scriptIndex)), elapsed, TEST_BENCHMARK_OBJECTS / elapsed);
+
+        //Batch without group (flat x y z positions) on top of the others, ids continue after the highest one
+        if(scriptIndex == scripts.count() - 1) {
+            QScriptValue corners = document->scriptEvaluate(QString("addBatch([-%1, -%1, 0,   %1, -%1, 0,   %1, %1, 0,   -%1, %1, 0], 'trigger');").arg(TEST_BENCHMARK_AREA / 2.), false);
+            QCOMPARE(corners.property("length").toInt32(), 4);
+            QCOMPARE(document->objects.count(), TEST_BENCHMARK_OBJECTS + 4);
+        }
+        document->clear();
+    }
+}
+
+//Frame time of 20k static triggers in two groups, drawn in batches then one by one.
+//The view stays hidden, frames are drawn offscreen (LIBGL_ALWAYS_SOFTWARE=1 measures with Mesa llvmpipe)
+void TestBenchmarks::rendering() {
+    addTriggers(TEST_BENCHMARK_RENDERED / 2, 1,                              "triggersA");
+    addTriggers(TEST_BENCHMARK_RENDERED / 2, 1 + TEST_BENCHMARK_RENDERED / 2, "triggersB");
+    iannix->execute("zoom 50", ExecuteSourceSystem);
+    Application::render->resize(1280, 720);
+
+    bool batchTriggers = Render::batchTriggers;
+    for(quint16 mode = 0 ; mode < 2 ; mode++) {
+        Render::batchTriggers = (mode == 0);
+        qreal frameTime = Transport::perfOpenGLFrameTime, frameCounter = Transport::perfOpenGLCounterTime, batchedCounter = Transport::perfOpenGLBatchedCounter;
+        for(quint16 frame = 0 ; frame < TEST_BENCHMARK_FRAMES ; frame++) {
+#ifdef USE_GLWIDGET
+            Application::render->QGLWidget::updateGL();
+#else
+            Application::takeScreenshot();
+#endif
+        }
+        frameCounter = Transport::perfOpenGLCounterTime - frameCounter;
+        if(frameCounter <= 0) {
+            Render::batchTriggers = batchTriggers;
+#ifdef QT4
+            QSKIP("No OpenGL context to draw the frames", SkipAll);
+#else
+            QSKIP("No OpenGL context to draw the frames");
+#endif
+        }
+        frameTime      = (Transport::perfOpenGLFrameTime      - frameTime)      / frameCounter;
+        batchedCounter = (Transport::perfOpenGLBatchedCounter - batchedCounter) / frameCounter;
+        qDebug("[BENCHMARK] %d triggers %s : %7.3f ms per frame (%.0f frames), %.0f batched triggers", TEST_BENCHMARK_RENDERED, (mode == 0)?("in batches"):("one by one"), frameTime, frameCounter, batchedCounter);
+    }
+    Render::batchTriggers = batchTriggers;
+}
+
+//Command throughput (parse and dispatch, as IanniX::benchmarkCommands() does with a journal) over control traffic
+//on 100 triggers and 10 cursors : text commands as TCP or UDP send them, then typed arguments as OSC sends them
+void TestBenchmarks::commands() {
+    addTriggers(100, 1);
+    for(quint16 cursorIndex = 0 ; cursorIndex < 10 ; cursorIndex++) {
+        iannix->execute(QString("add curve %1").arg(1001 + cursorIndex), ExecuteSourceSystem);
+        for(quint16 pointIndex = 0 ; pointIndex < 10 ; pointIndex++)
+            iannix->execute(QString("setPointAt %1 %2 %3 %4").arg(1001 + cursorIndex).arg(pointIndex).arg(pointIndex).arg(cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("add cursor %1").arg(2001 + cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setCurve %1 %2").arg(2001 + cursorIndex).arg(1001 + cursorIndex), ExecuteSourceSystem);
+    }
+
+    QStringList texts;
+    QList<MessageIncomming> typed;
+    for(quint32 commandIndex = 0 ; commandIndex < TEST_BENCHMARK_COMMANDS ; commandIndex++) {
+        quint16 triggerId = 1 + commandIndex % 100, curveId = 1001 + commandIndex % 10, cursorId = 2001 + commandIndex % 10;
+        qreal value = random(-10, 10);
+        switch(commandIndex % 5) {
+        case 0:
+            texts << QString("setPos %1 %2 %3").arg(triggerId).arg(value).arg(-value);
+            typed << MessageIncomming("osc", "127.0.0.1", 57120, "setPos", QVariantList() << triggerId << value << -value);
+            break;
+        case 1:
+            texts << QString("setPointAt %1 %2 %3 %4").arg(curveId).arg(commandIndex % 10).arg(commandIndex % 10).arg(value);
+            typed << MessageIncomming("osc", "127.0.0.1", 57120, "setPointAt", QVariantList() << curveId << commandIndex % 10 << commandIndex % 10 << value);
+            break;
+        case 2:
+            texts << QString("setSpeed %1 %2").arg(cursorId).arg(qAbs(value));
+            typed << MessageIncomming("osc", "127.0.0.1", 57120, "setSpeed", QVariantList() << cursorId << qAbs(value));
+            break;
+        case 3:
+            texts << QString("setSize %1 %2").arg(triggerId).arg(qAbs(value) / 10);
+            typed << MessageIncomming("osc", "127.0.0.1", 57120, "setSize", QVariantList() << triggerId << qAbs(value) / 10);
+            break;
+        default:
+            texts << QString("setLabel %1 trigger_%2").arg(triggerId).arg(commandIndex);
+            typed << MessageIncomming("osc", "127.0.0.1", 57120, "setLabel", QVariantList() << triggerId << QString("trigger_%1").arg(commandIndex));
+            break;
+        }
+    }
+
+    QElapsedTimer benchmarkTimer;
+    benchmarkTimer.start();
+    foreach(const QString &text, texts)
+        iannix->execute(text, ExecuteSourceNetwork);
+    qreal elapsed = benchmarkTimer.nsecsElapsed() / 1000000000.;
+    qDebug("[BENCHMARK] %d text commands in %.3f s : %.0f commands/s", texts.count(), elapsed, texts.count() / elapsed);
+
+    benchmarkTimer.restart();
+    foreach(const MessageIncomming &message, typed)
+        iannix->execute(message);
+    elapsed = benchmarkTimer.nsecsElapsed() / 1000000000.;
+    qDebug("[BENCHMARK] %d typed commands in %.3f s : %.0f commands/s", typed.count(), elapsed, typed.count() / elapsed);
+}
+
+//HTTP output : 100 cursors sending a message on every tick to a local sink, in real time.
+//The HTTP interface counts what it sends and what the sink receives every second
+void TestBenchmarks::httpOutput() {
+    QVERIFY(iannix->interfaceHttp->sinkChanged(TEST_BENCHMARK_HTTP_PORT));
+    for(quint16 cursorIndex = 0 ; cursorIndex < TEST_BENCHMARK_HTTP_CURSORS ; cursorIndex++) {
+        iannix->execute(QString("add curve %1").arg(1000 + cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setEquation %1 polar 0.5, 2 * t * 2*PI, 0").arg(1000 + cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setPos %1 %2 0 0").arg(1000 + cursorIndex).arg(10. * cursorIndex / TEST_BENCHMARK_HTTP_CURSORS - 5), ExecuteSourceSystem);
+        iannix->execute(QString("add cursor %1").arg(1 + cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setCurve %1 %2").arg(1 + cursorIndex).arg(1000 + cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setSpeed %1 %2").arg(1 + cursorIndex).arg(1 + random(0, 1)), ExecuteSourceSystem);
+        iannix->execute(QString("setPattern %1 0 0 1").arg(1 + cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setMessage %1 1, http://127.0.0.1:%2/iannix cursor_id cursor_xPos cursor_yPos").arg(1 + cursorIndex).arg(TEST_BENCHMARK_HTTP_PORT), ExecuteSourceSystem);
+    }
+
+    //Messages are only sent once IanniX has started, sockets need the event loop between two ticks
+    bool hasStarted = iannix->hasStarted;
+    iannix->hasStarted = true;
+    iannix->forceGoto(0);
+    for(quint16 second = 0 ; second < TEST_BENCHMARK_HTTP_SECONDS ; second++) {
+        QElapsedTimer secondTimer;
+        secondTimer.start();
+        while(secondTimer.elapsed() < 1000) {
+            QMetaObject::invokeMethod(iannix, "schedulerClockTick", Qt::DirectConnection, Q_ARG(qreal, TEST_BENCHMARK_STEP));
+            QMetaObject::invokeMethod(iannix, "timerTick",          Qt::DirectConnection, Q_ARG(qreal, TEST_BENCHMARK_STEP));
+            QCoreApplication::processEvents();
+        }
+        qDebug("[BENCHMARK] HTTP output, %d cursors, second %d : %s", TEST_BENCHMARK_HTTP_CURSORS, second + 1, qPrintable(iannix->interfaceHttp->getStats().simplified()));
+    }
+    iannix->hasStarted = hasStarted;
+    iannix->interfaceHttp->sinkChanged(0);
+}
@@ -0,0 +1,74 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTBENCHMARKS_H
+#define TESTBENCHMARKS_H
+
+#include <QtTest>
+#include "iannix.h"
+#include "transport/transport.h"
+
+#define TEST_BENCHMARK_EVALUATIONS  100000  //Cursor positions evaluated on each curve
+#define TEST_BENCHMARK_CURSORS      200     //Cursors sweeping the triggers
+#define TEST_BENCHMARK_AREA         40      //Side of the square holding the objects
+#define TEST_BENCHMARK_TICKS        1000    //Scheduler ticks measured per score
+#define TEST_BENCHMARK_STEP         0.005   //Scheduler step (seconds)
+#define TEST_BENCHMARK_OSC_MESSAGES 100000  //setPointAt messages sent to the OSC input
+#define TEST_BENCHMARK_OSC_POINTS   100     //Points of the curve they move
+#define TEST_BENCHMARK_OSC_BURST    200     //Datagrams sent before the OSC input reads its socket
+#define TEST_BENCHMARK_OBJECTS      50000   //Triggers created from a script
+#define TEST_BENCHMARK_RENDERED     20000   //Triggers drawn
+#define TEST_BENCHMARK_FRAMES       100     //Frames drawn per rendering mode
+#define TEST_BENCHMARK_COMMANDS     200000  //Commands executed per form (text and typed)
+#define TEST_BENCHMARK_HTTP_CURSORS 100     //Cursors sending HTTP messages
+#define TEST_BENCHMARK_HTTP_PORT    1238    //Local HTTP sink receiving them
+#define TEST_BENCHMARK_HTTP_SECONDS 3       //Seconds of HTTP output measured
+
+//Scripted benchmarks (IanniX -benchmark), each one prints its numbers in the console
+class TestBenchmarks : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TestBenchmarks(IanniX *_iannix, QObject *parent = 0);
+
+private:
+    IanniX *iannix;
+    NxDocument* getDocument() const;
+    qreal random(qreal min, qreal max) const;
+    void addTriggers(quint32 count, quint16 firstId, const QString &group = "triggers");
+    void tick(quint32 ticks);
+    static QByteArray oscSetPointAt(qint32 curveId, qint32 index, float x, float y);
+
+private slots:
+    void initTestCase();
+    void cleanup();
+    void curves();
+    void triggers();
+    void oscInput();
+    void objectCreation();
+    void rendering();
+    void commands();
+    void httpOutput();
+};
+
+#endif // TESTBENCHMARKS_H
@@ -0,0 +1,253 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "testcurves.h"
+
+//Equations of the equation curves, evaluated here rather than through muParser
+typedef NxPoint (*TestCurveEquation)(qreal t);
+static NxPoint equationCartesian(qreal t) {
+    return NxPoint(10 * qCos(t * 2 * M_PI), 2 * qSin(3 * t * 2 * M_PI), 0);
+}
+static NxPoint equationPolar(qreal t) {
+    qreal r = 3, theta = t * M_PI, phi = 0;
+    return NxPoint(r * qSin(theta) * qCos(phi), r * qCos(theta), r * qSin(theta) * qSin(phi));
+}
+
+
+TestCurves::TestCurves(IanniX *_iannix, QObject *parent) :
+    QObject(parent) {
+    iannix = _iannix;
+}
+
+NxCurve* TestCurves::addCurve(quint16 id, const QStringList &commands) {
+    iannix->execute(QString("add curve %1").arg(id), ExecuteSourceSystem);
+    foreach(const QString &command, commands)
+        iannix->execute(command.arg(id), ExecuteSourceSystem);
+
+    //Path lengths are only measured for curves with a cursor
+    iannix->execute(QString("add cursor %1").arg(id + 100), ExecuteSourceSystem);
+    iannix->execute(QString("setCurve %1 %2").arg(id + 100).arg(id), ExecuteSourceSystem);
+
+    NxCurve *curve = (NxCurve*)iannix->getObjectById(id);
+    if(curve)
+        curve->getPathLength();
+    return curve;
+}
+bool TestCurves::isNearCorner(NxCurve *curve, qreal val) {
+    if((val < TEST_CURVE_CORNER) || (val > 1 - TEST_CURVE_CORNER))
+        return true;
+    if(curve->getCurveType() == CurveTypePoints)
+        for(quint16 indexPoint = 1 ; indexPoint < curve->getPathPointsCount() - 1 ; indexPoint++)
+            if(qAbs(val - curve->getPathPointsAt(indexPoint).currentLength / curve->getPathLength()) < TEST_CURVE_CORNER)
+                return true;
+    return false;
+}
+
+
+//Frozen copy of NxCurve::getPointAt(quint16, qreal)
+NxPoint TestCurves::baselinePointAt(NxCurve *curve, quint16 index, qreal t) {
+    NxPoint p1 = curve->getPathPointsAt(index), p2 = curve->getPathPointsAt(index+1);
+    NxPoint c1 = curve->getPathPointsAt(index+1).c1, c2 = curve->getPathPointsAt(index+1).c2;
+    qreal mt = 1 - t;
+    if((c1 == NxPoint()) && (c2 == NxPoint())) {
+        return NxPoint( (p1. x()*mt + p2. x()*t),
+                        (p1. y()*mt + p2. y()*t),
+                        (p1. z()*mt + p2. z()*t),
+                        (p1.sx()*mt + p2.sx()*t),
+                        (p1.sy()*mt + p2.sy()*t),
+                        (p1.sz()*mt + p2.sz()*t));
+    }
+    else {
+        NxPoint p1c = p1 + c1, p2c = p2 + c2;
+        qreal t2 = t*t, t3 = t2*t, mt2 = mt*mt, mt3 = mt2*mt;
+        return NxPoint( (p1. x()*mt3 + 3*p1c. x()*t*mt2 + 3*p2c. x()*t2*mt + p2. x()*t3),
+                        (p1. y()*mt3 + 3*p1c. y()*t*mt2 + 3*p2c. y()*t2*mt + p2. y()*t3),
+                        (p1. z()*mt3 + 3*p1c. z()*t*mt2 + 3*p2c. z()*t2*mt + p2. z()*t3),
+                        (p1.sx()*mt3 + 3*p1c.sx()*t*mt2 + 3*p2c.sx()*t2*mt + p2.sx()*t3),
+                        (p1.sy()*mt3 + 3*p1c.sy()*t*mt2 + 3*p2c.sy()*t2*mt + p2.sy()*t3),
+                        (p1.sz()*mt3 + 3*p1c.sz()*t*mt2 + 3*p2c.sz()*t2*mt + p2.sz()*t3));
+    }
+}
+
+//Frozen copy of NxCurve::getPointAt(qreal) for points curves : linear scan, raw Bezier parameter
+NxPoint TestCurves::baselinePointAt(NxCurve *curve, qreal val) {
+    qreal length = 0, lengthOld = 0;
+    qreal lengthTarget = curve->getPathLength() * val;
+    quint16 index = 0;
+    for(quint16 indexPoint = 1 ; indexPoint < curve->getPathPointsCount() ; indexPoint++) {
+        length = curve->getPathPointsAt(indexPoint).currentLength;
+        if(length >= lengthTarget) {
+            index = indexPoint - 1;
+            break;
+        }
+        lengthOld = length;
+    }
+    if((length - lengthOld) != 0)
+        return baselinePointAt(curve, index, (lengthTarget - lengthOld) / (length - lengthOld));
+    else
+        return baselinePointAt(curve, index, 0);
+}
+
+//Frozen copy of the angle of NxCurve::getAngleAt (deltaPos = point 0.001 before - point)
+NxPoint TestCurves::baselineAngle(const NxPoint &deltaPos) {
+    qreal angleZ = qAtan2(deltaPos.x(), deltaPos.y()) * 180.0F / M_PI + 90;
+    qreal angleY = qAtan2(qSqrt(deltaPos.x()*deltaPos.x() + deltaPos.y()*deltaPos.y()), deltaPos.z()) * 180.0F / M_PI + 90 + 180;
+    return NxPoint(0, angleY, angleZ);
+}
+
+//Point at a given fraction of the path length, Bezier segments walked in small steps (reference of the arc-length table)
+NxPoint TestCurves::arcLengthPointAt(NxCurve *curve, qreal val) {
+    qreal length = 0, lengthOld = 0;
+    qreal lengthTarget = curve->getPathLength() * val;
+    quint16 index = 0;
+    for(quint16 indexPoint = 1 ; indexPoint < curve->getPathPointsCount() ; indexPoint++) {
+        length = curve->getPathPointsAt(indexPoint).currentLength;
+        if(length >= lengthTarget) {
+            index = indexPoint - 1;
+            break;
+        }
+        lengthOld = length;
+    }
+    qreal fraction = ((length - lengthOld) != 0)?((lengthTarget - lengthOld) / (length - lengthOld)):(0);
+    if((curve->getPathPointsAt(index+1).c1 == NxPoint()) && (curve->getPathPointsAt(index+1).c2 == NxPoint()))
+        return baselinePointAt(curve, index, fraction);
+
+    //Total length of the segment, then the step where the target fraction is reached
+    qreal arcLength = 0;
+    NxPoint pt = baselinePointAt(curve, index, 0);
+    for(quint32 step = 1 ; step <= TEST_CURVE_ARC_STEPS ; step++) {
+        NxPoint ptNext = baselinePointAt(curve, index, (qreal)step / TEST_CURVE_ARC_STEPS);
+        arcLength += distance(pt, ptNext);
+        pt = ptNext;
+    }
+    qreal arcTarget = fraction * arcLength, arc = 0;
+    pt = baselinePointAt(curve, index, 0);
+    for(quint32 step = 1 ; step <= TEST_CURVE_ARC_STEPS ; step++) {
+        NxPoint ptNext = baselinePointAt(curve, index, (qreal)step / TEST_CURVE_ARC_STEPS);
+        qreal delta = distance(pt, ptNext);
+        if((arc + delta >= arcTarget) && (delta > 0))
+            return baselinePointAt(curve, index, (step - 1 + (arcTarget - arc) / delta) / TEST_CURVE_ARC_STEPS);
+        arc += delta;
+        pt = ptNext;
+    }
+    return baselinePointAt(curve, index, 1);
+}
+
+qreal TestCurves::distance(const NxPoint &p1, const NxPoint &p2) {
+    NxPoint delta = p2 - p1;
+    return qSqrt(delta.x()*delta.x() + delta.y()*delta.y() + delta.z()*delta.z());
+}
+qreal TestCurves::angleDistance(const NxPoint &angle1, const NxPoint &angle2) {
+    qreal deltaY = fmod(qAbs(angle1.y() - angle2.y()), 360), deltaZ = fmod(qAbs(angle1.z() - angle2.z()), 360);
+    return qMax(qMin(deltaY, 360 - deltaY), qMin(deltaZ, 360 - deltaZ));
+}
+
+
+void TestCurves::cleanup() {
+    iannix->execute("clear", ExecuteSourceSystem);
+}
+
+//Straight segments : same positions as before, same angles away from the path points
+void TestCurves::straightSegments() {
+    NxCurve *curve = addCurve(9001, QStringList() << "setPointAt %1 0 0 0 0" << "setPointAt %1 1 4 0 0" << "setPointAt %1 2 4 3 1" << "setPointAt %1 3 -2 5 0");
+    QVERIFY(curve);
+
+    qreal positionError = 0, angleError = 0;
+    quint32 corners = 0;
+    for(quint32 sample = 0 ; sample <= TEST_CURVE_SAMPLES ; sample++) {
+        qreal val = (qreal)sample / TEST_CURVE_SAMPLES;
+        NxPoint angle, pt = curve->getPointAndAngleAt(val, &angle);
+        positionError = qMax(positionError, distance(pt, baselinePointAt(curve, val)));
+        if(isNearCorner(curve, val))
+            corners++;
+        else
+            angleError = qMax(angleError, angleDistance(angle, baselineAngle(baselinePointAt(curve, val - 0.001) - baselinePointAt(curve, val))));
+    }
+    qDebug("[TESTS] Straight segments : position error %g, angle error %g deg (%u samples near path points not compared)", positionError, angleError, corners);
+    QVERIFY(positionError <= TEST_CURVE_POS);
+    QVERIFY(angleError    <= TEST_CURVE_ANGLE);
+}
+
+//Bezier segments : positions move along the curve (arc-length parameter instead of the raw one), checked against the exact arc length
+void TestCurves::bezierSegments() {
+    NxCurve *curve = addCurve(9002, QStringList() << "setPointAt %1 0 0 0 0" << "setPointAt %1 1 4 0 0 2 3 0 -1 2 0" << "setPointAt %1 2 8 -2 1 1 -2 0 -2 -1 0.5");
+    QVERIFY(curve);
+
+    qreal positionChange = 0, positionError = 0, angleError = 0;
+    quint32 corners = 0;
+    for(quint32 sample = 0 ; sample <= TEST_CURVE_SAMPLES ; sample++) {
+        qreal val = (qreal)sample / TEST_CURVE_SAMPLES;
+        NxPoint angle, pt = curve->getPointAndAngleAt(val, &angle);
+        positionChange = qMax(positionChange, distance(pt, baselinePointAt(curve, val)));
+        positionError  = qMax(positionError,  distance(pt, arcLengthPointAt(curve, val)));
+        if(isNearCorner(curve, val))
+            corners++;
+        else
+            angleError = qMax(angleError, angleDistance(angle, baselineAngle(arcLengthPointAt(curve, val - 0.001) - arcLengthPointAt(curve, val))));
+    }
+    qDebug("[TESTS] Bezier segments : path length %g, position change from the raw parameter %g", curve->getPathLength(), positionChange);
+    qDebug("[TESTS] Bezier segments : position error %g against the exact arc length, angle error %g deg (%u samples near path points not compared)", positionError, angleError, corners);
+    QVERIFY(positionError <= TEST_CURVE_ARC * curve->getPathLength());
+    QVERIFY(angleError    <= TEST_CURVE_ANGLE);
+}
+
+//Ellipses : same positions, exact angle where cursors took it 0.001 inside the curve at its ends
+void TestCurves::ellipse() {
+    NxCurve *curve = addCurve(9003, QStringList() << "setPointsEllipse %1 4 2");
+    QVERIFY(curve);
+
+    qreal positionError = 0, angleError = 0;
+    for(quint32 sample = 0 ; sample <= TEST_CURVE_SAMPLES ; sample++) {
+        qreal val = (qreal)sample / TEST_CURVE_SAMPLES, valAngle = val;
+        if(val == 0)        valAngle = val + 0.001;
+        else if(val == 1)   valAngle = val - 0.001;
+        NxPoint angle, pt = curve->getPointAndAngleAt(val, &angle);
+        positionError = qMax(positionError, distance(pt, NxPoint(4 * qCos(2 * val * M_PI), 2 * qSin(2 * val * M_PI), 0)));
+        angleError    = qMax(angleError, angleDistance(angle, NxPoint(0, 0, -((2 * valAngle * M_PI) + M_PI_2) * 180.0F / M_PI)));
+    }
+    qDebug("[TESTS] Ellipse : position error %g, angle error %g deg", positionError, angleError);
+    QVERIFY(positionError <= TEST_CURVE_POS);
+    QVERIFY(angleError    <= TEST_CURVE_ANGLE);
+}
+
+//Cartesian and polar equations : same positions, same angles away from the curve ends
+void TestCurves::equations() {
+    QStringList equations = QStringList() << "cartesian 10*cos(t*2*PI),2*sin(3*t*2*PI),0" << "polar 3,t*PI,0";
+    TestCurveEquation references[] = { equationCartesian, equationPolar };
+    for(quint16 equationIndex = 0 ; equationIndex < equations.count() ; equationIndex++) {
+        NxCurve *curve = addCurve(9004 + equationIndex, QStringList() << "setEquation %1 " + equations.at(equationIndex));
+        QVERIFY(curve);
+
+        qreal positionError = 0, angleError = 0;
+        for(quint32 sample = 0 ; sample <= TEST_CURVE_SAMPLES ; sample++) {
+            qreal val = (qreal)sample / TEST_CURVE_SAMPLES;
+            NxPoint angle, pt = curve->getPointAndAngleAt(val, &angle);
+            positionError = qMax(positionError, distance(pt, references[equationIndex](val)));
+            if(!isNearCorner(curve, val))
+                angleError = qMax(angleError, angleDistance(angle, baselineAngle(references[equationIndex](val - 0.001) - references[equationIndex](val))));
+        }
+        qDebug("[TESTS] Equation %s : position error %g, angle error %g deg", qPrintable(equations.at(equationIndex)), positionError, angleError);
+        QVERIFY(positionError <= TEST_CURVE_POS);
+        QVERIFY(angleError    <= TEST_CURVE_ANGLE);
+    }
+}
@@ -0,0 +1,66 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTCURVES_H
+#define TESTCURVES_H
+
+#include <QtTest>
+#include "iannix.h"
+
+#define TEST_CURVE_SAMPLES  1000
+#define TEST_CURVE_POS      0.000001    //Position tolerance where the evaluation did not change
+#define TEST_CURVE_ARC      0.001       //Position tolerance of Bezier segments against their exact arc length (fraction of the path length)
+#define TEST_CURVE_ANGLE    0.5         //Angle tolerance (degrees)
+#define TEST_CURVE_CORNER   0.002       //Angles are not compared this close to a path point or a curve end (the old finite differences straddle them)
+#define TEST_CURVE_ARC_STEPS 10000      //Steps of the exact arc-length reference
+
+//Cursor positions and angles (NxCurve::getPointAndAngleAt) compared with a frozen copy of the evaluation
+//used before the binary search and the arc-length table (linear scan, raw Bezier parameter, finite differences)
+class TestCurves : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TestCurves(IanniX *_iannix, QObject *parent = 0);
+
+private:
+    IanniX *iannix;
+    NxCurve* addCurve(quint16 id, const QStringList &commands);
+    bool isNearCorner(NxCurve *curve, qreal val);
+
+private:
+    static NxPoint baselinePointAt(NxCurve *curve, quint16 index, qreal t);
+    static NxPoint baselinePointAt(NxCurve *curve, qreal val);
+    static NxPoint baselineAngle(const NxPoint &deltaPos);
+    static NxPoint arcLengthPointAt(NxCurve *curve, qreal val);
+    static qreal distance(const NxPoint &p1, const NxPoint &p2);
+    static qreal angleDistance(const NxPoint &angle1, const NxPoint &angle2);
+
+private slots:
+    void cleanup();
+    void straightSegments();
+    void bezierSegments();
+    void ellipse();
+    void equations();
+};
+
+#endif // TESTCURVES_H
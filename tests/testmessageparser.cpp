@@ -0,0 +1,148 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "testmessageparser.h"
+
+TestMessageParser::TestMessageParser(IanniX *_iannix, QObject *parent) :
+    QObject(parent) {
+    iannix = _iannix;
+    messagesCount = mismatchesCount = 0;
+}
+
+NxDocument* TestMessageParser::getDocument() const {
+    return (NxDocument*)iannix->getObject("all", false);
+}
+
+//Every trigger, cursor, curve and collision keyword, plus literals, numbers, underscores,
+//scripts (a failing one included) and aliases, sent through osc, tcp, udp, http, midi and direct
+void TestMessageParser::addCorpus() {
+    for(quint16 cursorIndex = 0 ; cursorIndex < TEST_MESSAGE_CURSORS ; cursorIndex++) {
+        qreal y = 4 * ((qreal)cursorIndex / TEST_MESSAGE_CURSORS - 0.5);
+        quint16 curveId = 1000 + cursorIndex, cursorId = 2000 + cursorIndex;
+        iannix->execute(QString("add curve %1").arg(curveId), ExecuteSourceSystem);
+        iannix->execute(QString("setGroup %1 lines").arg(curveId), ExecuteSourceSystem);
+        iannix->execute(QString("setLabel %1 line_%2").arg(curveId).arg(cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setPointAt %1 0 -5 %2").arg(curveId).arg(y), ExecuteSourceSystem);
+        iannix->execute(QString("setPointAt %1 1 5 %2").arg(curveId).arg(y + 0.5), ExecuteSourceSystem);
+
+        iannix->execute(QString("add cursor %1").arg(cursorId), ExecuteSourceSystem);
+        iannix->execute(QString("setGroup %1 cursors").arg(cursorId), ExecuteSourceSystem);
+        iannix->execute(QString("setLabel %1 cursor_%2").arg(cursorId).arg(cursorIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setCurve %1 %2").arg(cursorId).arg(curveId), ExecuteSourceSystem);
+        iannix->execute(QString("setWidth %1 1").arg(cursorId), ExecuteSourceSystem);
+        iannix->execute(QString("setSpeed %1 %2").arg(cursorId).arg(1 + cursorIndex / 2.), ExecuteSourceSystem);
+        iannix->execute(QString("setMessage %1 20, "
+                                "osc://ip_out:port_out/cursor cursor_id cursor_group_id cursor_label cursor_xPos cursor_yPos cursor_zPos cursor_sxPos cursor_syPos cursor_szPos cursor_value_x cursor_value_y cursor_value_z cursor_value_sx cursor_value_sy cursor_value_sz cursor_aPos cursor_ePos cursor_dPos cursor_value_a cursor_value_e cursor_value_d cursor_time cursor_time_percent cursor_angle cursor_nb_loop cursor_message_id, "
+                                "osc://ip_out:port_out/delta cursor_xPos_delta cursor_yPos_delta cursor_zPos_delta cursor_sxPos_delta cursor_syPos_delta cursor_szPos_delta cursor_value_x_delta cursor_value_y_delta cursor_value_z_delta cursor_value_sx_delta cursor_value_sy_delta cursor_value_sz_delta cursor_aPos_delta cursor_ePos_delta cursor_dPos_delta cursor_value_a_delta cursor_value_e_delta cursor_value_d_delta cursor_time_delta cursor_time_percent_delta cursor_angle_delta, "
+                                "osc://ip_out:port_out/collision collision_curve_id collision_curve_group_id collision_curve_label collision_curve_xPos collision_curve_yPos collision_curve_zPos collision_xPos collision_yPos collision_zPos collision_value_x collision_value_y collision_value_z collision_distance cursor_id, "
+                                "tcp://cursor curve_id curve_group_id curve_label curve_xPos curve_yPos curve_zPos nb_triggers nb_cursors nb_curves status global_time, "
+                                "udp://127.0.0.1:57140/cursor cursor_id {cursor_xPos*10} {cursor_label+'_script'} trigger_id").arg(cursorId), ExecuteSourceSystem);
+    }
+
+    for(quint16 triggerIndex = 0 ; triggerIndex < TEST_MESSAGE_TRIGGERS ; triggerIndex++) {
+        quint16 triggerId = 10000 + triggerIndex;
+        iannix->execute(QString("add trigger %1").arg(triggerId), ExecuteSourceSystem);
+        iannix->execute(QString("setGroup %1 triggers").arg(triggerId), ExecuteSourceSystem);
+        iannix->execute(QString("setLabel %1 trigger_%2").arg(triggerId).arg(triggerIndex), ExecuteSourceSystem);
+        iannix->execute(QString("setPos %1 %2 %3 0").arg(triggerId).arg(10 * ((qreal)triggerIndex / TEST_MESSAGE_TRIGGERS - 0.5)).arg(4 * ((triggerIndex % 5) / 5. - 0.5)), ExecuteSourceSystem);
+        iannix->execute(QString("setSize %1 0.4").arg(triggerId), ExecuteSourceSystem);
+        iannix->execute(QString("setTriggerOff %1 0.2").arg(triggerId), ExecuteSourceSystem);
+        iannix->execute(QString("setMessage %1 1, "
+                                "osc://ip_out:port_out/trigger trigger_id trigger_group_id trigger_label trigger_xPos trigger_yPos trigger_zPos trigger_value_x trigger_value_y trigger_value_z trigger_value trigger_duration trigger_distance trigger_side trigger_message_id cursor_id cursor_group_id, "
+                                "osc://ip_out:port_out/literals 12 -3.5 1e3 text with_underscore curve_id {trigger_id*2} {trigger_group_id+'_'+trigger_label} {unknownVariable+1}, "
+                                "tcp://trigger trigger_id trigger_value text 0.25, "
+                                "udp://127.0.0.1:57140/trigger trigger_id trigger_label 42, "
+                                "http://127.0.0.1:57150/trigger trigger_id trigger_value text, "
+                                "midi://midi_out/notef 1 trigger_value_y trigger_value_x trigger_duration, "
+                                "direct:// log trigger_id trigger_label").arg(triggerId), ExecuteSourceSystem);
+    }
+
+    iannix->execute("add curve 3000", ExecuteSourceSystem);
+    iannix->execute("setGroup 3000 collisions", ExecuteSourceSystem);
+    iannix->execute("setPointAt 3000 0 0 -5", ExecuteSourceSystem);
+    iannix->execute("setPointAt 3000 1 0 5", ExecuteSourceSystem);
+    iannix->execute("setMessage 3000 1, "
+                    "osc://ip_out:port_out/curve curve_id curve_group_id curve_label curve_xPos curve_yPos curve_zPos, "
+                    "tcp://curve curve_id text 0.25, "
+                    "http://127.0.0.1:57150/curve curve_id curve_label", ExecuteSourceSystem);
+}
+
+//Both parsers start from the same message, as MessageManager::outgoingMessage() gets it from its cache
+void TestMessageParser::compare(const MessageManagerDestination &destination) {
+    const QVector< QVector<QByteArray> > &messagePatterns = ((NxObject*)destination.object)->getMessagePatterns();
+    const QVector< QVector<MessageArgument> > &messageArguments = ((NxObject*)destination.object)->getMessageArguments();
+    for(quint16 messagePatternIndex = 0 ; messagePatternIndex < messagePatterns.count() ; messagePatternIndex++) {
+        const QVector<QByteArray> &messagePattern = messagePatterns.at(messagePatternIndex);
+        Message message;
+        message.setUrl(messagePattern.at(0), MessageManager::scriptEngine, MessageManager::aliases);
+        Message messageReference = message;
+        bool send          = message.parse(messageArguments.at(messagePatternIndex), destination);
+        bool sendReference = messageReference.parseLegacy(messagePattern, destination);
+
+        QStringList differences = message.parseDifferences(messageReference);
+        if(send != sendReference)
+            differences << "send";
+        messagesCount++;
+        if(differences.count()) {
+            mismatchesCount++;
+            if(mismatchesCount <= TEST_MESSAGE_LOG) {
+                qDebug("[TESTS] Message %d of object #%d differs (%s)", messagePatternIndex, ((NxObject*)destination.object)->getId(), qPrintable(differences.join(", ")));
+                qDebug("[TESTS]   compiled  %s", message.getVerboseMessage(true).constData());
+                qDebug("[TESTS]   reference %s", messageReference.getVerboseMessage(true).constData());
+            }
+        }
+    }
+}
+
+
+void TestMessageParser::cleanup() {
+    getDocument()->clear();
+}
+
+//Triggers hit by each cursor, cursors alone and colliding with a curve, curves alone
+void TestMessageParser::corpus() {
+    NxDocument *document = getDocument();
+    addCorpus();
+    NxCurve *collisionCurve = (NxCurve*)iannix->getObjectById(3000);
+    QVERIFY(collisionCurve);
+
+    messagesCount = mismatchesCount = 0;
+    foreach(NxObject *object, document->objects) {
+        if(object->getType() != ObjectsTypeCursor)
+            continue;
+        NxCursor *cursor = (NxCursor*)object;
+        NxPoint collisionPoint = collisionCurve->getPathPointsAt(0);
+        compare(MessageManagerDestination(cursor, 0, cursor));
+        compare(MessageManagerDestination(cursor, 0, cursor, collisionCurve, collisionPoint, cursor->getCursorValue(collisionPoint)));
+        foreach(NxObject *trigger, document->objects)
+            if(trigger->getType() == ObjectsTypeTrigger)
+                compare(MessageManagerDestination(trigger, trigger, cursor));
+    }
+    foreach(NxObject *object, document->objects)
+        if(object->getType() == ObjectsTypeCurve)
+            compare(MessageManagerDestination(object));
+
+    qDebug("[TESTS] %u messages compared, %u mismatches", messagesCount, mismatchesCount);
+    QVERIFY(messagesCount > 0);
+    QCOMPARE(mismatchesCount, (quint32)0);
+}
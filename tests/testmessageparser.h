@@ -0,0 +1,55 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTMESSAGEPARSER_H
+#define TESTMESSAGEPARSER_H
+
+#include <QtTest>
+#include "iannix.h"
+#include "messages/messagemanager.h"
+
+#define TEST_MESSAGE_TRIGGERS   40      //Objects of the corpus
+#define TEST_MESSAGE_CURSORS    4
+#define TEST_MESSAGE_LOG        20      //Mismatches detailed in the console
+
+//Messages parsed by the compiled parser (Message::parse) and by the string-matching
+//reference (Message::parseLegacy in tests/messagelegacy.cpp), compared byte for byte
+class TestMessageParser : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TestMessageParser(IanniX *_iannix, QObject *parent = 0);
+
+private:
+    IanniX *iannix;
+    quint32 messagesCount, mismatchesCount;
+    NxDocument* getDocument() const;
+    void addCorpus();
+    void compare(const MessageManagerDestination &destination);
+
+private slots:
+    void cleanup();
+    void corpus();
+};
+
+#endif // TESTMESSAGEPARSER_H
@@ -0,0 +1,139 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "testscorebinary.h"
+
+TestScoreBinary::TestScoreBinary(IanniX *_iannix, QObject *parent) :
+    QObject(parent) {
+    iannix = _iannix;
+}
+
+NxDocument* TestScoreBinary::getDocument() const {
+    return (NxDocument*)iannix->getObject("all", false);
+}
+
+//Triggers, curves and their cursors made through the GUI (ids from 1, triggers first)
+void TestScoreBinary::addScore(quint16 triggers, quint16 curves, quint16 points) {
+    quint16 id = 1;
+    for(quint16 triggerIndex = 0 ; triggerIndex < triggers ; triggerIndex++, id++) {
+        iannix->execute(QString("add trigger %1").arg(id), ExecuteSourceGui);
+        iannix->execute(QString("setGroup %1 triggers").arg(id), ExecuteSourceGui);
+        iannix->execute(QString("setPos %1 %2 %3 0").arg(id).arg(triggerIndex % 100).arg(triggerIndex / 100), ExecuteSourceGui);
+    }
+    for(quint16 curveIndex = 0 ; curveIndex < curves ; curveIndex++, id += 2) {
+        iannix->execute(QString("add curve %1").arg(id), ExecuteSourceGui);
+        iannix->execute(QString("setGroup %1 curves").arg(id), ExecuteSourceGui);
+        iannix->execute(QString("setPos %1 0 %2 0").arg(id).arg(-curveIndex), ExecuteSourceGui);
+        for(quint16 pointIndex = 0 ; pointIndex < points ; pointIndex++)
+            iannix->execute(QString("setPointAt %1 %2 %3 %4 0").arg(id).arg(pointIndex).arg(pointIndex).arg(pointIndex % 2), ExecuteSourceGui);
+        iannix->execute(QString("add cursor %1").arg(id + 1), ExecuteSourceGui);
+        iannix->execute(QString("setGroup %1 curves").arg(id + 1), ExecuteSourceGui);
+        iannix->execute(QString("setCurve %1 %2").arg(id + 1).arg(id), ExecuteSourceGui);
+    }
+}
+bool TestScoreBinary::isInGroup(NxDocument *document, NxObject *object) const {
+    NxGroup *group = document->groups.value(object->getGroupId());
+    return (group) && (group->objects[object->getActive()][object->getType()].value(object->getId()) == object);
+}
+
+
+void TestScoreBinary::initTestCase() {
+    filename = QDir::temp().absoluteFilePath("IanniX tests.nxbin");
+}
+void TestScoreBinary::cleanupTestCase() {
+    QFile::remove(filename);
+}
+void TestScoreBinary::cleanup() {
+    getDocument()->clear();
+}
+
+//Every object comes back with the same id, the same serialization, in its group table and with its curve
+void TestScoreBinary::roundTrip() {
+    NxDocument *document = getDocument();
+    addScore(3, 1, 4);
+    NxObjectDispatchProperty::source = ExecuteSourceGui;
+    QHash<quint16, QString> serializations;
+    foreach(const NxObject *object, document->objects)
+        serializations.insert(object->getId(), object->serialize());
+
+    QVERIFY(NxScoreBinary::save(document, filename));
+    document->clear();
+    QCOMPARE(document->objects.count(), 0);
+    QCOMPARE(NxScoreBinary::load(document, iannix->getObjectRootItem(), filename), serializations.count());
+
+    NxObjectDispatchProperty::source = ExecuteSourceGui;
+    foreach(NxObject *object, document->objects) {
+        QVERIFY(serializations.contains(object->getId()));
+        QCOMPARE(object->serialize(), serializations.value(object->getId()));
+        QVERIFY(isInGroup(document, object));
+        if(object->getType() == ObjectsTypeCursor) {
+            QVERIFY(((NxCursor*)object)->getCurve() == document->getObject(object->getId() - 1));
+            QVERIFY(object->getPropertiesToSerialize(ExecuteSourceGui).contains(COMMAND_CURSOR_CURVE));
+        }
+    }
+}
+
+//Objects whose id is already used get a free id, cursors stay on the curve loaded with them
+void TestScoreBinary::idCollision() {
+    NxDocument *document = getDocument();
+    addScore(3, 1, 4);
+    QList<quint16> ids = document->objects.keys();
+    QVERIFY(NxScoreBinary::save(document, filename));
+    QCOMPARE(NxScoreBinary::load(document, iannix->getObjectRootItem(), filename), ids.count());
+    QCOMPARE(document->objects.count(), 2 * ids.count());
+
+    foreach(NxObject *object, document->objects) {
+        QVERIFY(isInGroup(document, object));
+        if(object->getType() == ObjectsTypeCursor) {
+            NxCurve *curve = ((NxCursor*)object)->getCurve();
+            QVERIFY(curve);
+            QCOMPARE(ids.contains(curve->getId()), ids.contains(object->getId()));
+            QCOMPARE(curve->getCursors().count(), 1);
+        }
+    }
+}
+
+//Load time of the same objects from the script (run() calls, as in madeThroughGUI()) and from the binary file
+void TestScoreBinary::loadTime() {
+    NxDocument *document = getDocument();
+    addScore(TEST_BINARY_TRIGGERS, TEST_BINARY_CURVES, TEST_BINARY_POINTS);
+    qint32 objectsCount = document->objects.count();
+    NxObjectDispatchProperty::source = ExecuteSourceGui;
+    QString script = iannix->serialize();
+    QVERIFY(NxScoreBinary::save(document, filename));
+    document->clear();
+
+    QElapsedTimer loadTimer;
+    loadTimer.start();
+    document->source = ExecuteSourceGui;
+    document->scriptEvaluate(script, false);
+    qint64 scriptTime = loadTimer.elapsed();
+    QCOMPARE(document->objects.count(), objectsCount);
+    document->clear();
+
+    loadTimer.restart();
+    QCOMPARE(NxScoreBinary::load(document, iannix->getObjectRootItem(), filename), objectsCount);
+    qint64 binaryTime = loadTimer.elapsed();
+
+    qDebug("[TESTS] %d objects (%d curves of %d points) loaded in %d ms from the script, %d ms from the binary file", objectsCount, TEST_BINARY_CURVES, TEST_BINARY_POINTS, (int)scriptTime, (int)binaryTime);
+}
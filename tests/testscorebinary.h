@@ -0,0 +1,58 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TESTSCOREBINARY_H
+#define TESTSCOREBINARY_H
+
+#include <QtTest>
+#include "iannix.h"
+#include "objects/nxscorebinary.h"
+
+#define TEST_BINARY_TRIGGERS    10000   //Objects of the load-time measurement
+#define TEST_BINARY_CURVES      500
+#define TEST_BINARY_POINTS      20
+
+//Binary objects file (.nxbin) saved and loaded back, compared with the objects made through the GUI
+class TestScoreBinary : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TestScoreBinary(IanniX *_iannix, QObject *parent = 0);
+
+private:
+    IanniX *iannix;
+    QString filename;
+    NxDocument* getDocument() const;
+    void addScore(quint16 triggers, quint16 curves, quint16 points);
+    bool isInGroup(NxDocument *document, NxObject *object) const;
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void cleanup();
+    void roundTrip();
+    void idCollision();
+    void loadTime();
+};
+
+#endif // TESTSCOREBINARY_H
@@ -0,0 +1,110 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "schedulerthread.h"
+#include "messages/messagemanager.h"
+
+QMutex SchedulerThread::lock;
+bool   SchedulerThread::guiHasLock   = false;
+bool   SchedulerThread::guiNeedsLock = false;
+
+SchedulerThread::SchedulerThread(QObject *parent) :
+    QThread(parent) {
+    running  = false;
+    interval = 5;
+}
+
+void SchedulerThread::startScheduler() {
+    if(isRunning())
+        return;
+
+    //GUI thread is busy right now, it owns the document until its next wait
+    guiNeedsLock = true;
+    guiAcquire();
+    connect(QAbstractEventDispatcher::instance(), SIGNAL(awake()),        SLOT(guiAwake()),        Qt::DirectConnection);
+    connect(QAbstractEventDispatcher::instance(), SIGNAL(aboutToBlock()), SLOT(guiAboutToBlock()), Qt::DirectConnection);
+
+    running = true;
+    QThread::start(QThread::TimeCriticalPriority);
+}
+void SchedulerThread::stopScheduler() {
+    if(!isRunning())
+        return;
+
+    //Let the last tick finish before the GUI takes the document back for good
+    running = false;
+    guiRelease();
+    guiNeedsLock = false;
+    wait();
+    disconnect(QAbstractEventDispatcher::instance(), 0, this, 0);
+}
+
+void SchedulerThread::guiAwake() {
+    guiAcquire();
+}
+void SchedulerThread::guiAboutToBlock() {
+    guiRelease();
+}
+void SchedulerThread::guiRelease() {
+    if(guiHasLock) {
+        lock.unlock();
+        guiHasLock = false;
+    }
+}
+void SchedulerThread::guiAcquire() {
+    if((guiNeedsLock) && (!guiHasLock)) {
+        lock.lock();
+        guiHasLock = true;
+    }
+}
+
+void SchedulerThread::run() {
+    QElapsedTimer clock;
+    clock.start();
+    qint64 deadline = 0, tickOld = 0;
+    while(running) {
+        qint64 now = clock.nsecsElapsed();
+        if(now < deadline) {
+            usleep(qMax((deadline - now) / 1000, (qint64)50));
+            continue;
+        }
+
+        //Tick with the real elapsed time
+        lock.lock();
+        if(running)
+            Application::current->schedulerTick((now - tickOld) / 1000000000., interval);
+        lock.unlock();
+        tickOld = now;
+
+        //Next deadline, skipped ticks are not caught up
+        deadline += interval * 1000000;
+        if(deadline < now)
+            deadline = now + interval * 1000000;
+    }
+    MessageManager::schedulerStopped();
+}
+
+SchedulerThread::~SchedulerThread() {
+    stopScheduler();
+}
@@ -0,0 +1,66 @@
+/*
+    This file is part of IanniX, a graphical real-time open-source sequencer for digital art
+    Copyright (C) 2010-2015 — IanniX Association
+
+    Project Manager: Thierry Coduys (http://www.le-hub.org)
+    Development:     Guillaume Jacquemin (https://www.buzzinglight.com)
+
+    This file was written by Guillaume Jacquemin.
+
+    IanniX is a free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef SCHEDULERTHREAD_H
+#define SCHEDULERTHREAD_H
+
+#include <QThread>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QAbstractEventDispatcher>
+#include "misc/application.h"
+
+//Scheduler ticks on a dedicated thread with its own monotonic clock.
+//The GUI thread owns the document lock while it handles events and
+//releases it while waiting for new ones, so ticks only wait for the
+//event being processed, never for idle time or modal dialogs.
+class SchedulerThread : public QThread {
+    Q_OBJECT
+
+public:
+    explicit SchedulerThread(QObject *parent = 0);
+    ~SchedulerThread();
+
+private:
+    volatile bool running;
+    qreal interval;
+    static bool guiHasLock, guiNeedsLock;
+public:
+    static QMutex lock;
+    void setInterval(qreal _interval) { interval = qMax(_interval, (qreal)0.1); }
+    //Painting only reads snapshots, so the GUI lends the document back while it draws
+    static void guiRelease();
+    static void guiAcquire();
+public slots:
+    void startScheduler();
+    void stopScheduler();
+protected:
+    void run();
+
+private slots:
+    void guiAwake();
+    void guiAboutToBlock();
+};
+
+#endif // SCHEDULERTHREAD_H
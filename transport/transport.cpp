@@ -24,6 +24,7 @@
 #include "transport.h"
 #include "ui_transport.h"
 #include "misc/uitheme.h"
+#include "messages/messagemanager.h"
 
 qint64    Transport::currentMSecsSinceEpoch = 0;
 QString   Transport::timeLocalStr         = "000:00.000";
@@ -31,8 +32,17 @@ qreal     Transport::timeLocal            = 0;
 qreal     Transport::scoreSpeed           = 1;
 qreal     Transport::perfSchedulerRefreshTime    = 0;
 qreal     Transport::perfSchedulerCounterTime    = 0;
+qreal     Transport::perfSchedulerTickTime       = 0;
+qreal     Transport::perfSchedulerCollisionCounter = 0;
+qreal     Transport::perfScriptEvaluationCounter = 0;
+qreal     Transport::perfOscReceiveCounter       = 0;
+QVector<qreal> Transport::perfSchedulerJitter;
 qreal     Transport::perfOpenGLRefreshTime       = 0;
 qreal     Transport::perfOpenGLCounterTime       = 0;
+qreal     Transport::perfOpenGLFrameTime         = 0;
+qreal     Transport::perfOpenGLBatchedCounter    = 0;
+qreal     Transport::perfOpenGLDrawnCounter      = 0;
+qreal     Transport::perfOpenGLCulledCounter     = 0;
 qreal     Transport::renderMeasureAbsoluteValOld = 0;
 QTime     Transport::renderMeasureAbsolute;
 bool      Transport::forceTimeLocal = false;
@@ -122,13 +132,37 @@ void Transport::refreshPerformances() {
         }
         if((!ui->perfSchedulerEdit->hasFocus()) && (timerOk))
             ui->perfSchedulerEdit->setText(QString::number(qRound(1000.0F * perfSchedulerRefreshTime / perfSchedulerCounterTime)));
+        if((timerOk) && (perfSchedulerCounterTime > 0) && (perfSchedulerRefreshTime > 0)) {
+            //Tick jitter percentiles over the last period
+            qreal jitterP50 = 0, jitterP99 = 0;
+            if(perfSchedulerJitter.count()) {
+                qSort(perfSchedulerJitter);
+                jitterP50 = perfSchedulerJitter.at(perfSchedulerJitter.count() / 2);
+                jitterP99 = perfSchedulerJitter.at(qMin(perfSchedulerJitter.count() - 1, qFloor(perfSchedulerJitter.count() * 0.99)));
+            }
+            ui->perfSchedulerEdit->setToolTip(tr("Scheduler period\nTick cost: %1 ms (%2 collision tests)\nTick jitter: %5 ms (p50), %6 ms (p99)\nScript arguments: %3 evaluations/s\nOSC input: %4 messages/s").arg(perfSchedulerTickTime / perfSchedulerCounterTime, 0, 'f', 3).arg(qRound(perfSchedulerCollisionCounter / perfSchedulerCounterTime)).arg(qRound(perfScriptEvaluationCounter / perfSchedulerRefreshTime)).arg(qRound(perfOscReceiveCounter / perfSchedulerRefreshTime)).arg(jitterP50, 0, 'f', 3).arg(jitterP99, 0, 'f', 3));
+        }
         if(!ui->perfOpenGLEdit->hasFocus())
             ui->perfOpenGLEdit->setText(QString::number(qRound(1.0F * perfOpenGLCounterTime / perfOpenGLRefreshTime)));
+        if(perfOpenGLCounterTime > 0)
+            ui->perfOpenGLEdit->setToolTip(tr("Frame rate\nFrame time: %1 ms\nBatched triggers: %2\nDrawn objects: %3\nCulled objects: %4").arg(perfOpenGLFrameTime / perfOpenGLCounterTime, 0, 'f', 3).arg(qRound(perfOpenGLBatchedCounter / perfOpenGLCounterTime)).arg(qRound(perfOpenGLDrawnCounter / perfOpenGLCounterTime)).arg(qRound(perfOpenGLCulledCounter / perfOpenGLCounterTime)));
     }
+    //Script arguments evaluated since the last refresh, also in the log and monitor
+    if((perfScriptEvaluationCounter > 0) && (perfSchedulerRefreshTime > 0))
+        MessageManager::logInfo(tr("Script arguments: %1 evaluations/s").arg(qRound(perfScriptEvaluationCounter / perfSchedulerRefreshTime)));
     perfSchedulerRefreshTime = 0;
     perfSchedulerCounterTime = 0;
+    perfSchedulerTickTime = 0;
+    perfSchedulerCollisionCounter = 0;
+    perfScriptEvaluationCounter = 0;
+    perfOscReceiveCounter = 0;
+    perfSchedulerJitter.clear();
     perfOpenGLRefreshTime = 0;
     perfOpenGLCounterTime = 0;
+    perfOpenGLFrameTime = 0;
+    perfOpenGLBatchedCounter = 0;
+    perfOpenGLDrawnCounter = 0;
+    perfOpenGLCulledCounter = 0;
 }
 const QString & Transport::getTimeLocalStr() {
     timeLocalStr = "";
@@ -26,6 +26,7 @@
 
 #include <QWidget>
 #include <QTime>
+#include <QVector>
 #include <QProcess>
 #include <QThread>
 #include <QCoreApplication>
@@ -81,7 +82,12 @@ public:
     static qint64 currentMSecsSinceEpoch;
     static qreal timeLocal, scoreSpeed;
     static qreal perfSchedulerRefreshTime, perfSchedulerCounterTime;
+    static qreal perfSchedulerTickTime,    perfSchedulerCollisionCounter;
+    static qreal perfScriptEvaluationCounter, perfOscReceiveCounter;
+    static QVector<qreal> perfSchedulerJitter;
     static qreal perfOpenGLRefreshTime,    perfOpenGLCounterTime;
+    static qreal perfOpenGLFrameTime,      perfOpenGLBatchedCounter;
+    static qreal perfOpenGLDrawnCounter,   perfOpenGLCulledCounter;
     static QString timeLocalStr;
     static qreal renderMeasureAbsoluteValOld;
     static QTime renderMeasureAbsolute;